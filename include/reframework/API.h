@@ -7,8 +7,8 @@
 #endif
 
 #define REFRAMEWORK_PLUGIN_VERSION_MAJOR 1
-#define REFRAMEWORK_PLUGIN_VERSION_MINOR 4
-#define REFRAMEWORK_PLUGIN_VERSION_PATCH 1
+#define REFRAMEWORK_PLUGIN_VERSION_MINOR 11
+#define REFRAMEWORK_PLUGIN_VERSION_PATCH 0
 
 #define REFRAMEWORK_RENDERER_D3D11 0
 #define REFRAMEWORK_RENDERER_D3D12 1
@@ -95,6 +95,9 @@ DECLARE_REFRAMEWORK_HANDLE(REFrameworkTypeInfoHandle); /* NOT a type definition
 DECLARE_REFRAMEWORK_HANDLE(REFrameworkReflectionPropertyHandle); /* NOT a TDB property */
 DECLARE_REFRAMEWORK_HANDLE(REFrameworkReflectionMethodHandle); /* NOT a TDB method */
 
+/* generation in the high 32 bits, table index in the low 32 bits. 0 is never valid */
+typedef unsigned long long REFrameworkGenerationalHandle;
+
 #define REFRAMEWORK_CREATE_INSTANCE_FLAGS_NONE 0
 #define REFRAMEWORK_CREATE_INSTANCE_FLAGS_SIMPLIFY 1
 
@@ -275,6 +278,21 @@ typedef struct {
     void* (*get_reflection_properties)(REFrameworkManagedObjectHandle);
     REFrameworkReflectionPropertyHandle (*get_reflection_property_descriptor)(REFrameworkManagedObjectHandle, const char* name);
     REFrameworkReflectionMethodHandle (*get_reflection_method_descriptor)(REFrameworkManagedObjectHandle, const char* name);
+
+    /* System.Array only, returns 0 for any other handle. Copies up to out_size elements into out and returns the total element count. */
+    /* Arrays of references are read straight from memory, value type elements are boxed. */
+    unsigned int (*get_array_elements)(REFrameworkManagedObjectHandle, REFrameworkManagedObjectHandle* out, unsigned int out_size);
+    /* System.Array only, returns NULL for any other handle. Pointer to the element storage, element i lives at data + i * stride. */
+    void* (*get_array_data)(REFrameworkManagedObjectHandle, unsigned int* out_count, unsigned int* out_stride);
+
+    /* Generational handles, an alternative to holding raw pointers. The handle keeps a reference to the object until release_handle. */
+    /* Once released, every copy of the handle resolves to null, even if the object's memory gets reused. */
+    /* Resolving never touches the object, so there's no need to call is_managed_object first. */
+    REFrameworkGenerationalHandle (*acquire_handle)(REFrameworkManagedObjectHandle); /* 0 on failure */
+    bool (*release_handle)(REFrameworkGenerationalHandle);
+    REFrameworkManagedObjectHandle (*resolve_handle)(REFrameworkGenerationalHandle); /* null if stale */
+    /* Resolves count handles into out, stale ones become null. Returns how many were valid. */
+    unsigned int (*resolve_handles)(const REFrameworkGenerationalHandle* handles, REFrameworkManagedObjectHandle* out, unsigned int count);
 } REFrameworkManagedObject;
 
 typedef struct {
@@ -360,6 +378,41 @@ typedef struct {
 
     void* (*allocate)(unsigned long long size);
     void (*deallocate)(void*);
+
+    /* Looks up joints of a via.Transform through a per-transform name/hash -> joint cache. */
+    /* Joints that don't exist are written as null. Returns how many were found. */
+    unsigned int (*resolve_joints)(REFrameworkManagedObjectHandle transform, const char** names, unsigned int count, REFrameworkManagedObjectHandle* out);
+    unsigned int (*resolve_joints_by_hash)(REFrameworkManagedObjectHandle transform, const unsigned int* hashes, unsigned int count, REFrameworkManagedObjectHandle* out);
+
+    /* Structure of arrays skeleton pose access for a via.Transform, element i is joint index i. */
+    /* Positions and rotations are 4 floats each (x, y, z, w). Null buffers are skipped, count is the element count of every non-null buffer. */
+    unsigned int (*get_joint_count)(REFrameworkManagedObjectHandle transform);
+    /* Returns the joint count, which may be larger than count. */
+    unsigned int (*read_joint_pose)(REFrameworkManagedObjectHandle transform, float* local_positions, float* local_rotations, float* world_positions, float* world_rotations, unsigned int count);
+    /* World values take precedence over local ones. mask (count bytes, non-zero = write) may be null to write every joint. */
+    /* Returns how many joints were written. */
+    unsigned int (*write_joint_pose)(REFrameworkManagedObjectHandle transform, const float* local_positions, const float* local_rotations, const float* world_positions, const float* world_rotations, const unsigned char* mask, unsigned int count);
+
+    /* Projects world positions (4 floats each, w is ignored) to screen positions (2 floats each) with the camera captured at BeginRendering. */
+    /* out_visible (count bytes) is 0 for points behind the camera, or outside of the view if cull_offscreen is set. */
+    /* Screen positions of points that aren't visible are left untouched. Returns how many points are visible. */
+    unsigned int (*world_to_screen)(const float* world_positions, unsigned int count, bool cull_offscreen, float* out_screen_positions, unsigned char* out_visible);
+
+    /* Spatial queries over the game objects of the current scene, positions are 3 floats. */
+    /* get_scene_tag returns the tag for objects with a component of the given type, or 0 if there is none. */
+    /* tag_mask matches objects sharing any bit with it, 0 matches everything. */
+    /* Up to max_out game objects are written to out, the total number found is returned. */
+    unsigned long long (*get_scene_tag)(const char* type_name);
+    unsigned int (*find_objects_near)(const float* position, float radius, unsigned long long tag_mask, REFrameworkManagedObjectHandle* out, unsigned int max_out);
+    unsigned int (*find_objects_in_frustum)(const float* view_proj, unsigned long long tag_mask, REFrameworkManagedObjectHandle* out, unsigned int max_out);
+    /* Closest first. */
+    unsigned int (*find_nearest_objects)(const float* position, unsigned int k, float max_radius, unsigned long long tag_mask, REFrameworkManagedObjectHandle* out);
+
+    /* Cached component lookups. find_component returns the first component of the game object that is of the given type, or null (also null if game_object isn't a via.GameObject). */
+    REFrameworkManagedObjectHandle (*find_component)(REFrameworkManagedObjectHandle game_object, REFrameworkTypeDefinitionHandle type);
+    /* Every component of the given type in the current scene, one per game object. */
+    /* Up to max_out components are written to out, the total number found is returned. */
+    unsigned int (*find_components)(REFrameworkTypeDefinitionHandle type, REFrameworkManagedObjectHandle* out, unsigned int max_out);
 } REFrameworkSDKFunctions;
 
 /* these are NOT pointers to the actual objects */
@@ -4,6 +4,7 @@ extern "C" {
     #include "API.h"
 }
 
+#include <algorithm>
 #include <mutex>
 #include <array>
 #include <vector>
@@ -144,6 +145,93 @@ public:
         return sdk()->functions->get_native_singleton(name.data());
     }
 
+    // Joints of a via.Transform, missing ones come back as nullptr.
+    std::vector<API::ManagedObject*> resolve_joints(API::ManagedObject* transform, const std::vector<const char*>& names) const {
+        std::vector<API::ManagedObject*> out(names.size());
+        sdk()->functions->resolve_joints(*transform, (const char**)names.data(), (unsigned int)names.size(), (REFrameworkManagedObjectHandle*)out.data());
+        return out;
+    }
+
+    std::vector<API::ManagedObject*> resolve_joints(API::ManagedObject* transform, const std::vector<uint32_t>& hashes) const {
+        std::vector<API::ManagedObject*> out(hashes.size());
+        sdk()->functions->resolve_joints_by_hash(*transform, (const unsigned int*)hashes.data(), (unsigned int)hashes.size(), (REFrameworkManagedObjectHandle*)out.data());
+        return out;
+    }
+
+    uint32_t get_joint_count(API::ManagedObject* transform) const {
+        return sdk()->functions->get_joint_count(*transform);
+    }
+
+    // Each buffer may be nullptr, otherwise it must hold count * 4 floats.
+    uint32_t read_joint_pose(API::ManagedObject* transform, float* local_positions, float* local_rotations, float* world_positions, float* world_rotations, uint32_t count) const {
+        return sdk()->functions->read_joint_pose(*transform, local_positions, local_rotations, world_positions, world_rotations, count);
+    }
+
+    uint32_t write_joint_pose(API::ManagedObject* transform, const float* local_positions, const float* local_rotations, const float* world_positions, const float* world_rotations, 
+                              const uint8_t* mask, uint32_t count) const {
+        return sdk()->functions->write_joint_pose(*transform, local_positions, local_rotations, world_positions, world_rotations, mask, count);
+    }
+
+    // world_positions holds count * 4 floats, out_screen_positions count * 2 floats and out_visible count bytes.
+    uint32_t world_to_screen(const float* world_positions, uint32_t count, bool cull_offscreen, float* out_screen_positions, uint8_t* out_visible) const {
+        return sdk()->functions->world_to_screen(world_positions, count, cull_offscreen, out_screen_positions, out_visible);
+    }
+
+    uint64_t get_scene_tag(std::string_view type_name) const {
+        return sdk()->functions->get_scene_tag(type_name.data());
+    }
+
+    std::vector<API::ManagedObject*> find_objects_near(const float* position, float radius, uint64_t tag_mask = 0) const {
+        std::vector<API::ManagedObject*> out(256);
+        auto count = sdk()->functions->find_objects_near(position, radius, tag_mask, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size());
+
+        if (count > out.size()) {
+            out.resize(count);
+            count = sdk()->functions->find_objects_near(position, radius, tag_mask, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size());
+        }
+
+        out.resize(std::min<size_t>(count, out.size()));
+        return out;
+    }
+
+    std::vector<API::ManagedObject*> find_objects_in_frustum(const float* view_proj, uint64_t tag_mask = 0) const {
+        std::vector<API::ManagedObject*> out(256);
+        auto count = sdk()->functions->find_objects_in_frustum(view_proj, tag_mask, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size());
+
+        if (count > out.size()) {
+            out.resize(count);
+            count = sdk()->functions->find_objects_in_frustum(view_proj, tag_mask, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size());
+        }
+
+        out.resize(std::min<size_t>(count, out.size()));
+        return out;
+    }
+
+    std::vector<API::ManagedObject*> find_nearest_objects(const float* position, uint32_t k, float max_radius, uint64_t tag_mask = 0) const {
+        std::vector<API::ManagedObject*> out(k);
+        const auto count = sdk()->functions->find_nearest_objects(position, k, max_radius, tag_mask, (REFrameworkManagedObjectHandle*)out.data());
+
+        out.resize(count);
+        return out;
+    }
+
+    API::ManagedObject* find_component(API::ManagedObject* game_object, API::TypeDefinition* type) const {
+        return (API::ManagedObject*)sdk()->functions->find_component(*game_object, *type);
+    }
+
+    std::vector<API::ManagedObject*> find_components(API::TypeDefinition* type) const {
+        std::vector<API::ManagedObject*> out(256);
+        auto count = sdk()->functions->find_components(*type, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size());
+
+        if (count > out.size()) {
+            out.resize(count);
+            count = sdk()->functions->find_components(*type, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size());
+        }
+
+        out.resize(std::min<size_t>(count, out.size()));
+        return out;
+    }
+
     std::vector<REFrameworkManagedSingleton> get_managed_singletons() const {
         std::vector<REFrameworkManagedSingleton> out{};
         out.resize(512);
@@ -646,6 +734,45 @@ public:
             return (API::ReflectionMethod*)API::s_instance->sdk()->managed_object->get_reflection_method_descriptor(*this, name.data());
         }
 
+        // System.Array only.
+        std::vector<API::ManagedObject*> get_array_elements() const {
+            const auto fn = API::s_instance->sdk()->managed_object->get_array_elements;
+            std::vector<API::ManagedObject*> out{};
+
+            out.resize(fn(*this, nullptr, 0));
+
+            if (!out.empty()) {
+                out.resize(fn(*this, (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)out.size()));
+            }
+
+            return out;
+        }
+
+        // System.Array only.
+        void* get_array_data(uint32_t* out_count = nullptr, uint32_t* out_stride = nullptr) const {
+            return API::s_instance->sdk()->managed_object->get_array_data(*this, out_count, out_stride);
+        }
+
+        // Generational handle holding a reference to this object, see API.h.
+        REFrameworkGenerationalHandle acquire_handle() {
+            return API::s_instance->sdk()->managed_object->acquire_handle(*this);
+        }
+
+        static bool release_handle(REFrameworkGenerationalHandle handle) {
+            return API::s_instance->sdk()->managed_object->release_handle(handle);
+        }
+
+        static API::ManagedObject* resolve_handle(REFrameworkGenerationalHandle handle) {
+            return (API::ManagedObject*)API::s_instance->sdk()->managed_object->resolve_handle(handle);
+        }
+
+        // Stale handles resolve to nullptr.
+        static std::vector<API::ManagedObject*> resolve_handles(const std::vector<REFrameworkGenerationalHandle>& handles) {
+            std::vector<API::ManagedObject*> out(handles.size());
+            API::s_instance->sdk()->managed_object->resolve_handles(handles.data(), (REFrameworkManagedObjectHandle*)out.data(), (unsigned int)handles.size());
+            return out;
+        }
+
         template<typename Ret = void*, typename ...Args>
         Ret call(std::string_view method_name, Args... args) const {
             auto t = get_type_definition();
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <immintrin.h>
+
+#include "IK.hpp"
+
+namespace utility::math::ik {
+namespace detail {
+constexpr float EPSILON = 1e-6f;
+
+// Four 3D vectors, one per lane.
+struct Vec3x4 {
+    __m128 x, y, z;
+};
+
+Vec3x4 load(const Vector4f (&v)[4]) {
+    auto x = _mm_loadu_ps(&v[0].x);
+    auto y = _mm_loadu_ps(&v[1].x);
+    auto z = _mm_loadu_ps(&v[2].x);
+    auto w = _mm_loadu_ps(&v[3].x);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    return {x, y, z};
+}
+
+void store(const Vec3x4& v, Vector4f (&out)[4]) {
+    auto x = v.x;
+    auto y = v.y;
+    auto z = v.z;
+    auto w = _mm_set1_ps(1.0f);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    _mm_storeu_ps(&out[0].x, x);
+    _mm_storeu_ps(&out[1].x, y);
+    _mm_storeu_ps(&out[2].x, z);
+    _mm_storeu_ps(&out[3].x, w);
+}
+
+// Copies elements [first, first + 4) of in, repeating the last valid one past count
+// so the tail goes through the exact same code as a full group.
+void gather(std::span<const Vector4f> in, size_t first, size_t count, size_t stride, size_t offset, Vector4f (&out)[4]) {
+    for (size_t k = 0; k < 4; ++k) {
+        const auto i = std::min(first + k, count - 1);
+        out[k] = in[i * stride + offset];
+    }
+}
+
+Vec3x4 splat(float x, float y, float z) {
+    return {_mm_set1_ps(x), _mm_set1_ps(y), _mm_set1_ps(z)};
+}
+
+Vec3x4 add(const Vec3x4& a, const Vec3x4& b) {
+    return {_mm_add_ps(a.x, b.x), _mm_add_ps(a.y, b.y), _mm_add_ps(a.z, b.z)};
+}
+
+Vec3x4 sub(const Vec3x4& a, const Vec3x4& b) {
+    return {_mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z)};
+}
+
+Vec3x4 mul(const Vec3x4& a, __m128 s) {
+    return {_mm_mul_ps(a.x, s), _mm_mul_ps(a.y, s), _mm_mul_ps(a.z, s)};
+}
+
+__m128 dot(const Vec3x4& a, const Vec3x4& b) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+__m128 length(const Vec3x4& a) {
+    return _mm_sqrt_ps(dot(a, a));
+}
+
+Vec3x4 cross(const Vec3x4& a, const Vec3x4& b) {
+    return {
+        _mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+        _mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+        _mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x))
+    };
+}
+
+__m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+Vec3x4 select(__m128 mask, const Vec3x4& a, const Vec3x4& b) {
+    return {select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z)};
+}
+
+// v / len, or fallback where len is too small to divide by.
+Vec3x4 direction(const Vec3x4& v, __m128 len, const Vec3x4& fallback) {
+    const auto eps = _mm_set1_ps(EPSILON);
+    const auto inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(len, eps));
+
+    return select(_mm_cmpgt_ps(len, eps), mul(v, inv), fallback);
+}
+
+// v with its component along the unit vector n removed.
+Vec3x4 reject(const Vec3x4& v, const Vec3x4& n) {
+    return sub(v, mul(n, dot(v, n)));
+}
+
+// Any unit vector perpendicular to the unit vector n.
+Vec3x4 perpendicular(const Vec3x4& n) {
+    const auto abs_y = _mm_andnot_ps(_mm_set1_ps(-0.0f), n.y);
+    const auto use_up = _mm_cmplt_ps(abs_y, _mm_set1_ps(0.9f));
+    const auto axis = select(use_up, splat(0.0f, 1.0f, 0.0f), splat(1.0f, 0.0f, 0.0f));
+    const auto p = cross(n, axis);
+
+    // n can't be parallel to the axis picked, the epsilon only keeps a degenerate n from producing NaNs.
+    return mul(p, _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(length(p), _mm_set1_ps(EPSILON))));
+}
+}
+
+size_t solve_two_bone(std::span<const Vector4f> root, std::span<const Vector4f> mid, std::span<const Vector4f> end,
+    std::span<const Vector4f> target, std::span<const Vector4f> pole, const TwoBoneLimits& limits,
+    std::span<Vector4f> out_mid, std::span<Vector4f> out_end, std::span<uint8_t> reached)
+{
+    using namespace detail;
+
+    auto count = std::min({root.size(), mid.size(), end.size(), target.size(), out_mid.size(), out_end.size()});
+    const auto has_pole = !pole.empty();
+
+    if (has_pole) {
+        count = std::min(count, pole.size());
+    }
+
+    if (!reached.empty()) {
+        count = std::min(count, reached.size());
+    }
+
+    // The distance between root and end grows with the bend angle, so the limits become a distance range.
+    const auto min_bend = std::clamp(limits.min_bend, 0.0f, glm::pi<float>());
+    const auto max_bend = std::clamp(limits.max_bend, min_bend, glm::pi<float>());
+    const auto cos_min = _mm_set1_ps(std::cos(min_bend));
+    const auto cos_max = _mm_set1_ps(std::cos(max_bend));
+    const auto zero = _mm_setzero_ps();
+    const auto two = _mm_set1_ps(2.0f);
+    const auto eps = _mm_set1_ps(EPSILON);
+
+    size_t num_reached = 0;
+
+    for (size_t i = 0; i < count; i += 4) {
+        Vector4f buf[4]{};
+
+        gather(root, i, count, 1, 0, buf);
+        const auto r = load(buf);
+        gather(mid, i, count, 1, 0, buf);
+        const auto m = load(buf);
+        gather(end, i, count, 1, 0, buf);
+        const auto e = load(buf);
+        gather(target, i, count, 1, 0, buf);
+        const auto t = load(buf);
+
+        const auto upper = sub(m, r);
+        const auto lower = sub(e, m);
+        const auto l0_sq = dot(upper, upper);
+        const auto l1_sq = dot(lower, lower);
+        const auto two_l0_l1 = _mm_mul_ps(two, _mm_sqrt_ps(_mm_mul_ps(l0_sq, l1_sq)));
+        const auto sum_sq = _mm_add_ps(l0_sq, l1_sq);
+
+        const auto d_min = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(sum_sq, _mm_mul_ps(two_l0_l1, cos_min)), zero));
+        const auto d_max = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(sum_sq, _mm_mul_ps(two_l0_l1, cos_max)), zero));
+
+        const auto to_target = sub(t, r);
+        const auto to_end = sub(e, r);
+        const auto d_raw = length(to_target);
+        const auto d = _mm_min_ps(_mm_max_ps(d_raw, d_min), d_max);
+        const auto is_reached = _mm_and_ps(_mm_cmpge_ps(d_raw, _mm_sub_ps(d_min, eps)), _mm_cmple_ps(d_raw, _mm_add_ps(d_max, eps)));
+
+        // Target sitting on the root, keep pointing where the chain points now.
+        const auto n = direction(to_target, d_raw, direction(to_end, length(to_end), splat(0.0f, 1.0f, 0.0f)));
+
+        // Bend direction, falling back to the current bend plane, then to anything perpendicular for a straight chain.
+        const auto current_bend = reject(upper, n);
+        auto bend = direction(current_bend, length(current_bend), perpendicular(n));
+
+        if (has_pole) {
+            gather(pole, i, count, 1, 0, buf);
+            const auto pole_bend = reject(sub(load(buf), r), n);
+            bend = direction(pole_bend, length(pole_bend), bend);
+        }
+
+        // Law of cosines, a is how far along root -> target the middle joint sits and h how far it's pushed out.
+        const auto a = select(_mm_cmpgt_ps(d, eps),
+            _mm_div_ps(_mm_add_ps(_mm_sub_ps(l0_sq, l1_sq), _mm_mul_ps(d, d)), _mm_mul_ps(two, _mm_max_ps(d, eps))),
+            zero);
+        const auto h = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(l0_sq, _mm_mul_ps(a, a)), zero));
+
+        Vector4f mids[4]{};
+        Vector4f ends[4]{};
+        store(add(add(r, mul(n, a)), mul(bend, h)), mids);
+        store(add(r, mul(n, d)), ends);
+
+        const auto reached_bits = _mm_movemask_ps(is_reached);
+        const auto valid = std::min<size_t>(4, count - i);
+
+        for (size_t k = 0; k < valid; ++k) {
+            out_mid[i + k] = mids[k];
+            out_end[i + k] = ends[k];
+
+            const auto lane_reached = (reached_bits >> k) & 1;
+            num_reached += lane_reached;
+
+            if (!reached.empty()) {
+                reached[i + k] = (uint8_t)lane_reached;
+            }
+        }
+    }
+
+    return num_reached;
+}
+
+size_t fabrik(std::span<Vector4f> chains, size_t joints_per_chain, std::span<const Vector4f> target,
+    std::span<const Vector4f> pole, const FabrikSettings& settings, std::span<uint8_t> reached)
+{
+    using namespace detail;
+
+    if (joints_per_chain < 2) {
+        return 0;
+    }
+
+    auto count = std::min(chains.size() / joints_per_chain, target.size());
+    const auto has_pole = !pole.empty();
+
+    if (has_pole) {
+        count = std::min(count, pole.size());
+    }
+
+    if (!reached.empty()) {
+        count = std::min(count, reached.size());
+    }
+
+    const auto n = joints_per_chain;
+    const auto tolerance = _mm_set1_ps(std::max(settings.tolerance, 0.0f));
+
+    std::vector<Vec3x4> p(n);
+    std::vector<Vec3x4> q(n);
+    std::vector<__m128> lengths(n - 1);
+    std::span<const Vector4f> in{chains.data(), chains.size()};
+
+    size_t num_reached = 0;
+
+    for (size_t i = 0; i < count; i += 4) {
+        Vector4f buf[4]{};
+
+        for (size_t j = 0; j < n; ++j) {
+            gather(in, i, count, n, j, buf);
+            p[j] = load(buf);
+        }
+
+        gather(target, i, count, 1, 0, buf);
+        const auto t = load(buf);
+
+        auto total = _mm_setzero_ps();
+
+        for (size_t j = 0; j + 1 < n; ++j) {
+            lengths[j] = length(sub(p[j + 1], p[j]));
+            total = _mm_add_ps(total, lengths[j]);
+        }
+
+        const auto root = p[0];
+        const auto to_target = sub(t, root);
+        const auto dist = length(to_target);
+        const auto dir = direction(to_target, dist, splat(0.0f, 1.0f, 0.0f));
+        const auto out_of_reach = _mm_cmpgt_ps(dist, total);
+
+        // Out of reach, the chain is stretched straight at the target.
+        for (size_t j = 0; j + 1 < n; ++j) {
+            const auto stretched = add(p[j], mul(dir, lengths[j]));
+            p[j + 1] = select(out_of_reach, stretched, p[j + 1]);
+        }
+
+        // Lanes stop being updated as soon as they're done, so they don't depend on the other chains in the group.
+        auto active = _mm_andnot_ps(out_of_reach, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+        for (uint32_t iteration = 0; iteration < settings.iterations; ++iteration) {
+            const auto error = length(sub(p[n - 1], t));
+            active = _mm_and_ps(active, _mm_cmpgt_ps(error, tolerance));
+
+            if (_mm_movemask_ps(active) == 0) {
+                break;
+            }
+
+            q[n - 1] = t;
+
+            for (size_t j = n - 1; j-- > 0;) {
+                const auto v = sub(p[j], q[j + 1]);
+                q[j] = add(q[j + 1], mul(direction(v, length(v), dir), lengths[j]));
+            }
+
+            q[0] = root;
+
+            for (size_t j = 1; j < n; ++j) {
+                const auto v = sub(q[j], q[j - 1]);
+                q[j] = add(q[j - 1], mul(direction(v, length(v), dir), lengths[j - 1]));
+            }
+
+            for (size_t j = 0; j < n; ++j) {
+                p[j] = select(active, q[j], p[j]);
+            }
+        }
+
+        // Turn each interior joint around the line between its neighbours so it faces the pole.
+        // Its distance to both neighbours stays the same.
+        if (has_pole) {
+            gather(pole, i, count, 1, 0, buf);
+            const auto pl = load(buf);
+
+            for (size_t j = 1; j + 1 < n; ++j) {
+                const auto line = sub(p[j + 1], p[j - 1]);
+                const auto axis = direction(line, length(line), dir);
+                const auto foot = add(p[j - 1], mul(axis, dot(sub(p[j], p[j - 1]), axis)));
+                const auto radius = length(sub(p[j], foot));
+                const auto to_pole = reject(sub(pl, foot), axis);
+                const auto pole_dist = length(to_pole);
+                const auto facing = add(foot, mul(to_pole, _mm_div_ps(radius, _mm_max_ps(pole_dist, _mm_set1_ps(EPSILON)))));
+
+                p[j] = select(_mm_cmpgt_ps(pole_dist, _mm_set1_ps(EPSILON)), facing, p[j]);
+            }
+        }
+
+        const auto is_reached = _mm_cmple_ps(length(sub(p[n - 1], t)), tolerance);
+        const auto reached_bits = _mm_movemask_ps(is_reached);
+        const auto valid = std::min<size_t>(4, count - i);
+
+        for (size_t j = 0; j < n; ++j) {
+            store(p[j], buf);
+
+            for (size_t k = 0; k < valid; ++k) {
+                chains[(i + k) * n + j] = buf[k];
+            }
+        }
+
+        for (size_t k = 0; k < valid; ++k) {
+            const auto lane_reached = (reached_bits >> k) & 1;
+            num_reached += lane_reached;
+
+            if (!reached.empty()) {
+                reached[i + k] = (uint8_t)lane_reached;
+            }
+        }
+    }
+
+    return num_reached;
+}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "Math.hpp"
+
+// Batched inverse kinematics solvers, SSE accelerated.
+// Positions are stored padded to a glm::vec4 like in MathBatch, outputs get w = 1.
+// Every element goes through the same SIMD code no matter where it sits in the batch
+// (the tail is padded to a full group), so the output for a chain doesn't depend on the batch size.
+namespace utility::math::ik {
+struct TwoBoneLimits {
+    // Interior angle at the middle joint in radians, 0 is fully folded and pi is straight.
+    float min_bend{0.0f};
+    float max_bend{glm::pi<float>()};
+};
+
+// Solves root -> mid -> end chains so the end reaches target[i], bone lengths are taken from the input positions.
+// The middle joint bends towards pole[i], or stays in the plane it's currently bent in when pole is empty.
+// Targets that are out of reach, or need a bend outside of limits, are approached as closely as possible
+// along the root -> target line.
+// reached[i] (optional) is 1 if the target was reached. Returns the number of targets reached.
+size_t solve_two_bone(std::span<const Vector4f> root, std::span<const Vector4f> mid, std::span<const Vector4f> end,
+    std::span<const Vector4f> target, std::span<const Vector4f> pole, const TwoBoneLimits& limits,
+    std::span<Vector4f> out_mid, std::span<Vector4f> out_end, std::span<uint8_t> reached = {});
+
+struct FabrikSettings {
+    uint32_t iterations{10};
+    float tolerance{1e-3f};
+};
+
+// Solves chains of joints_per_chain joints stored one after the other in place, the first joint of each chain is the root.
+// Chains stop iterating on their own once their end is within tolerance of target[i].
+// The interior joints are turned towards pole[i] afterwards if pole isn't empty, bone lengths are kept.
+// Joint limits are only supported by solve_two_bone.
+// reached[i] (optional) is 1 if the chain's end is within tolerance. Returns the number of chains that reached their target.
+size_t fabrik(std::span<Vector4f> chains, size_t joints_per_chain, std::span<const Vector4f> target,
+    std::span<const Vector4f> pole, const FabrikSettings& settings, std::span<uint8_t> reached = {});
+}
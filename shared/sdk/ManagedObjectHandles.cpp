@@ -0,0 +1,181 @@
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "REManagedObject.hpp"
+#include "ManagedObjectHandles.hpp"
+
+namespace sdk {
+namespace managed_handles {
+namespace detail {
+// Slots live in fixed size chunks that are never freed or moved,
+// so resolving only needs the chunk pointer and two loads from the slot.
+constexpr size_t CHUNK_SIZE = 4096;
+constexpr size_t MAX_CHUNKS = 1024;
+
+struct Slot {
+    std::atomic<uint32_t> generation{1};
+    std::atomic<::REManagedObject*> object{nullptr};
+};
+
+using Chunk = std::array<Slot, CHUNK_SIZE>;
+
+std::array<std::atomic<Chunk*>, MAX_CHUNKS> g_chunks{};
+
+std::mutex g_mutex{};
+std::vector<std::unique_ptr<Chunk>> g_owned_chunks{};
+std::vector<uint32_t> g_free_slots{};
+uint32_t g_next_slot{0};
+std::atomic<size_t> g_size{0};
+
+constexpr Handle make_handle(uint32_t index, uint32_t generation) {
+    return ((Handle)generation << 32) | index;
+}
+
+constexpr uint32_t index_of(Handle handle) {
+    return (uint32_t)handle;
+}
+
+constexpr uint32_t generation_of(Handle handle) {
+    return (uint32_t)(handle >> 32);
+}
+
+Slot* get_slot(uint32_t index) {
+    if (index >= CHUNK_SIZE * MAX_CHUNKS) {
+        return nullptr;
+    }
+
+    const auto chunk = g_chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+
+    if (chunk == nullptr) {
+        return nullptr;
+    }
+
+    return &(*chunk)[index % CHUNK_SIZE];
+}
+
+// Must be called with g_mutex held.
+Slot* allocate_slot(uint32_t& out_index) {
+    if (!g_free_slots.empty()) {
+        out_index = g_free_slots.back();
+        g_free_slots.pop_back();
+        return get_slot(out_index);
+    }
+
+    if (g_next_slot >= CHUNK_SIZE * MAX_CHUNKS) {
+        return nullptr;
+    }
+
+    const auto chunk_index = g_next_slot / CHUNK_SIZE;
+
+    if (g_chunks[chunk_index].load(std::memory_order_relaxed) == nullptr) {
+        auto& chunk = g_owned_chunks.emplace_back(std::make_unique<Chunk>());
+        g_chunks[chunk_index].store(chunk.get(), std::memory_order_release);
+    }
+
+    out_index = g_next_slot++;
+    return get_slot(out_index);
+}
+}
+
+Handle acquire(::REManagedObject* object) {
+    if (object == nullptr) {
+        return 0;
+    }
+
+    uint32_t index{};
+    detail::Slot* slot{};
+
+    {
+        std::scoped_lock _{detail::g_mutex};
+
+        slot = detail::allocate_slot(index);
+
+        if (slot == nullptr) {
+            spdlog::error("[managed_handles] Handle table is full");
+            return 0;
+        }
+
+        slot->object.store(object, std::memory_order_release);
+    }
+
+    utility::re_managed_object::add_ref(object);
+    ++detail::g_size;
+
+    return detail::make_handle(index, slot->generation.load(std::memory_order_acquire));
+}
+
+bool release(Handle handle) {
+    const auto index = detail::index_of(handle);
+    const auto generation = detail::generation_of(handle);
+    const auto slot = detail::get_slot(index);
+
+    if (slot == nullptr || generation == 0) {
+        return false;
+    }
+
+    ::REManagedObject* object{};
+
+    {
+        std::scoped_lock _{detail::g_mutex};
+
+        if (slot->generation.load(std::memory_order_relaxed) != generation) {
+            return false;
+        }
+
+        object = slot->object.exchange(nullptr, std::memory_order_acq_rel);
+
+        // Skip 0 on wrap around so a zeroed handle can never match.
+        const auto next_generation = generation + 1 == 0 ? 1 : generation + 1;
+        slot->generation.store(next_generation, std::memory_order_release);
+
+        detail::g_free_slots.push_back(index);
+    }
+
+    if (object != nullptr) {
+        utility::re_managed_object::release(object);
+    }
+
+    --detail::g_size;
+    return true;
+}
+
+::REManagedObject* resolve(Handle handle) {
+    const auto generation = detail::generation_of(handle);
+    const auto slot = detail::get_slot(detail::index_of(handle));
+
+    if (slot == nullptr || slot->generation.load(std::memory_order_acquire) != generation) {
+        return nullptr;
+    }
+
+    const auto object = slot->object.load(std::memory_order_acquire);
+
+    // The slot may have been released and reused between the two loads above.
+    if (slot->generation.load(std::memory_order_acquire) != generation) {
+        return nullptr;
+    }
+
+    return object;
+}
+
+size_t resolve(std::span<const Handle> handles, std::span<::REManagedObject*> out) {
+    const auto count = std::min(handles.size(), out.size());
+    size_t num_valid = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = resolve(handles[i]);
+        num_valid += out[i] != nullptr ? 1 : 0;
+    }
+
+    return num_valid;
+}
+
+size_t size() {
+    return detail::g_size.load();
+}
+}
+}
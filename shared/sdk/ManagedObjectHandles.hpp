@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+class REManagedObject;
+
+namespace sdk {
+namespace managed_handles {
+// 64-bit generational handle, generation in the high half and table index in the low half.
+// 0 is never a valid handle.
+using Handle = uint64_t;
+
+// Creates a handle for the object, which holds a reference to it until released.
+// Returns 0 if object is null or the table is full.
+Handle acquire(::REManagedObject* object);
+
+// Frees the handle's slot and drops its reference. Every other copy of the handle becomes stale.
+// Returns false if the handle was already stale.
+bool release(Handle handle);
+
+// The object behind the handle, or nullptr if it has been released. Doesn't touch the object itself.
+::REManagedObject* resolve(Handle handle);
+
+inline bool is_valid(Handle handle) {
+    return resolve(handle) != nullptr;
+}
+
+// Resolves handles.size() handles into out, stale ones resolve to nullptr.
+// Returns how many were valid.
+size_t resolve(std::span<const Handle> handles, std::span<::REManagedObject*> out);
+
+// Number of handles currently alive.
+size_t size();
+}
+}
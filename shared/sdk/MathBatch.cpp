@@ -0,0 +1,329 @@
+#include <algorithm>
+
+#include <immintrin.h>
+
+#include "MathBatch.hpp"
+
+namespace utility::math::batch {
+namespace detail {
+__m128 transform(const __m128 (&cols)[4], __m128 v) {
+    auto r = _mm_mul_ps(cols[0], _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+    r = _mm_add_ps(r, _mm_mul_ps(cols[1], _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm_add_ps(r, _mm_mul_ps(cols[2], _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm_add_ps(r, _mm_mul_ps(cols[3], _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+
+    return r;
+}
+
+void load_columns(const Matrix4x4f& m, __m128 (&cols)[4]) {
+    for (auto i = 0; i < 4; ++i) {
+        cols[i] = _mm_loadu_ps(&m[i][0]);
+    }
+}
+
+void transform_with_w(std::span<const Vector4f> in, const Matrix4x4f& m, float w, std::span<Vector4f> out) {
+    __m128 cols[4]{};
+    load_columns(m, cols);
+
+    const auto count = std::min(in.size(), out.size());
+    const auto w_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    const auto w_value = _mm_set_ps(w, 0.0f, 0.0f, 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto v = _mm_loadu_ps(&in[i].x);
+        v = _mm_or_ps(_mm_andnot_ps(w_mask, v), w_value);
+
+        _mm_storeu_ps(&out[i].x, transform(cols, v));
+    }
+}
+}
+
+void transform_points(std::span<const Vector4f> points, const Matrix4x4f& m, std::span<Vector4f> out) {
+    detail::transform_with_w(points, m, 1.0f, out);
+}
+
+void transform_vectors(std::span<const Vector4f> vectors, const Matrix4x4f& m, std::span<Vector4f> out) {
+    detail::transform_with_w(vectors, m, 0.0f, out);
+}
+
+void transform_matrices(std::span<const Matrix4x4f> mats, const Matrix4x4f& m, std::span<Matrix4x4f> out) {
+    __m128 cols[4]{};
+    detail::load_columns(m, cols);
+
+    const auto count = std::min(mats.size(), out.size());
+
+    for (size_t i = 0; i < count; ++i) {
+        // Load all columns first, out may alias mats.
+        __m128 src[4]{};
+        detail::load_columns(mats[i], src);
+
+        for (auto c = 0; c < 4; ++c) {
+            _mm_storeu_ps(&out[i][c][0], detail::transform(cols, src[c]));
+        }
+    }
+}
+
+void distances(std::span<const Vector4f> points, const Vector3f& point, std::span<float> out) {
+    const auto count = std::min(points.size(), out.size());
+    const auto px = _mm_set1_ps(point.x);
+    const auto py = _mm_set1_ps(point.y);
+    const auto pz = _mm_set1_ps(point.z);
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        auto x = _mm_loadu_ps(&points[i].x);
+        auto y = _mm_loadu_ps(&points[i + 1].x);
+        auto z = _mm_loadu_ps(&points[i + 2].x);
+        auto w = _mm_loadu_ps(&points[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const auto dx = _mm_sub_ps(x, px);
+        const auto dy = _mm_sub_ps(y, py);
+        const auto dz = _mm_sub_ps(z, pz);
+        const auto d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+        _mm_storeu_ps(&out[i], _mm_sqrt_ps(d2));
+    }
+
+    for (; i < count; ++i) {
+        out[i] = glm::length(Vector3f{points[i]} - point);
+    }
+}
+
+size_t frustum_cull(std::span<const Vector4f> points, const Matrix4x4f& view_proj, float radius, std::span<uint8_t> out) {
+    const auto row = [&](int r) {
+        return Vector4f{view_proj[0][r], view_proj[1][r], view_proj[2][r], view_proj[3][r]};
+    };
+
+    // Gribb-Hartmann plane extraction. Checking both z >= 0 and z <= w covers reversed depth as well.
+    Vector4f planes[6]{
+        row(3) + row(0),
+        row(3) - row(0),
+        row(3) + row(1),
+        row(3) - row(1),
+        row(2),
+        row(3) - row(2),
+    };
+
+    for (auto& plane : planes) {
+        const auto len = glm::length(Vector3f{plane});
+
+        if (len > 0.0f) {
+            plane /= len;
+        }
+    }
+
+    const auto count = std::min(points.size(), out.size());
+    const auto neg_radius = _mm_set1_ps(-radius);
+    size_t visible = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        auto x = _mm_loadu_ps(&points[i].x);
+        auto y = _mm_loadu_ps(&points[i + 1].x);
+        auto z = _mm_loadu_ps(&points[i + 2].x);
+        auto w = _mm_loadu_ps(&points[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (const auto& plane : planes) {
+            auto d = _mm_mul_ps(x, _mm_set1_ps(plane.x));
+            d = _mm_add_ps(d, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            d = _mm_add_ps(d, _mm_set1_ps(plane.w));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, neg_radius));
+        }
+
+        const auto bits = _mm_movemask_ps(inside);
+
+        for (auto j = 0; j < 4; ++j) {
+            const auto is_visible = (bits >> j) & 1;
+            out[i + j] = (uint8_t)is_visible;
+            visible += is_visible;
+        }
+    }
+
+    for (; i < count; ++i) {
+        const auto p = Vector4f{Vector3f{points[i]}, 1.0f};
+        const auto is_visible = std::all_of(std::begin(planes), std::end(planes), [&](const Vector4f& plane) {
+            return glm::dot(plane, p) >= -radius;
+        });
+
+        out[i] = (uint8_t)is_visible;
+        visible += is_visible;
+    }
+
+    return visible;
+}
+
+size_t project_to_screen(std::span<const Vector4f> points, const Matrix4x4f& view_proj, const Vector2f& screen_size,
+    bool cull_offscreen, std::span<Vector2f> out, std::span<uint8_t> visible) 
+{
+    // Anything closer than this to the camera plane would blow up the perspective divide.
+    constexpr float min_w = 1e-5f;
+
+    const auto count = std::min({points.size(), out.size(), visible.size()});
+    const auto half_w = screen_size.x * 0.5f;
+    const auto half_h = screen_size.y * 0.5f;
+
+    const auto vhalf_w = _mm_set1_ps(half_w);
+    const auto vhalf_h = _mm_set1_ps(half_h);
+    const auto vmin_w = _mm_set1_ps(min_w);
+    const auto zero = _mm_setzero_ps();
+    const auto sign_mask = _mm_set1_ps(-0.0f);
+
+    // clip.r = dot(row r, vec4(p, 1))
+    const auto row = [&](int r, const __m128& x, const __m128& y, const __m128& z) {
+        auto d = _mm_mul_ps(x, _mm_set1_ps(view_proj[0][r]));
+        d = _mm_add_ps(d, _mm_mul_ps(y, _mm_set1_ps(view_proj[1][r])));
+        d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(view_proj[2][r])));
+        return _mm_add_ps(d, _mm_set1_ps(view_proj[3][r]));
+    };
+
+    size_t num_visible = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        auto x = _mm_loadu_ps(&points[i].x);
+        auto y = _mm_loadu_ps(&points[i + 1].x);
+        auto z = _mm_loadu_ps(&points[i + 2].x);
+        auto w = _mm_loadu_ps(&points[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const auto cx = row(0, x, y, z);
+        const auto cy = row(1, x, y, z);
+        const auto cw = row(3, x, y, z);
+
+        auto inside = _mm_cmpgt_ps(cw, vmin_w);
+
+        if (cull_offscreen) {
+            const auto cz = row(2, x, y, z);
+
+            inside = _mm_and_ps(inside, _mm_cmple_ps(_mm_andnot_ps(sign_mask, cx), cw));
+            inside = _mm_and_ps(inside, _mm_cmple_ps(_mm_andnot_ps(sign_mask, cy), cw));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(cz, zero));
+            inside = _mm_and_ps(inside, _mm_cmple_ps(cz, cw));
+        }
+
+        const auto bits = _mm_movemask_ps(inside);
+
+        if (bits == 0) {
+            std::fill_n(&visible[i], 4, (uint8_t)0);
+            continue;
+        }
+
+        // ndc [-1, 1] to pixels, y flipped.
+        const auto inv_w = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(cw, vmin_w));
+        const auto sx = _mm_add_ps(vhalf_w, _mm_mul_ps(_mm_mul_ps(cx, inv_w), vhalf_w));
+        const auto sy = _mm_sub_ps(vhalf_h, _mm_mul_ps(_mm_mul_ps(cy, inv_w), vhalf_h));
+
+        alignas(16) float xs[4]{};
+        alignas(16) float ys[4]{};
+        _mm_store_ps(xs, sx);
+        _mm_store_ps(ys, sy);
+
+        for (auto j = 0; j < 4; ++j) {
+            const auto is_visible = (bits >> j) & 1;
+            visible[i + j] = (uint8_t)is_visible;
+            num_visible += is_visible;
+
+            if (is_visible) {
+                out[i + j] = Vector2f{xs[j], ys[j]};
+            }
+        }
+    }
+
+    for (; i < count; ++i) {
+        const auto clip = view_proj * Vector4f{Vector3f{points[i]}, 1.0f};
+        auto is_visible = clip.w > min_w;
+
+        if (cull_offscreen) {
+            is_visible = is_visible && std::abs(clip.x) <= clip.w && std::abs(clip.y) <= clip.w && clip.z >= 0.0f && clip.z <= clip.w;
+        }
+
+        visible[i] = (uint8_t)is_visible;
+
+        if (is_visible) {
+            out[i] = Vector2f{half_w + (clip.x / clip.w) * half_w, half_h - (clip.y / clip.w) * half_h};
+            ++num_visible;
+        }
+    }
+
+    return num_visible;
+}
+
+namespace detail {
+template <bool include_w>
+void normalize(std::span<Vector4f> vectors) {
+    const auto zero = _mm_setzero_ps();
+    const auto one = _mm_set1_ps(1.0f);
+    size_t i = 0;
+
+    for (; i + 4 <= vectors.size(); i += 4) {
+        auto x = _mm_loadu_ps(&vectors[i].x);
+        auto y = _mm_loadu_ps(&vectors[i + 1].x);
+        auto z = _mm_loadu_ps(&vectors[i + 2].x);
+        auto w = _mm_loadu_ps(&vectors[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        auto len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+        if constexpr (include_w) {
+            len2 = _mm_add_ps(len2, _mm_mul_ps(w, w));
+        }
+
+        // Scale by 1 where the length is zero.
+        const auto nonzero = _mm_cmpgt_ps(len2, zero);
+        const auto inv_len = _mm_div_ps(one, _mm_sqrt_ps(_mm_or_ps(_mm_and_ps(nonzero, len2), _mm_andnot_ps(nonzero, one))));
+
+        x = _mm_mul_ps(x, inv_len);
+        y = _mm_mul_ps(y, inv_len);
+        z = _mm_mul_ps(z, inv_len);
+
+        if constexpr (include_w) {
+            w = _mm_mul_ps(w, inv_len);
+        }
+
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        _mm_storeu_ps(&vectors[i].x, x);
+        _mm_storeu_ps(&vectors[i + 1].x, y);
+        _mm_storeu_ps(&vectors[i + 2].x, z);
+        _mm_storeu_ps(&vectors[i + 3].x, w);
+    }
+
+    for (; i < vectors.size(); ++i) {
+        auto& v = vectors[i];
+        const auto len = include_w ? glm::length(v) : glm::length(Vector3f{v});
+
+        if (len > 0.0f) {
+            v.x /= len;
+            v.y /= len;
+            v.z /= len;
+
+            if constexpr (include_w) {
+                v.w /= len;
+            }
+        }
+    }
+}
+}
+
+void normalize3(std::span<Vector4f> vectors) {
+    detail::normalize<false>(vectors);
+}
+
+void normalize4(std::span<Vector4f> vectors) {
+    detail::normalize<true>(vectors);
+}
+
+void slerp(std::span<const glm::quat> a, std::span<const glm::quat> b, float t, std::span<glm::quat> out) {
+    const auto count = std::min({a.size(), b.size(), out.size()});
+
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = glm::slerp(a[i], b[i], t);
+    }
+}
+}
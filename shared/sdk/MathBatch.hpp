@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "Math.hpp"
+
+// Batched math kernels over contiguous arrays, SSE accelerated.
+// 3D points and vectors are stored padded to a glm::vec4 so every element is one 16 byte load.
+// Outputs may alias inputs. Only min(input, output) elements are processed.
+namespace utility::math::batch {
+// out[i] = m * vec4(points[i].xyz, 1)
+void transform_points(std::span<const Vector4f> points, const Matrix4x4f& m, std::span<Vector4f> out);
+
+// out[i] = m * vec4(vectors[i].xyz, 0)
+void transform_vectors(std::span<const Vector4f> vectors, const Matrix4x4f& m, std::span<Vector4f> out);
+
+// out[i] = m * mats[i]
+void transform_matrices(std::span<const Matrix4x4f> mats, const Matrix4x4f& m, std::span<Matrix4x4f> out);
+
+// out[i] = length(points[i].xyz - point)
+void distances(std::span<const Vector4f> points, const Vector3f& point, std::span<float> out);
+
+// Tests spheres of the given radius around each point against the frustum of a D3D style
+// (0 <= z <= w) view projection matrix. Works for both regular and reversed depth.
+// out[i] is 1 if visible, 0 otherwise. Returns the number of visible points.
+size_t frustum_cull(std::span<const Vector4f> points, const Matrix4x4f& view_proj, float radius, std::span<uint8_t> out);
+
+// Projects points through a view projection matrix onto a screen of the given size,
+// origin at the top left with y going down (same as via.math.worldPos2ScreenPos).
+// visible[i] is 0 for points behind the camera and, with cull_offscreen, for points outside the frustum.
+// out[i] is only written for visible points. Returns the number of visible points.
+size_t project_to_screen(std::span<const Vector4f> points, const Matrix4x4f& view_proj, const Vector2f& screen_size,
+    bool cull_offscreen, std::span<Vector2f> out, std::span<uint8_t> visible);
+
+// Normalizes the xyz part of each element, w is left untouched. Zero length vectors are left as they are.
+void normalize3(std::span<Vector4f> vectors);
+
+// Normalizes all four components, used for quaternions too. Zero length vectors are left as they are.
+void normalize4(std::span<Vector4f> vectors);
+
+// out[i] = slerp(a[i], b[i], t)
+void slerp(std::span<const glm::quat> a, std::span<const glm::quat> b, float t, std::span<glm::quat> out);
+}
@@ -248,6 +248,17 @@ void TreeNode::append_action(uint32_t action_index) {
     tree_data->actions.data = new_array;*/
 }
 
+void TreeNode::append_actions(std::span<const uint32_t> action_indices) {
+    auto tree_data = get_data();
+
+    if (tree_data == nullptr) {
+        return;
+    }
+
+    auto& arr = *(sdk::NativeArrayNoCapacity<uint32_t>*)&tree_data->actions;
+    arr.append_range(action_indices);
+}
+
 void TreeNode::replace_action(uint32_t index, uint32_t action_index) {
     auto tree_data = get_data();
 
@@ -301,6 +312,17 @@ void TreeNode::remove_action(uint32_t index) {
     tree_data->actions.data = new_array;*/
 }
 
+void TreeNode::remove_actions(uint32_t index, uint32_t count) {
+    auto tree_data = get_data();
+
+    if (tree_data == nullptr) {
+        return;
+    }
+
+    auto& arr = *(sdk::NativeArrayNoCapacity<uint32_t>*)&tree_data->actions;
+    arr.erase_range(index, count);
+}
+
 void TreeNode::relocate(uintptr_t old_start, uintptr_t old_end, uintptr_t new_start) {
     auto selector = (::REManagedObject*)get_selector();
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "REString.hpp"
@@ -115,8 +116,10 @@ public:
     std::vector<TreeNode*> get_start_states() const;
     
     void append_action(uint32_t action_index);
+    void append_actions(std::span<const uint32_t> action_indices);
     void replace_action(uint32_t index, uint32_t action_index);
     void remove_action(uint32_t index);
+    void remove_actions(uint32_t index, uint32_t count);
 
     // Getters just in-case we decide to dynamically generate the structure layout
     // instead of using manual offsets.
@@ -1,3 +1,7 @@
+#include <atomic>
+#include <mutex>
+
+#include <spdlog/spdlog.h>
 #include <utility/String.hpp>
 
 #include "RETypeDB.hpp"
@@ -6,18 +10,71 @@
 #include "MurmurHash.hpp"
 
 namespace sdk::murmur_hash {
+namespace detail {
+// Whether the native implementation agrees with the engine. Checked once, when the TDB is up.
+bool use_native() {
+    enum State { UNCHECKED, NATIVE, ENGINE };
+    static std::atomic<State> state{UNCHECKED};
+    static std::mutex mtx{};
+
+    if (const auto s = state.load(); s != UNCHECKED) {
+        return s == NATIVE;
+    }
+
+    if (sdk::RETypeDB::get() == nullptr || type() == nullptr) {
+        // Can't check yet, trust the native version until we can.
+        return true;
+    }
+
+    std::scoped_lock _{mtx};
+
+    if (const auto s = state.load(); s != UNCHECKED) {
+        return s == NATIVE;
+    }
+
+    constexpr std::wstring_view samples[]{L"", L"a", L"ab", L"Head", L"Neck_1", L"r_arm_wrist", L"vfx_muzzle1"};
+
+    for (const auto sample : samples) {
+        const auto native = calc32_native(sample);
+        const auto engine = calc32_engine(sample);
+
+        if (native != engine) {
+            spdlog::error("[MurmurHash] Native hash of \"{}\" is {:x}, engine says {:x}. Falling back to the engine.", utility::narrow(sample), native, engine);
+            state = ENGINE;
+            return false;
+        }
+    }
+
+    spdlog::info("[MurmurHash] Native hash matches the engine");
+    state = NATIVE;
+    return true;
+}
+}
+
 sdk::RETypeDefinition* type() {
     static auto t = sdk::find_type_definition("via.murmur_hash");
     return t;
 }
 
-uint32_t calc32(std::wstring_view str) {
+uint32_t calc32_engine(std::wstring_view str) {
     static auto calc_method = type()->get_method("calc32");
 
     return calc_method->call<uint32_t>(sdk::get_thread_context(), sdk::VM::create_managed_string(str));
 }
 
+uint32_t calc32(std::wstring_view str) {
+    if (detail::use_native()) {
+        return calc32_native(str);
+    }
+
+    return calc32_engine(str);
+}
+
 uint32_t calc32(std::string_view str) {
-    return calc32(utility::widen(str));
+    if (detail::use_native()) {
+        return calc32_native(str);
+    }
+
+    return calc32_engine(utility::widen(str));
 }
 }
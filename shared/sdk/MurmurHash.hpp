@@ -1,15 +1,202 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string_view>
 
 // via.murmur_hash internally
+// The engine hashes the UTF-16LE bytes of a string with MurmurHash3 (x86, 32 bit) and a seed of 0xFFFFFFFF.
+// Everything below is a native reimplementation of that, so hashing a name doesn't need the VM.
 namespace sdk {
 struct RETypeDefinition;
 
 namespace murmur_hash {
+constexpr uint32_t SEED = 0xFFFFFFFF;
+
+namespace detail {
+constexpr uint32_t rotl(uint32_t x, uint32_t r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+constexpr uint32_t mix_k(uint32_t k) {
+    k *= 0xcc9e2d51;
+    k = rotl(k, 15);
+    k *= 0x1b873593;
+    return k;
+}
+
+constexpr uint32_t mix_h(uint32_t h, uint32_t k) {
+    h ^= mix_k(k);
+    h = rotl(h, 13);
+    return h * 5 + 0xe6546b64;
+}
+
+constexpr uint32_t fmix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+// Feeds UTF-16 code units two at a time, which is exactly one 4 byte murmur block.
+class Hasher {
+public:
+    constexpr void add(char16_t c) {
+        if (m_has_pending) {
+            m_h = mix_h(m_h, (uint32_t)m_pending | ((uint32_t)c << 16));
+            m_has_pending = false;
+        } else {
+            m_pending = c;
+            m_has_pending = true;
+        }
+
+        m_len += 2;
+    }
+
+    // Adds a code point, as one unit or a surrogate pair.
+    constexpr void add_code_point(uint32_t cp) {
+        if (cp >= 0x10000) {
+            cp -= 0x10000;
+            add((char16_t)(0xD800 + (cp >> 10)));
+            add((char16_t)(0xDC00 + (cp & 0x3FF)));
+        } else {
+            add((char16_t)cp);
+        }
+    }
+
+    constexpr uint32_t finish() const {
+        auto h = m_h;
+
+        if (m_has_pending) {
+            h ^= mix_k((uint32_t)m_pending);
+        }
+
+        return fmix(h ^ m_len);
+    }
+
+private:
+    uint32_t m_h{SEED};
+    uint32_t m_len{0};
+    char16_t m_pending{0};
+    bool m_has_pending{false};
+};
+}
+
+constexpr uint32_t calc32_native(std::u16string_view str) {
+    detail::Hasher hasher{};
+
+    for (const auto c : str) {
+        hasher.add(c);
+    }
+
+    return hasher.finish();
+}
+
+// Decodes UTF-8 and hashes it as UTF-16, so valid UTF-8 gives the same result as widening first.
+// Anything else (bad continuation bytes, overlong encodings, surrogates, past U+10FFFF)
+// is hashed as one U+FFFD per byte, same as the JSON encoder replaces it.
+constexpr uint32_t calc32_native(std::string_view str) {
+    detail::Hasher hasher{};
+
+    for (size_t i = 0; i < str.size();) {
+        const auto c = (uint8_t)str[i];
+
+        if (c < 0x80) {
+            hasher.add((char16_t)c);
+            ++i;
+            continue;
+        }
+
+        size_t len = 0;
+
+        if (c >= 0xC2 && c <= 0xDF) {
+            len = 2;
+        } else if ((c & 0xF0) == 0xE0) {
+            len = 3;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            len = 4;
+        }
+
+        bool valid = len != 0 && i + len <= str.size();
+
+        for (size_t j = 1; valid && j < len; ++j) {
+            valid = ((uint8_t)str[i + j] & 0xC0) == 0x80;
+        }
+
+        // The second byte is narrower for these leads, anything outside the range is an
+        // overlong encoding, a UTF-16 surrogate or past U+10FFFF.
+        if (valid) {
+            const auto c1 = (uint8_t)str[i + 1];
+
+            switch (c) {
+            case 0xE0: valid = c1 >= 0xA0; break;
+            case 0xED: valid = c1 <= 0x9F; break;
+            case 0xF0: valid = c1 >= 0x90; break;
+            case 0xF4: valid = c1 <= 0x8F; break;
+            default: break;
+            }
+        }
+
+        if (!valid) {
+            hasher.add(u'\xFFFD');
+            ++i;
+            continue;
+        }
+
+        uint32_t cp = c & (0xFF >> (len + 1));
+
+        for (size_t j = 1; j < len; ++j) {
+            cp = (cp << 6) | ((uint8_t)str[i + j] & 0x3F);
+        }
+
+        hasher.add_code_point(cp);
+        i += len;
+    }
+
+    return hasher.finish();
+}
+
+constexpr uint32_t calc32_native(std::wstring_view str) {
+    detail::Hasher hasher{};
+
+    for (const auto c : str) {
+        if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+            hasher.add((char16_t)c);
+        } else {
+            hasher.add_code_point((uint32_t)c);
+        }
+    }
+
+    return hasher.finish();
+}
+
+// Hashes many strings at once, 4 at a time with SSE2. out must be at least as large as strs.
+void calc32_native(std::span<const std::u16string_view> strs, std::span<uint32_t> out);
+
 sdk::RETypeDefinition* type();
+
+// Native, but checked against the engine's via.murmur_hash.calc32 the first time it's used
+// and the TDB is available. Falls back to the engine if they ever disagree.
 uint32_t calc32(std::wstring_view str);
 uint32_t calc32(std::string_view str);
+
+// Always goes through the VM.
+uint32_t calc32_engine(std::wstring_view str);
+
+namespace literals {
+consteval uint32_t operator""_murmur(const char* str, size_t len) {
+    return calc32_native(std::string_view{str, len});
+}
+
+consteval uint32_t operator""_murmur(const char16_t* str, size_t len) {
+    return calc32_native(std::u16string_view{str, len});
+}
+
+consteval uint32_t operator""_murmur(const wchar_t* str, size_t len) {
+    return calc32_native(std::wstring_view{str, len});
+}
+}
+}
 }
-}
\ No newline at end of file
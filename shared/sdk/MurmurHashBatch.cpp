@@ -0,0 +1,102 @@
+#include <algorithm>
+
+#include <immintrin.h>
+
+#include "MurmurHash.hpp"
+
+// The batched calc32_native, kept apart from the engine fallback so it builds without the SDK.
+namespace sdk::murmur_hash {
+namespace detail {
+__m128i mullo_epi32(__m128i a, __m128i b) {
+    // SSE2 has no 32 bit low multiply, do the even and odd lanes separately.
+    const auto even = _mm_mul_epu32(a, b);
+    const auto odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+template <int R>
+__m128i rotl_epi32(__m128i x) {
+    return _mm_or_si128(_mm_slli_epi32(x, R), _mm_srli_epi32(x, 32 - R));
+}
+
+uint32_t block(std::u16string_view str, size_t i) {
+    return (uint32_t)str[i * 2] | ((uint32_t)str[i * 2 + 1] << 16);
+}
+
+// Hashes the blocks from first_block onwards into h, including the tail and length, but not the final mix.
+uint32_t hash_remaining(uint32_t h, std::u16string_view str, size_t first_block) {
+    const auto num_blocks = str.size() / 2;
+
+    for (auto i = first_block; i < num_blocks; ++i) {
+        h = mix_h(h, block(str, i));
+    }
+
+    if ((str.size() & 1) != 0) {
+        h ^= mix_k((uint32_t)str.back());
+    }
+
+    return h ^ (uint32_t)(str.size() * 2);
+}
+
+void calc32_x4(const std::u16string_view* strs, uint32_t* out) {
+    size_t common_blocks = strs[0].size() / 2;
+
+    for (auto i = 1; i < 4; ++i) {
+        common_blocks = std::min(common_blocks, strs[i].size() / 2);
+    }
+
+    const auto c1 = _mm_set1_epi32((int)0xcc9e2d51);
+    const auto c2 = _mm_set1_epi32((int)0x1b873593);
+    const auto five = _mm_set1_epi32(5);
+    const auto n = _mm_set1_epi32((int)0xe6546b64);
+
+    auto h = _mm_set1_epi32((int)SEED);
+
+    // Blocks every lane has.
+    for (size_t b = 0; b < common_blocks; ++b) {
+        auto k = _mm_set_epi32((int)block(strs[3], b), (int)block(strs[2], b), (int)block(strs[1], b), (int)block(strs[0], b));
+
+        k = mullo_epi32(k, c1);
+        k = rotl_epi32<15>(k);
+        k = mullo_epi32(k, c2);
+
+        h = _mm_xor_si128(h, k);
+        h = rotl_epi32<13>(h);
+        h = _mm_add_epi32(mullo_epi32(h, five), n);
+    }
+
+    // Each lane finishes its own blocks and tail.
+    alignas(16) uint32_t lanes[4]{};
+    _mm_store_si128((__m128i*)lanes, h);
+
+    for (auto i = 0; i < 4; ++i) {
+        lanes[i] = hash_remaining(lanes[i], strs[i], common_blocks);
+    }
+
+    h = _mm_load_si128((const __m128i*)lanes);
+
+    // fmix
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    h = mullo_epi32(h, _mm_set1_epi32((int)0x85ebca6b));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+    h = mullo_epi32(h, _mm_set1_epi32((int)0xc2b2ae35));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+
+    _mm_storeu_si128((__m128i*)out, h);
+}
+}
+
+void calc32_native(std::span<const std::u16string_view> strs, std::span<uint32_t> out) {
+    const auto count = std::min(strs.size(), out.size());
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        detail::calc32_x4(&strs[i], &out[i]);
+    }
+
+    for (; i < count; ++i) {
+        out[i] = calc32_native(strs[i]);
+    }
+}
+}
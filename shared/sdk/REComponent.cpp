@@ -0,0 +1,275 @@
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <utility/PointerMap.hpp>
+
+#include "REManagedObject.hpp"
+#include "RETypeDB.hpp"
+#include "RETypes.hpp"
+#include "SceneManager.hpp"
+
+#include "REComponent.hpp"
+
+namespace utility::re_component {
+namespace detail {
+constexpr size_t NUM_SHARDS = 16;
+constexpr size_t MAX_CACHED_OBJECTS_PER_SHARD = 32768 / NUM_SHARDS;
+// Guards against walking a corrupted list forever.
+constexpr size_t MAX_COMPONENTS = 1024;
+constexpr size_t MAX_TRANSFORMS = 1 << 20;
+
+struct CachedComponent {
+    ::REComponent* component{nullptr}; // nullptr = known to not exist
+    ::REType* type{nullptr};           // exact type of component when it was cached
+};
+
+struct ComponentCache {
+    ::RETransform* transform{nullptr};
+    uint64_t checksum{0};
+    uint64_t validated_frame{0};
+    std::vector<::REComponent*> components{};
+    utility::PointerMap<CachedComponent> by_type{16};
+};
+
+// GameObjects are spread over shards so lookups from different threads rarely share a lock.
+struct alignas(64) CacheShard {
+    std::mutex mtx{};
+    utility::PointerMap<std::unique_ptr<ComponentCache>> caches{};
+};
+
+std::array<CacheShard, NUM_SHARDS> g_shards{};
+std::atomic<uint64_t> g_frame{1};
+
+CacheShard& get_shard(::REGameObject* owner) {
+    // Objects are 16 byte aligned, mix the rest of the address before picking a shard.
+    const auto hash = ((uint64_t)(uintptr_t)owner >> 4) * 0x9E3779B97F4A7C15ull;
+    return g_shards[(hash >> 32) % NUM_SHARDS];
+}
+
+std::mutex g_type_names_mtx{};
+std::unordered_map<std::string, ::REType*> g_types_by_name{};
+
+// Walks the list once, only touching the link pointers.
+template <typename F>
+uint64_t walk_components(::RETransform* transform, F&& f) {
+    auto head = (::REComponent*)transform;
+    uint64_t checksum = 0xcbf29ce484222325ull;
+    size_t count = 0;
+
+    for (auto child = head->childComponent; child != nullptr && child != head && count < MAX_COMPONENTS; child = child->childComponent, ++count) {
+        checksum = (checksum ^ (uint64_t)(uintptr_t)child) * 0x100000001b3ull;
+        f(child);
+    }
+
+    return checksum ^ count;
+}
+
+std::unique_ptr<ComponentCache> build_component_cache(::RETransform* transform) {
+    auto cache = std::make_unique<ComponentCache>();
+
+    cache->transform = transform;
+    cache->validated_frame = g_frame.load();
+    cache->checksum = walk_components(transform, [&](::REComponent* c) {
+        cache->components.push_back(c);
+    });
+
+    return cache;
+}
+
+// Only follows the links of the live list, component itself is never dereferenced.
+bool is_attached(::RETransform* transform, ::REComponent* component) {
+    auto head = (::REComponent*)transform;
+    size_t count = 0;
+
+    for (auto child = head->childComponent; child != nullptr && child != head && count < MAX_COMPONENTS; child = child->childComponent, ++count) {
+        if (child == component) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ComponentCache* get_component_cache(CacheShard& shard, ::REGameObject* owner) {
+    if (shard.caches.size() >= MAX_CACHED_OBJECTS_PER_SHARD && shard.caches.find(owner) == nullptr) {
+        shard.caches.clear();
+    }
+
+    auto& cache = shard.caches[owner];
+    const auto frame = g_frame.load();
+
+    if (cache == nullptr || cache->transform != owner->transform) {
+        cache = build_component_cache(owner->transform);
+    } else if (cache->validated_frame != frame) {
+        const auto checksum = walk_components(owner->transform, [](::REComponent*) {});
+
+        if (checksum != cache->checksum) {
+            cache = build_component_cache(owner->transform);
+        } else {
+            cache->validated_frame = frame;
+        }
+    }
+
+    return cache.get();
+}
+
+// nullopt if the cached component isn't attached to owner anymore.
+std::optional<::REComponent*> find_in_cache(ComponentCache* cache, ::REGameObject* owner, ::REType* t) {
+    if (auto known = cache->by_type.find(t); known != nullptr) {
+        // A miss can only go stale until the next frame's validation. A hit may have been removed
+        // and freed since, so it has to be found in the live list before it can be looked at.
+        const auto component = known->component;
+
+        if (component == nullptr || (is_attached(owner->transform, component) && utility::re_managed_object::get_type(component) == known->type)) {
+            return component;
+        }
+
+        return std::nullopt;
+    }
+
+    ::REComponent* found{nullptr};
+
+    for (auto c : cache->components) {
+        if (utility::re_managed_object::is_a(c, t)) {
+            found = c;
+            break;
+        }
+    }
+
+    cache->by_type[t] = CachedComponent{found, found != nullptr ? utility::re_managed_object::get_type(found) : nullptr};
+    return found;
+}
+
+// Caller holds shard.mtx.
+::REComponent* find(CacheShard& shard, ::REGameObject* owner, ::REType* t) {
+    if (auto found = find_in_cache(get_component_cache(shard, owner), owner, t); found.has_value()) {
+        return *found;
+    }
+
+    // The component was removed from the GameObject since it was cached.
+    auto& cache = shard.caches[owner];
+    cache = build_component_cache(owner->transform);
+
+    return find_in_cache(cache.get(), owner, t).value_or(nullptr);
+}
+}
+
+::REComponent* find_cached(::REGameObject* owner, ::REType* t) {
+    if (owner == nullptr || owner->transform == nullptr || t == nullptr) {
+        return nullptr;
+    }
+
+    auto& shard = detail::get_shard(owner);
+    std::scoped_lock _{shard.mtx};
+
+    return detail::find(shard, owner, t);
+}
+
+::REType* get_type_by_name(std::string_view name) {
+    std::scoped_lock _{detail::g_type_names_mtx};
+
+    const auto key = std::string{name};
+
+    if (auto it = detail::g_types_by_name.find(key); it != detail::g_types_by_name.end()) {
+        return it->second;
+    }
+
+    auto& types = reframework::get_types();
+
+    if (types == nullptr) {
+        return nullptr;
+    }
+
+    auto t = types->get(name);
+
+    // Not cached when missing, the type may just not be registered yet.
+    if (t != nullptr) {
+        detail::g_types_by_name[key] = t;
+    }
+
+    return t;
+}
+
+std::vector<::REComponent*> find_all(::REType* t) {
+    std::vector<::REComponent*> out{};
+
+    if (t == nullptr) {
+        return out;
+    }
+
+    auto scene = sdk::get_current_scene();
+
+    if (scene == nullptr) {
+        return out;
+    }
+
+    static auto scene_def = sdk::find_type_definition("via.Scene");
+    auto first_transform = sdk::call_native_func_easy<::RETransform*>(scene, scene_def, "get_FirstTransform");
+
+    std::vector<::RETransform*> stack{};
+    std::vector<::REGameObject*> owners{};
+    size_t visited = 0;
+
+    if (first_transform != nullptr) {
+        stack.push_back(first_transform);
+    }
+
+    // Depth first over the whole hierarchy, children included. No locks held while walking.
+    while (!stack.empty() && visited < detail::MAX_TRANSFORMS) {
+        auto transform = stack.back();
+        stack.pop_back();
+        ++visited;
+
+        if (transform->next != nullptr) {
+            stack.push_back(transform->next);
+        }
+
+        if (transform->child != nullptr) {
+            stack.push_back(transform->child);
+        }
+
+        auto owner = transform->ownerGameObject;
+
+        if (owner == nullptr || owner->transform != transform) {
+            continue;
+        }
+
+        owners.push_back(owner);
+    }
+
+    for (auto owner : owners) {
+        auto& shard = detail::get_shard(owner);
+        std::scoped_lock _{shard.mtx};
+
+        if (auto found = detail::find(shard, owner, t); found != nullptr) {
+            out.push_back(found);
+        }
+    }
+
+    return out;
+}
+
+void invalidate_cache(::REGameObject* owner) {
+    if (owner != nullptr) {
+        auto& shard = detail::get_shard(owner);
+        std::scoped_lock _{shard.mtx};
+
+        shard.caches.erase(owner);
+        return;
+    }
+
+    for (auto& shard : detail::g_shards) {
+        std::scoped_lock _{shard.mtx};
+        shard.caches.clear();
+    }
+}
+
+void advance_cache_frame() {
+    ++detail::g_frame;
+}
+}
@@ -1,8 +1,26 @@
 #pragma once
 
+#include <string_view>
+#include <vector>
+
 #include "ReClass.hpp"
 
 namespace utility::re_component {
+    // Cached lookups, implemented in REComponent.cpp.
+    // Every GameObject gets a flat copy of its component list and a memo of (type -> component).
+    // The list is re-checked against a pointer checksum once per frame (see advance_cache_frame),
+    // cached hits are checked to still be in the GameObject's component list on every lookup.
+    // Caches are sharded by GameObject, so lookups on different objects rarely contend.
+    ::REComponent* find_cached(::REGameObject* owner, ::REType* t);
+    // Type lookup by full name, cached. nullptr if the type doesn't exist.
+    ::REType* get_type_by_name(std::string_view name);
+    // Every component in the current scene that is_a t, at most one per GameObject.
+    std::vector<::REComponent*> find_all(::REType* t);
+    // Drops the cache for one GameObject, or everything if owner is nullptr.
+    void invalidate_cache(::REGameObject* owner = nullptr);
+    // Called once per frame at BeginRendering.
+    void advance_cache_frame();
+
     static auto get_game_object(::REComponent* comp) {
         //return utility::re_managed_object::get_field<::REGameObject*>(comp, "GameObject");
         return comp->ownerGameObject;
@@ -21,7 +39,7 @@ namespace utility::re_component {
     }
 
     template<typename T = ::REComponent>
-    static T* find(::REComponent* comp, std::string_view name) {
+    static T* find_uncached(::REComponent* comp, std::string_view name) {
         for (auto child = comp->childComponent; child != nullptr && child != comp; child = child->childComponent) {
             if (utility::re_managed_object::is_a(child, name)) {
                 return (T*)child;
@@ -32,7 +50,7 @@ namespace utility::re_component {
     }
 
     template<typename T = ::REComponent>
-    static T* find(::REComponent* comp, REType* t) {
+    static T* find_uncached(::REComponent* comp, REType* t) {
         for (auto child = comp->childComponent; child != nullptr && child != comp; child = child->childComponent) {
             if (utility::re_managed_object::is_a(child, t)) {
                 return (T*)child;
@@ -42,6 +60,27 @@ namespace utility::re_component {
         return nullptr;
     }
 
+    template<typename T = ::REComponent>
+    static T* find(::REComponent* comp, REType* t) {
+        auto owner = comp->ownerGameObject;
+
+        // Searching from the transform covers the whole GameObject, which is what the cache holds.
+        if (owner != nullptr && (::REComponent*)owner->transform == comp) {
+            return (T*)find_cached(owner, t);
+        }
+
+        return find_uncached<T>(comp, t);
+    }
+
+    template<typename T = ::REComponent>
+    static T* find(::REComponent* comp, std::string_view name) {
+        if (auto t = get_type_by_name(name); t != nullptr) {
+            return find<T>(comp, t);
+        }
+
+        return find_uncached<T>(comp, name);
+    }
+
     // Find a component using the getComponent method
     /*template <typename T = ::REComponent>
     static T *find_using_method(::REComponent *comp, std::string_view name) {
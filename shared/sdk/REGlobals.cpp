@@ -157,19 +157,21 @@ std::vector<::REType*>& REGlobals::get_native_singleton_types() {
 }
 
 REManagedObject* REGlobals::get(std::string_view name) {
-    std::lock_guard _{ m_map_mutex };
-
     auto get_obj = [&]() -> REManagedObject* {
-        if (m_object_map.empty()) {
-            auto getter = m_getters.find(name.data());
+        const auto object_map = m_object_map.load(std::memory_order_acquire);
+
+        if (object_map == nullptr || object_map->empty()) {
+            auto getter = m_getters.find(name);
 
             if (getter != m_getters.end()) {
                 return getter->second();
             }
         }
 
-        if (auto it = m_object_map.find(name.data()); it != m_object_map.end()) {
-            return *it->second;
+        if (object_map != nullptr) {
+            if (auto it = object_map->find(name); it != object_map->end()) {
+                return *it->second;
+            }
         }
 
         return nullptr;
@@ -177,14 +179,36 @@ REManagedObject* REGlobals::get(std::string_view name) {
 
     auto obj = get_obj();
 
+    if (obj != nullptr) {
+        return obj;
+    }
+
+    std::lock_guard _{ m_map_mutex };
+
+    // Someone may have polled for this every frame while the game is loading,
+    // don't keep rescanning for it.
+    const auto now = std::chrono::steady_clock::now();
+
+    if (auto it = m_misses.find(name); it != m_misses.end() && now - it->second < MISS_RETRY_INTERVAL) {
+        return nullptr;
+    }
+
     // try to refresh the map if the object doesnt exist.
     // assume the user knows this object exists.
+    refresh_map();
+
+    // try again after refreshing the map
+    obj = get_obj();
+
     if (obj == nullptr) {
-        refresh_map();
+        m_misses.insert_or_assign(std::string{name}, now);
+    } else {
+        if (auto it = m_misses.find(name); it != m_misses.end()) {
+            m_misses.erase(it);
+        }
     }
 
-    // try again after refreshing the map
-    return obj == nullptr ? get_obj() : obj;
+    return obj;
 }
 
 REManagedObject* REGlobals::operator[](std::string_view name) {
@@ -193,7 +217,8 @@ REManagedObject* REGlobals::operator[](std::string_view name) {
 
 void REGlobals::safe_refresh() {
     std::lock_guard _{ m_map_mutex };
-    refresh_map();
+    refresh_map(true);
+    m_misses.clear();
 }
 
 void REGlobals::safe_refresh_native() {
@@ -224,10 +249,23 @@ void REGlobals::refresh_natives() {
     });
 }
 
-void REGlobals::refresh_map() {
-    for (auto obj_ptr : m_objects) {
+void REGlobals::refresh_map(bool full) {
+    m_last_seen_objects.resize(m_object_list.size(), nullptr);
+
+    const auto current_map = m_object_map.load(std::memory_order_acquire);
+    std::shared_ptr<ObjectMap> new_map{};
+
+    for (size_t i = 0; i < m_object_list.size(); ++i) {
+        const auto obj_ptr = m_object_list[i];
         auto obj = *obj_ptr;
 
+        // Nothing new in this slot since the last scan.
+        if (!full && obj == m_last_seen_objects[i]) {
+            continue;
+        }
+
+        m_last_seen_objects[i] = obj;
+
         // Make sure the pointer is aligned on an 8-byte boundary.
         if (obj == nullptr || ((uintptr_t)obj & (sizeof(void*) - 1)) != 0) {
             continue;
@@ -240,6 +278,8 @@ void REGlobals::refresh_map() {
         auto t = utility::re_managed_object::safe_get_type(obj);
 
         if (t == nullptr || t->name == nullptr) {
+            // Type might not be initialized yet, look at it again next time.
+            m_last_seen_objects[i] = nullptr;
             continue;
         }
 
@@ -250,6 +290,25 @@ void REGlobals::refresh_map() {
             m_acknowledged_objects.insert(obj_ptr);
         }
 
-        m_object_map[t->name] = obj_ptr;
+        const std::string_view name{t->name};
+        const auto map = new_map != nullptr ? new_map.get() : current_map.get();
+
+        if (map != nullptr) {
+            if (auto it = map->find(name); it != map->end() && it->second == obj_ptr) {
+                continue;
+            }
+        }
+
+        // Copy on write, readers may still be looking at the current map.
+        if (new_map == nullptr) {
+            new_map = current_map != nullptr ? std::make_shared<ObjectMap>(*current_map) : std::make_shared<ObjectMap>();
+        }
+
+        (*new_map)[std::string{name}] = obj_ptr;
+        m_misses.erase(std::string{name});
+    }
+
+    if (new_map != nullptr) {
+        m_object_map.store(std::move(new_map), std::memory_order_release);
     }
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -37,16 +40,41 @@ public:
     void safe_refresh_native();
 
 private:
-    void refresh_natives();
-    void refresh_map();
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    template <typename T>
+    using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
 
     // Class name to object like "app.foo.bar" -> 0xDEADBEEF
-    std::unordered_map<std::string, REManagedObject**> m_object_map;
+    using ObjectMap = StringMap<REManagedObject**>;
+
+    // How long a name that wasn't found stops get() from scanning the globals again.
+    static constexpr auto MISS_RETRY_INTERVAL = std::chrono::milliseconds{250};
+
+    void refresh_natives();
+
+    // Rescans the global slots whose value changed since the last scan (or all of them)
+    // and publishes a new map if any name was added or moved.
+    void refresh_map(bool full = false);
+
+    // Read without taking m_map_mutex. Published maps are immutable, a replaced map
+    // is freed once the last reader holding it lets go.
+    std::atomic<std::shared_ptr<const ObjectMap>> m_object_map{};
+
+    // Names that weren't found, and when we last looked for them.
+    StringMap<std::chrono::steady_clock::time_point> m_misses{};
 
     // Raw list of objects (for if the type hasn't been fully initialized, we need to refresh the map)
     std::unordered_set<REManagedObject**> m_objects;
     std::vector<REManagedObject**> m_object_list;
-    std::unordered_map<std::string, std::function<REManagedObject* ()>> m_getters;
+    std::vector<REManagedObject*> m_last_seen_objects; // value of each m_object_list slot at the last scan
+    StringMap<std::function<REManagedObject* ()>> m_getters;
 
     // List of objects we've already logged
     std::unordered_set<REManagedObject**> m_acknowledged_objects;
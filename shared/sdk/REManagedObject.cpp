@@ -1,6 +1,11 @@
+#include <atomic>
+#include <bit>
+#include <mutex>
+
 #include <spdlog/spdlog.h>
 
 #include "Memory.hpp"
+#include "utility/PointerMap.hpp"
 #include "utility/Scan.hpp"
 #include "utility/Module.hpp"
 
@@ -83,6 +88,161 @@ void release(REManagedObject* object) {
     //spdlog::info("Now: {}", (int32_t)object->referenceCount);
 }
 
+void add_ref(std::span<::REManagedObject* const> objects) {
+    for (auto object : objects) {
+        add_ref(object);
+    }
+}
+
+void release(std::span<::REManagedObject* const> objects) {
+    for (auto object : objects) {
+        release(object);
+    }
+}
+
+namespace detail {
+// Releases queued by one thread. Only that thread adds to it, the flushing thread drains it.
+struct DeferredReleaseQueue {
+    std::mutex mtx{};
+    utility::PointerMap<int32_t> pending{256};
+    std::vector<::REManagedObject*> order{};
+};
+
+std::atomic<bool> g_deferred_releases_enabled{false};
+std::mutex g_deferred_queues_mtx{};
+std::vector<std::weak_ptr<DeferredReleaseQueue>> g_deferred_queues{}; // expired ones are pruned on flush
+std::vector<::REManagedObject*> g_orphaned_releases{}; // left behind by threads that exited
+
+// Owns the calling thread's queue. Releases still pending when the thread exits
+// are handed over to the next flush instead of dying with the queue.
+struct DeferredReleaseQueueOwner {
+    std::shared_ptr<DeferredReleaseQueue> queue{std::make_shared<DeferredReleaseQueue>()};
+
+    DeferredReleaseQueueOwner() {
+        std::scoped_lock _{g_deferred_queues_mtx};
+        g_deferred_queues.push_back(queue);
+    }
+
+    ~DeferredReleaseQueueOwner() {
+        std::scoped_lock _{queue->mtx, g_deferred_queues_mtx};
+
+        for (auto object : queue->order) {
+            if (auto count = queue->pending.find(object); count != nullptr) {
+                g_orphaned_releases.insert(g_orphaned_releases.end(), (size_t)std::max(*count, 0), object);
+            }
+        }
+
+        queue->order.clear();
+        queue->pending.clear();
+    }
+};
+
+DeferredReleaseQueue& get_deferred_queue() {
+    thread_local DeferredReleaseQueueOwner owner{};
+
+    return *owner.queue;
+}
+}
+
+void set_deferred_releases_enabled(bool enabled) {
+    detail::g_deferred_releases_enabled = enabled;
+
+    if (!enabled) {
+        flush_deferred_releases();
+    }
+}
+
+bool is_deferred_releases_enabled() {
+    return detail::g_deferred_releases_enabled;
+}
+
+void add_ref_deferred(::REManagedObject* object) {
+    if (object == nullptr) {
+        return;
+    }
+
+    if (detail::g_deferred_releases_enabled) {
+        auto& queue = detail::get_deferred_queue();
+        std::scoped_lock _{queue.mtx};
+
+        // A release we haven't done yet cancels out with this add_ref.
+        if (auto count = queue.pending.find(object); count != nullptr && *count > 0) {
+            --*count;
+            return;
+        }
+    }
+
+    add_ref(object);
+}
+
+void release_deferred(::REManagedObject* object) {
+    if (object == nullptr) {
+        return;
+    }
+
+    if (!detail::g_deferred_releases_enabled) {
+        release(object);
+        return;
+    }
+
+    auto& queue = detail::get_deferred_queue();
+    std::scoped_lock _{queue.mtx};
+
+    auto& count = queue.pending[object];
+
+    if (count++ == 0) {
+        queue.order.push_back(object);
+    }
+}
+
+size_t flush_deferred_releases() {
+    std::vector<std::shared_ptr<detail::DeferredReleaseQueue>> queues{};
+    std::vector<::REManagedObject*> to_release{};
+
+    {
+        std::scoped_lock _{detail::g_deferred_queues_mtx};
+
+        // Drop the queues of threads that have exited.
+        std::erase_if(detail::g_deferred_queues, [](const auto& queue) { return queue.expired(); });
+
+        queues.reserve(detail::g_deferred_queues.size());
+
+        for (const auto& weak_queue : detail::g_deferred_queues) {
+            if (auto queue = weak_queue.lock(); queue != nullptr) {
+                queues.push_back(std::move(queue));
+            }
+        }
+
+        to_release.swap(detail::g_orphaned_releases);
+    }
+
+    release(to_release);
+    size_t num_released{to_release.size()};
+
+    for (auto& queue : queues) {
+        to_release.clear();
+
+        {
+            std::scoped_lock _{queue->mtx};
+
+            for (auto object : queue->order) {
+                if (auto count = queue->pending.find(object); count != nullptr) {
+                    to_release.insert(to_release.end(), (size_t)std::max(*count, 0), object);
+                }
+            }
+
+            queue->order.clear();
+            queue->pending.clear();
+        }
+
+        // Outside of the lock, releasing can run finalizers that queue more releases.
+        release(to_release);
+        num_released += to_release.size();
+    }
+
+    return num_released;
+}
+
 std::vector<::REManagedObject*> deserialize(const uint8_t* data, size_t size, bool add_references) {
     static void (*deserialize_func)(void* placeholder, const sdk::NativeArray<::REManagedObject*>&, const uint8_t*, size_t) = []() -> decltype(deserialize_func) {
         spdlog::info("[REManagedObject] Finding deserialize function...");
@@ -190,6 +350,195 @@ void deserialize_native(::REManagedObject* object, const uint8_t* data, size_t s
     deserializer(object, &stream, &objects_array);
 }
 
+namespace detail {
+// Insert-only open addressing set of object info pointers that are known to be valid,
+// so is_managed_object can skip re-validating the type chain behind them.
+// Lookups are lock free. Removal leaves a tombstone. When the table fills up, inserts
+// are dropped and those objects go through the slow path instead.
+class KnownInfoSet {
+public:
+    KnownInfoSet(size_t capacity)
+        : m_slots(std::bit_ceil(std::max<size_t>(capacity, 64)))
+    {
+    }
+
+    bool contains(const void* info) const {
+        const auto key = (uintptr_t)info;
+
+        for (size_t i = index_of(key), n = 0; n < m_slots.size(); i = (i + 1) & mask(), ++n) {
+            const auto slot = m_slots[i].load(std::memory_order_acquire);
+
+            if (slot == key) {
+                return true;
+            }
+
+            if (slot == EMPTY) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    bool insert(const void* info) {
+        const auto key = (uintptr_t)info;
+
+        if (key == EMPTY || key == TOMBSTONE) {
+            return false;
+        }
+
+        for (size_t i = index_of(key), n = 0; n < m_slots.size(); i = (i + 1) & mask(), ++n) {
+            auto slot = m_slots[i].load(std::memory_order_acquire);
+
+            if (slot == key) {
+                return true;
+            }
+
+            if (slot != EMPTY) {
+                continue;
+            }
+
+            // Keep the load factor at or below 3/4 so misses terminate quickly.
+            if ((m_size.load() + 1) * 4 > m_slots.size() * 3) {
+                return false;
+            }
+
+            if (m_slots[i].compare_exchange_strong(slot, key, std::memory_order_acq_rel)) {
+                ++m_size;
+                return true;
+            }
+
+            // Lost the race, slot now holds someone else's key (or ours).
+            if (slot == key) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void remove(const void* info) {
+        const auto key = (uintptr_t)info;
+
+        for (size_t i = index_of(key), n = 0; n < m_slots.size(); i = (i + 1) & mask(), ++n) {
+            auto slot = m_slots[i].load(std::memory_order_acquire);
+
+            if (slot == key) {
+                m_slots[i].compare_exchange_strong(slot, TOMBSTONE, std::memory_order_acq_rel);
+                return;
+            }
+
+            if (slot == EMPTY) {
+                return;
+            }
+        }
+    }
+
+    size_t size() const {
+        return m_size.load();
+    }
+
+private:
+    static constexpr uintptr_t EMPTY = 0;
+    static constexpr uintptr_t TOMBSTONE = 1;
+
+    size_t mask() const { return m_slots.size() - 1; }
+
+    size_t index_of(uintptr_t key) const {
+        return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> 32) & mask();
+    }
+
+    std::vector<std::atomic<uintptr_t>> m_slots;
+    std::atomic<size_t> m_size{0};
+};
+
+std::atomic<KnownInfoSet*> g_known_infos{nullptr};
+std::mutex g_known_infos_mtx{};
+
+#if TDB_VER >= 71
+bool is_valid_type_definition(sdk::RETypeDefinition* td) {
+    if (td->managed_vt == nullptr || sdk::memory::IsBadMemPtr(false, td->managed_vt, sizeof(void*))) {
+        return false;
+    }
+
+    if (*(sdk::RETypeDefinition**)td->managed_vt != td) {
+        return false;
+    }
+
+    if (td->type == nullptr || sdk::memory::IsBadMemPtr(false, td->type, sizeof(REType)) || td->type->name == nullptr) {
+        return false;
+    }
+
+    return !sdk::memory::IsBadMemPtr(false, td->type->name, sizeof(void*));
+}
+#endif
+
+// Built once the TDB is available, returns nullptr until then.
+KnownInfoSet* get_known_infos() {
+    auto known = g_known_infos.load(std::memory_order_acquire);
+
+    if (known != nullptr) {
+        return known;
+    }
+
+#if TDB_VER >= 71
+    std::scoped_lock _{g_known_infos_mtx};
+
+    known = g_known_infos.load(std::memory_order_acquire);
+
+    if (known != nullptr) {
+        return known;
+    }
+
+    const auto tdb = sdk::RETypeDB::get();
+
+    if (tdb == nullptr) {
+        return nullptr;
+    }
+
+    const auto num_types = tdb->get_num_types();
+
+    // Leaked on purpose, lookups never hold a lock so it can never be safely freed.
+    known = new KnownInfoSet{num_types * 2 + 1024};
+
+    for (uint32_t i = 0; i < num_types; ++i) {
+        const auto td = tdb->get_type(i);
+
+        if (td != nullptr && is_valid_type_definition(td)) {
+            known->insert(td->managed_vt);
+        }
+    }
+
+    spdlog::info("[REManagedObject] Built known object info set with {} entries", known->size());
+
+    g_known_infos.store(known, std::memory_order_release);
+    return known;
+#else
+    return nullptr;
+#endif
+}
+}
+
+void register_known_info(void* info) {
+    if (info == nullptr) {
+        return;
+    }
+
+    if (auto known = detail::get_known_infos(); known != nullptr) {
+        known->insert(info);
+    }
+}
+
+void unregister_known_info(void* info) {
+    if (info == nullptr) {
+        return;
+    }
+
+    if (auto known = detail::get_known_infos(); known != nullptr) {
+        known->remove(info);
+    }
+}
+
 bool is_managed_object(Address address) {
     if (address == nullptr) {
         return false;
@@ -201,6 +550,15 @@ bool is_managed_object(Address address) {
 
     auto object = address.as<::REManagedObject*>();
 
+#if TDB_VER >= 71
+    // Fast path, the info pointer is one we've already validated.
+    const auto known_infos = detail::get_known_infos();
+
+    if (known_infos != nullptr && object->info != nullptr && known_infos->contains(object->info)) {
+        return true;
+    }
+#endif
+
     if (object->info == nullptr || sdk::memory::IsBadMemPtr(false, object->info, sizeof(void*))) {
         return false;
     }
@@ -232,6 +590,11 @@ bool is_managed_object(Address address) {
     if (sdk::memory::IsBadMemPtr(false, td->type->name, sizeof(void*))) {
         return false;
     }
+
+    // Only remember genuine infos from the TDB, cloned ones can be freed by whoever made them.
+    if (known_infos != nullptr && (uintptr_t)td->managed_vt == (uintptr_t)object->info) {
+        known_infos->insert(object->info);
+    }
 #elif TDB_VER > 49
     if (class_info->parentInfo != object->info) {
         // This allows for cases when a vtable hook is being used to replace this pointer.
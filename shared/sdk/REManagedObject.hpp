@@ -1,3 +1,4 @@
+#include <span>
 #include <string_view>
 #include <memory>
 #include <vector>
@@ -22,6 +23,12 @@ namespace utility::re_managed_object {
 struct ParamWrapper;
 bool is_managed_object(Address address);
 
+// Marks an object info pointer as valid so is_managed_object can accept objects using it
+// without walking their type. Used for cloned infos, e.g. by REVTableHook.
+// The info must be unregistered before it is freed.
+void register_known_info(void* info);
+void unregister_known_info(void* info);
+
 // Check object type name
 bool is_a(::REManagedObject* object, std::string_view name);
 // Check object type
@@ -29,6 +36,19 @@ bool is_a(::REManagedObject* object, REType* cmp);
 
 void add_ref(::REManagedObject* object);
 void release(::REManagedObject* object);
+void add_ref(std::span<::REManagedObject* const> objects);
+void release(std::span<::REManagedObject* const> objects);
+
+// Deferred releases. When enabled, release_deferred queues the release on the calling thread
+// and add_ref_deferred cancels it out instead of touching the object's refcount, so objects
+// that get released and re-referenced within a frame cost nothing. Whatever is left is released
+// by flush_deferred_releases, which should be called at a safe point once per frame.
+// When disabled both behave like add_ref/release.
+void set_deferred_releases_enabled(bool enabled);
+bool is_deferred_releases_enabled();
+void add_ref_deferred(::REManagedObject* object);
+void release_deferred(::REManagedObject* object);
+size_t flush_deferred_releases(); // returns the number of releases performed
 std::vector<::REManagedObject*> deserialize(const uint8_t* data, size_t size, bool add_references);
 void deserialize_native(::REManagedObject* object, const uint8_t* data, size_t size, const std::vector<::REManagedObject*>& objects);
 
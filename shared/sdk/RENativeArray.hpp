@@ -1,8 +1,31 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
 #include "Memory.hpp"
 
 namespace sdk {
+namespace detail {
+// Moves count elements from src to dst, the ranges may overlap.
+template <typename T>
+void move_elements(T* dst, const T* src, size_t count) {
+    if (count == 0 || dst == src) {
+        return;
+    }
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memmove(dst, src, sizeof(T) * count);
+    } else if (dst < src) {
+        std::copy(src, src + count, dst);
+    } else {
+        std::copy_backward(src, src + count, dst + count);
+    }
+}
+}
+
 template <typename T> struct NativeArray {
     ~NativeArray() {
         if (elements != nullptr) {
@@ -33,6 +56,10 @@ template <typename T> struct NativeArray {
         return num;
     }
 
+    uint32_t capacity() const {
+        return elements != nullptr ? num_allocated : 0;
+    }
+
     bool empty() const {
         if (elements == nullptr || num == 0 || num_allocated == 0) {
             return true;
@@ -51,6 +78,15 @@ template <typename T> struct NativeArray {
         return;
     }
 
+    // Makes sure at least new_capacity elements fit without reallocating.
+    bool reserve(uint32_t new_capacity) {
+        if (elements != nullptr && new_capacity <= num_allocated) {
+            return true;
+        }
+
+        return reallocate(new_capacity);
+    }
+
     bool resize(uint32_t new_size) {
         if (new_size == num) {
             return true;
@@ -58,71 +94,63 @@ template <typename T> struct NativeArray {
 
         if (new_size == 0) {
             clear();
-            return;
+            return true;
         }
 
-        if (new_size > num_allocated) {
-            T* new_elements = (T*)sdk::memory::allocate(sizeof(T) * new_size);
-            if (new_elements == nullptr) {
+        if (new_size > num_allocated || elements == nullptr) {
+            if (!reallocate(new_size)) {
                 return false;
             }
+        }
 
-            if (elements != nullptr) {
-                for (uint32_t i = 0; i < num; i++) {
-                    if (i >= new_size) {
-                        break;
-                    }
-
-                    new_elements[i] = elements[i];
-                }
-
-                sdk::memory::deallocate(elements);
-            }
-
-            elements = new_elements;
-            num_allocated = new_size;
-        } else if (new_size > num) {
+        if (new_size > num) {
             for (uint32_t i = num; i < new_size; i++) {
                 elements[i] = T{};
             }
         } else if (new_size < num) {
-            for (uint32_t i = new_size - 1; i < num; i++) {
+            for (uint32_t i = new_size; i < num; i++) {
                 elements[i] = T{};
             }
         }
 
         num = new_size;
+        return true;
     }
 
-    T& emplace() {
-        if (elements == nullptr) {
-            elements = (T*)sdk::memory::allocate(sizeof(T) * 1);
+    // Appends a default constructed element, nullptr if the array couldn't grow.
+    T* emplace() {
+        if (!grow_for(1)) {
+            return nullptr;
+        }
 
-            num_allocated = 1;
-            num = 1;
+        elements[num++] = T{};
+        return &elements[num - 1];
+    }
 
-            elements[0] = T{};
-        } else {
-            if (num >= num_allocated) {
-                T* new_elements = (T*)sdk::memory::allocate(sizeof(T) * (num_allocated + 1));
+    bool push_back(T& value) {
+        const auto element = emplace();
 
-                for (uint32_t i = 0; i < num; i++) {
-                    new_elements[i] = elements[i];
-                }
+        if (element == nullptr) {
+            return false;
+        }
 
-                sdk::memory::deallocate(elements);
-                elements = new_elements;
-                ++num_allocated;
-            }
+        *element = value;
+        return true;
+    }
 
-            elements[num++] = T{};
+    // Appends all of values with at most one reallocation.
+    bool append_range(std::span<const T> values) {
+        if (values.empty()) {
+            return true;
         }
 
-        return elements[num - 1];
-    }
+        if (!grow_for((uint32_t)values.size())) {
+            return false;
+        }
 
-    void push_back(T& value) {
-        emplace() = value;
+        std::copy(values.begin(), values.end(), elements + num);
+        num += (uint32_t)values.size();
+        return true;
     }
 
     void pop_back() {
@@ -134,15 +162,18 @@ template <typename T> struct NativeArray {
     }
 
     void erase(uint32_t index) {
-        if (index >= num || elements == nullptr) {
-            return;
-        }
+        erase_range(index, 1);
+    }
 
-        for (uint32_t i = index; i < num - 1; ++i) {
-            elements[i] = elements[i + 1];
+    // Removes count elements starting at first, shifting the tail down in one move.
+    void erase_range(uint32_t first, uint32_t count) {
+        if (first >= num || elements == nullptr || count == 0) {
+            return;
         }
 
-        num--;
+        count = std::min(count, num - first);
+        detail::move_elements(elements + first, elements + first + count, num - first - count);
+        num -= count;
     }
 
     const T& operator[] (uint32_t index) const {
@@ -152,13 +183,48 @@ template <typename T> struct NativeArray {
     T& operator[] (uint32_t index) {
         return elements[index];
     }
+
+private:
+    bool reallocate(uint32_t new_capacity) {
+        T* new_elements = (T*)sdk::memory::allocate(sizeof(T) * new_capacity);
+
+        if (new_elements == nullptr) {
+            return false;
+        }
+
+        if (elements != nullptr) {
+            detail::move_elements(new_elements, elements, std::min(num, new_capacity));
+            sdk::memory::deallocate(elements);
+        } else {
+            num = 0;
+        }
+
+        elements = new_elements;
+        num_allocated = new_capacity;
+        num = std::min(num, new_capacity);
+        return true;
+    }
+
+    // Geometric growth so repeated emplace/push_back is amortized O(1).
+    bool grow_for(uint32_t extra) {
+        const auto needed = num + extra;
+
+        if (elements != nullptr && needed <= num_allocated) {
+            return true;
+        }
+
+        const auto current = elements != nullptr ? num_allocated : 0;
+        return reallocate(std::max<uint32_t>({needed, current + current / 2, 4}));
+    }
     
 public:
     T* elements{nullptr};
     uint32_t num{0};
-    uint32_t num_allocated;
+    uint32_t num_allocated{0};
 };
 
+// The count doubles as the allocation size, there is no capacity field to grow into,
+// so every size change reallocates. Prefer append_range over repeated push_back.
 template <typename T>
 struct NativeArrayNoCapacity {
     ~NativeArrayNoCapacity() {
@@ -211,6 +277,7 @@ struct NativeArrayNoCapacity {
         return;
     }
 
+    // Rewrites pointers inside the elements that point back into the array so they point into new_location instead.
     void relocate_pointers(T* new_location, uint32_t location_count) {
         if constexpr (sizeof(T) < sizeof(uintptr_t)) {
             return;
@@ -220,11 +287,18 @@ struct NativeArrayNoCapacity {
             return;
         }
 
-        for (uint32_t i = 0; i < num * sizeof(T); i++) {
-            const auto ptr = *(uintptr_t*)((uintptr_t)elements + i);
+        const auto start = (uintptr_t)elements;
+        const auto bytes = (uintptr_t)(std::min<uint64_t>(num, location_count) * sizeof(T));
 
-            if (ptr >= (uintptr_t)elements && ptr < (uintptr_t)elements + (num * sizeof(T))) {
-                *(uintptr_t*)((uintptr_t)new_location + i) = (uintptr_t)new_location + (ptr - (uintptr_t)elements);
+        // Pointer members are naturally aligned, so when T is a multiple of the pointer size
+        // only aligned offsets need to be looked at.
+        constexpr size_t step = sizeof(T) % sizeof(uintptr_t) == 0 ? sizeof(uintptr_t) : 1;
+
+        for (uintptr_t i = 0; i + sizeof(uintptr_t) <= bytes; i += step) {
+            const auto ptr = *(uintptr_t*)(start + i);
+
+            if (ptr >= start && ptr < start + (num * sizeof(T))) {
+                *(uintptr_t*)((uintptr_t)new_location + i) = (uintptr_t)new_location + (ptr - start);
             }
         }
     }
@@ -236,76 +310,67 @@ struct NativeArrayNoCapacity {
 
         if (new_size == 0) {
             clear();
-            return;
+            return true;
         }
 
         if (new_size > num_allocated || elements == nullptr) {
-            T* new_elements = (T*)sdk::memory::allocate(sizeof(T) * new_size);
-            if (new_elements == nullptr) {
-                return false;
-            }
-
-            if (elements != nullptr) {
-                for (uint32_t i = 0; i < num; i++) {
-                    if (i >= new_size) {
-                        break;
-                    }
-
-                    new_elements[i] = elements[i];
-                }
-
-                if (fix_pointers) {
-                    relocate_pointers(new_elements, num);
-                }
+            const auto old_size = elements != nullptr ? (uint32_t)num : 0;
 
-                sdk::memory::deallocate(elements);
+            if (!reallocate(new_size, fix_pointers)) {
+                return false;
             }
 
-            elements = new_elements;
-            num_allocated = new_size;
-        } else if (new_size > num) {
-            for (uint32_t i = num; i < new_size; i++) {
+            for (uint32_t i = old_size; i < new_size; i++) {
                 elements[i] = T{};
             }
         } else if (new_size < num) {
-            for (uint32_t i = new_size - 1; i < num; i++) {
+            for (uint32_t i = new_size; i < num; i++) {
                 elements[i] = T{};
             }
         }
 
         num = new_size;
+        return true;
     }
 
-    T& emplace(bool fix_pointers = false) {
-        if (elements == nullptr) {
-            elements = (T*)sdk::memory::allocate(sizeof(T) * 1);
+    // Appends a default constructed element, nullptr if the array couldn't be reallocated.
+    T* emplace(bool fix_pointers = false) {
+        const auto old_size = elements != nullptr ? (uint32_t)num : 0;
 
-            num = 1;
-            elements[0] = T{};
-        } else {
-            T* new_elements = (T*)sdk::memory::allocate(sizeof(T) * (num_allocated + 1));
-
-            for (uint32_t i = 0; i < num; i++) {
-                new_elements[i] = elements[i];
-            }
+        if (!reallocate(old_size + 1, fix_pointers)) {
+            return nullptr;
+        }
 
-            if (fix_pointers) {
-                relocate_pointers(new_elements, num);
-            }
+        elements[old_size] = T{};
+        return &elements[old_size];
+    }
 
-            sdk::memory::deallocate(elements);
+    bool push_back(T& value, bool fix_pointers = false) {
+        const auto element = emplace(fix_pointers);
 
-            elements = new_elements;
-            elements[num++] = T{};
+        if (element == nullptr) {
+            return false;
         }
 
-        return elements[num - 1];
+        *element = value;
+        return true;
     }
 
-    void push_back(T& value, bool fix_pointers = false) {
-        emplace(fix_pointers) = value;
-    }
+    // Appends all of values with a single reallocation and a single pointer fixup pass.
+    bool append_range(std::span<const T> values, bool fix_pointers = false) {
+        if (values.empty()) {
+            return true;
+        }
+
+        const auto old_size = elements != nullptr ? (uint32_t)num : 0;
 
+        if (!reallocate(old_size + (uint32_t)values.size(), fix_pointers)) {
+            return false;
+        }
+
+        std::copy(values.begin(), values.end(), elements + old_size);
+        return true;
+    }
 
     void pop_back() {
         if (elements == nullptr || num == 0) {
@@ -316,15 +381,18 @@ struct NativeArrayNoCapacity {
     }
 
     void erase(uint32_t index) {
-        if (index >= num || elements == nullptr) {
-            return;
-        }
+        erase_range(index, 1);
+    }
 
-        for (uint32_t i = index; i < num - 1; ++i) {
-            elements[i] = elements[i + 1];
+    // Removes count elements starting at first, shifting the tail down in one move.
+    void erase_range(uint32_t first, uint32_t count) {
+        if (first >= num || elements == nullptr || count == 0) {
+            return;
         }
 
-        num--;
+        count = (uint32_t)std::min<uint64_t>(count, num - first);
+        detail::move_elements(elements + first, elements + first + count, num - first - count);
+        num -= count;
     }
 
     const T& operator[] (uint32_t index) const {
@@ -335,6 +403,30 @@ struct NativeArrayNoCapacity {
         return elements[index];
     }
 
+private:
+    // Moves the elements into a new buffer of exactly new_size elements and sets num to it.
+    bool reallocate(uint32_t new_size, bool fix_pointers) {
+        T* new_elements = (T*)sdk::memory::allocate(sizeof(T) * new_size);
+
+        if (new_elements == nullptr) {
+            return false;
+        }
+
+        if (elements != nullptr) {
+            detail::move_elements(new_elements, elements, std::min<uint64_t>(num, new_size));
+
+            if (fix_pointers) {
+                relocate_pointers(new_elements, (uint32_t)std::min<uint64_t>(num, new_size));
+            }
+
+            sdk::memory::deallocate(elements);
+        }
+
+        elements = new_elements;
+        num = new_size;
+        return true;
+    }
+
 public:
     T* elements{nullptr};
 
@@ -343,4 +435,4 @@ public:
         uint64_t num_allocated;
     };
 };
-} // namespace sdk
\ No newline at end of file
+} // namespace sdk
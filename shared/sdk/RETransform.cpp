@@ -1,10 +1,196 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <sdk/REMath.hpp>
 #include <spdlog/spdlog.h>
 
+#include "utility/PointerMap.hpp"
+
 #include "Enums_Internal.hpp"
 #include "REString.hpp"
 #include "RETransform.hpp"
 
+namespace utility::re_transform::detail {
+struct WStringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::wstring_view s) const {
+        return std::hash<std::wstring_view>{}(s);
+    }
+};
+
+struct JointCache {
+    const void* joints_data{};
+    int32_t count{};
+
+    std::unordered_map<uint32_t, int32_t> by_hash{};
+    std::unordered_map<std::wstring, int32_t, WStringHash, std::equal_to<>> by_name{};
+};
+
+// Transforms that die leave their entry behind, so the whole cache gets dropped once it grows past this.
+constexpr size_t MAX_CACHED_TRANSFORMS = 4096;
+
+std::shared_mutex g_joint_cache_mtx{};
+utility::PointerMap<std::unique_ptr<JointCache>> g_joint_caches{};
+
+// The joint array's identity and size, {nullptr, 0} if the transform has no usable joints.
+std::pair<const void*, int32_t> get_joint_array(const ::RETransform& transform) {
+#if TDB_VER < 69
+    auto& joint_array = transform.joints;
+
+    if (joint_array.size <= 0 || joint_array.numAllocated <= 0 || joint_array.data == nullptr || joint_array.matrices == nullptr) {
+        return {nullptr, 0};
+    }
+
+    return {joint_array.data, joint_array.size};
+#else
+    if (transform.joints.data == nullptr || transform.joints.data->numElements <= 0) {
+        return {nullptr, 0};
+    }
+
+    return {transform.joints.data, transform.joints.data->numElements};
+#endif
+}
+
+bool has_joint_matrices(const ::RETransform& transform) {
+#if TDB_VER >= 70 && (defined(RE2) || defined(RE3) || defined(RE7))
+    return transform.jointMatrices != nullptr;
+#else
+    return transform.joints.matrices != nullptr;
+#endif
+}
+
+REJoint* get_joint_at(const ::RETransform& transform, int32_t index) {
+#if TDB_VER < 69
+    return transform.joints.data->joints[index];
+#else
+    return utility::re_array::get_element<REJoint>(transform.joints.data, index);
+#endif
+}
+
+std::unique_ptr<JointCache> build_joint_cache(const ::RETransform& transform, const void* joints_data, int32_t count) {
+    auto cache = std::make_unique<JointCache>();
+    cache->joints_data = joints_data;
+    cache->count = count;
+    cache->by_hash.reserve(count);
+    cache->by_name.reserve(count);
+
+    for (int32_t i = 0; i < count; ++i) {
+        const auto joint = get_joint_at(transform, i);
+
+        if (joint == nullptr || joint->info == nullptr || joint->info->name == nullptr) {
+            continue;
+        }
+
+        // First one wins, same as the linear scan did.
+        cache->by_hash.emplace(joint->info->nameHash, i);
+        cache->by_name.emplace(joint->info->name, i);
+    }
+
+    return cache;
+}
+
+// Calls f with the transform's up to date joint cache, or nullptr if it has no joints.
+template <typename F>
+auto with_joint_cache(const ::RETransform& transform, F&& f) {
+    const auto [joints_data, count] = get_joint_array(transform);
+
+    if (joints_data == nullptr) {
+        return f(nullptr);
+    }
+
+    {
+        std::shared_lock _{ g_joint_cache_mtx };
+
+        if (auto entry = g_joint_caches.find(&transform); entry != nullptr && (*entry)->joints_data == joints_data && (*entry)->count == count) {
+            return f(entry->get());
+        }
+    }
+
+    std::unique_lock _{ g_joint_cache_mtx };
+
+    if (g_joint_caches.size() >= MAX_CACHED_TRANSFORMS && g_joint_caches.find(&transform) == nullptr) {
+        g_joint_caches.clear();
+    }
+
+    auto& entry = g_joint_caches[&transform];
+
+    if (entry == nullptr || entry->joints_data != joints_data || entry->count != count) {
+        entry = build_joint_cache(transform, joints_data, count);
+    }
+
+    return f(entry.get());
+}
+
+// Double checks the cached index against the joint that's there now, the descs can change under the same array.
+template <typename Pred>
+REJoint* get_verified_joint(const ::RETransform& transform, const JointCache& cache, int32_t index, Pred&& matches) {
+    if (index < 0 || index >= cache.count) {
+        return nullptr;
+    }
+
+    const auto joint = get_joint_at(transform, index);
+
+    if (joint == nullptr || joint->info == nullptr || joint->info->name == nullptr || !matches(joint->info)) {
+        return nullptr;
+    }
+
+    return joint;
+}
+
+REJoint* find_joint(const ::RETransform& transform, const JointCache& cache, std::wstring_view name) {
+    const auto it = cache.by_name.find(name);
+
+    if (it == cache.by_name.end()) {
+        return nullptr;
+    }
+
+    return get_verified_joint(transform, cache, it->second, [name](const REJointDesc* info) { return name == info->name; });
+}
+
+REJoint* find_joint(const ::RETransform& transform, const JointCache& cache, uint32_t hash) {
+    const auto it = cache.by_hash.find(hash);
+
+    if (it == cache.by_hash.end()) {
+        return nullptr;
+    }
+
+    return get_verified_joint(transform, cache, it->second, [hash](const REJointDesc* info) { return hash == info->nameHash; });
+}
+
+// Returns std::nullopt when the transform has no joint array to build a cache from.
+template <typename Key>
+std::optional<REJoint*> find_cached_joint(const ::RETransform& transform, Key key) {
+    return with_joint_cache(transform, [&](const JointCache* cache) -> std::optional<REJoint*> {
+        if (cache == nullptr) {
+            return std::nullopt;
+        }
+
+        return find_joint(transform, *cache, key);
+    });
+}
+
+template <typename Key>
+size_t resolve_joints(const ::RETransform& transform, std::span<const Key> keys, std::span<REJoint*> out) {
+    const auto count = std::min(keys.size(), out.size());
+
+    return with_joint_cache(transform, [&](const JointCache* cache) -> size_t {
+        size_t num_found = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = cache != nullptr ? find_joint(transform, *cache, keys[i]) : nullptr;
+            num_found += out[i] != nullptr ? 1 : 0;
+        }
+
+        return num_found;
+    });
+}
+}
+
 namespace sdk {
 Vector4f sdk::get_transform_position(RETransform* transform) {
     static auto get_position_method = sdk::find_type_definition("via.Transform")->get_method("get_Position");
@@ -25,12 +211,25 @@ glm::quat sdk::get_transform_rotation(RETransform* transform) {
 }
 
 REJoint* get_transform_joint_by_hash(RETransform* transform, uint32_t hash) {
+    if (transform != nullptr) {
+        if (const auto joint = utility::re_transform::detail::find_cached_joint(*transform, hash)) {
+            return *joint;
+        }
+    }
+
     static auto get_joint_by_hash_method = sdk::find_type_definition("via.Transform")->get_method("getJointByHash");
-    
+
+
     return get_joint_by_hash_method->call<REJoint*>(sdk::get_thread_context(), transform, hash);
 }
 
 REJoint* get_transform_joint_by_name(RETransform* transform, std::wstring_view name) {
+    if (transform != nullptr) {
+        if (const auto joint = utility::re_transform::detail::find_cached_joint(*transform, name)) {
+            return *joint;
+        }
+    }
+
     static auto get_joint_by_name_method = sdk::find_type_definition("via.Transform")->get_method("getJointByName");
 
     return get_joint_by_name_method->call<REJoint*>(sdk::get_thread_context(), transform, sdk::VM::create_managed_string(name));
@@ -209,6 +408,22 @@ REJoint* get_joint(const ::RETransform& transform, uint32_t index) {
 #endif
 }
 
+REJoint* find_joint(const ::RETransform& transform, std::wstring_view name) {
+    return detail::find_cached_joint(transform, name).value_or(nullptr);
+}
+
+REJoint* find_joint_by_hash(const ::RETransform& transform, uint32_t hash) {
+    return detail::find_cached_joint(transform, hash).value_or(nullptr);
+}
+
+size_t resolve_joints(const ::RETransform& transform, std::span<const std::wstring_view> names, std::span<REJoint*> out) {
+    return detail::resolve_joints(transform, names, out);
+}
+
+size_t resolve_joints(const ::RETransform& transform, std::span<const uint32_t> hashes, std::span<REJoint*> out) {
+    return detail::resolve_joints(transform, hashes, out);
+}
+
 glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* target) {
     static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
     static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
@@ -243,44 +458,64 @@ glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* targ
     return parent_transform * base_transform;
 }
 
-void calculate_base_transforms(const ::RETransform& transform, REJoint* target, std::unordered_map<REJoint*, glm::mat4>& out) {
+const glm::mat4& BaseTransforms::get(REJoint* joint) const {
+    static const auto identity = glm::identity<glm::mat4>();
+
+    if (joint == nullptr) {
+        return identity;
+    }
+
+    const auto index = ((sdk::Joint*)joint)->get_joint_index();
+
+    if (index < 0 || (size_t)index >= this->computed.size() || this->computed[index] == 0) {
+        return identity;
+    }
+
+    return this->matrices[index];
+}
+
+void calculate_base_transforms(const ::RETransform& transform, REJoint* target, BaseTransforms& out) {
     static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
     static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
 
-    if (auto it = out.find(target); it != out.end()) {
+    // Null joints are left out, BaseTransforms::get returns identity for them.
+    if (target == nullptr || target->info == nullptr) {
         return;
     }
 
-    if (target == nullptr) {
-        out[target] = glm::identity<glm::mat4>();
+    const auto index = ((sdk::Joint*)target)->get_joint_index();
+
+    if (index < 0) {
         return;
     }
 
+    if ((size_t)index >= out.computed.size()) {
+        out.matrices.resize(index + 1, glm::identity<glm::mat4>());
+        out.computed.resize(index + 1, 0);
+    }
+
+    if (out.computed[index] != 0) {
+        return;
+    }
+
+    // Mark it first so a broken parent chain can't recurse forever, roots stay identity.
+    out.computed[index] = 1;
+    out.matrices[index] = glm::identity<glm::mat4>();
+
     auto parent = target->info->parentJoint;
 
     if (parent == -1) {
-        out[target] = glm::identity<glm::mat4>();
         return;
     }
 
     auto parent_joint = get_joint(transform, parent);
 
     if (parent_joint == nullptr) {
-        out[target] = glm::identity<glm::mat4>();
         return;
     }
 
     calculate_base_transforms(transform, parent_joint, out);
 
-    auto it = out.find(parent_joint);
-
-    if (it == out.end()) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
-    }
-
-    const auto& parent_transform = it->second;
-
     glm::quat base_rotation{};
     get_base_local_rotation_method->call<glm::quat*>(&base_rotation, sdk::get_thread_context(), target);
 
@@ -290,7 +525,193 @@ void calculate_base_transforms(const ::RETransform& transform, REJoint* target,
     // Convert to matrix
     const auto base_transform = glm::translate(glm::mat4(1.0f), glm::vec3(base_position.x, base_position.y, base_position.z)) * glm::mat4_cast(base_rotation);
 
-    out[target] = parent_transform * base_transform;
+    // out may have been resized by the recursion, so no references are held across it.
+    out.matrices[index] = out.get(parent_joint) * base_transform;
+}
+
+BaseTransforms calculate_base_transforms(const ::RETransform& transform) {
+    BaseTransforms out{};
+
+    const auto count = get_joint_count(transform);
+    out.matrices.resize(count, glm::identity<glm::mat4>());
+    out.computed.resize(count, 0);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        calculate_base_transforms(transform, detail::get_joint_at(transform, (int32_t)i), out);
+    }
+
+    return out;
+}
+
+uint32_t get_joint_count(const ::RETransform& transform) {
+    return (uint32_t)detail::get_joint_array(transform).second;
+}
+
+uint32_t read_pose(const ::RETransform& transform, const JointPoseBuffers& out) {
+    const auto [joints_data, count] = detail::get_joint_array(transform);
+
+    if (joints_data == nullptr) {
+        return 0;
+    }
+
+    const auto wants_world = !out.world_positions.empty() || !out.world_rotations.empty();
+    const auto has_matrices = detail::has_joint_matrices(transform);
+
+    for (int32_t i = 0; i < count; ++i) {
+        const auto joint = (sdk::Joint*)detail::get_joint_at(transform, i);
+
+        if (joint == nullptr) {
+            continue;
+        }
+
+        if ((size_t)i < out.local_positions.size()) {
+            out.local_positions[i] = joint->LocalPosition;
+        }
+
+        if ((size_t)i < out.local_rotations.size()) {
+            out.local_rotations[i] = *(glm::quat*)&joint->LocalRotation;
+        }
+
+        if (wants_world && has_matrices) {
+            const auto& world = get_joint_matrix_by_index(transform, i);
+
+            if ((size_t)i < out.world_positions.size()) {
+                out.world_positions[i] = Vector4f{Vector3f{world[3]}, 1.0f};
+            }
+
+            if ((size_t)i < out.world_rotations.size()) {
+                out.world_rotations[i] = glm::quat_cast(glm::extractMatrixRotation(world));
+            }
+        }
+    }
+
+    return (uint32_t)count;
+}
+
+uint32_t write_pose(::RETransform& transform, const JointPoseBuffers& in, std::span<const uint8_t> mask) {
+    const auto [joints_data, count] = detail::get_joint_array(transform);
+
+    if (joints_data == nullptr) {
+        return 0;
+    }
+
+    const auto has_world_input = !in.world_positions.empty() || !in.world_rotations.empty();
+    const auto has_matrices = detail::has_joint_matrices(transform);
+
+    // Joints whose world transform moved because they or one of their parents were written.
+    // Their children have to use the new world transform instead of the one in the joint matrices.
+    std::vector<uint8_t> moved(count, 0);
+    std::vector<uint8_t> written_above(count, 0);
+    std::vector<Vector3f> world_positions{};
+    std::vector<glm::quat> world_rotations{};
+
+    if (has_world_input) {
+        world_positions.resize(count);
+        world_rotations.resize(count);
+    }
+
+    const auto owner_position = Vector3f{transform.worldTransform[3]};
+    const auto owner_rotation = glm::quat_cast(glm::extractMatrixRotation(transform.worldTransform));
+
+    std::vector<int32_t> subtree_roots{};
+    uint32_t num_written = 0;
+
+    for (int32_t i = 0; i < count; ++i) {
+        const auto joint = (sdk::Joint*)detail::get_joint_at(transform, i);
+
+        if (joint == nullptr || ((::REJoint*)joint)->info == nullptr) {
+            continue;
+        }
+
+        const auto parent = (int32_t)((::REJoint*)joint)->info->parentJoint;
+        // Joints are stored parents first, anything else is treated as an untouched parent.
+        const auto parent_is_before = parent >= 0 && parent < i;
+
+        if (parent_is_before) {
+            written_above[i] = written_above[parent] | moved[parent];
+        }
+
+        const auto has_input = (size_t)i < in.local_positions.size() || (size_t)i < in.local_rotations.size() ||
+                               (size_t)i < in.world_positions.size() || (size_t)i < in.world_rotations.size();
+        const auto wants_write = has_input && (mask.empty() || ((size_t)i < mask.size() && mask[i] != 0));
+        auto local_position = joint->LocalPosition;
+        auto local_rotation = *(glm::quat*)&joint->LocalRotation;
+
+        if (wants_write) {
+            if ((size_t)i < in.local_positions.size()) {
+                local_position = Vector4f{Vector3f{in.local_positions[i]}, local_position.w};
+            }
+
+            if ((size_t)i < in.local_rotations.size()) {
+                local_rotation = in.local_rotations[i];
+            }
+        }
+
+        if (has_world_input) {
+            Vector3f parent_position{owner_position};
+            glm::quat parent_rotation{owner_rotation};
+
+            if (parent_is_before && moved[parent] != 0) {
+                parent_position = world_positions[parent];
+                parent_rotation = world_rotations[parent];
+            } else if (parent >= 0 && parent < count && has_matrices) {
+                const auto& parent_world = get_joint_matrix_by_index(transform, parent);
+                parent_position = Vector3f{parent_world[3]};
+                parent_rotation = glm::quat_cast(glm::extractMatrixRotation(parent_world));
+            }
+
+            auto world_position = parent_position + parent_rotation * Vector3f{local_position};
+            auto world_rotation = parent_rotation * local_rotation;
+
+            // Untouched chains keep the exact values the engine computed.
+            if (!wants_write && (!parent_is_before || moved[parent] == 0) && has_matrices) {
+                const auto& world = get_joint_matrix_by_index(transform, i);
+                world_position = Vector3f{world[3]};
+                world_rotation = glm::quat_cast(glm::extractMatrixRotation(world));
+            }
+
+            if (wants_write && ((size_t)i < in.world_positions.size() || (size_t)i < in.world_rotations.size())) {
+                if ((size_t)i < in.world_positions.size()) {
+                    world_position = Vector3f{in.world_positions[i]};
+                }
+
+                if ((size_t)i < in.world_rotations.size()) {
+                    world_rotation = in.world_rotations[i];
+                }
+
+                const auto inverse_parent_rotation = glm::inverse(parent_rotation);
+
+                local_position = Vector4f{inverse_parent_rotation * (world_position - parent_position), local_position.w};
+                local_rotation = glm::normalize(inverse_parent_rotation * world_rotation);
+            }
+
+            world_positions[i] = world_position;
+            world_rotations[i] = world_rotation;
+        }
+
+        if (!wants_write) {
+            moved[i] = parent_is_before ? moved[parent] : 0;
+            continue;
+        }
+
+        joint->LocalPosition = local_position;
+        *(glm::quat*)&joint->LocalRotation = local_rotation;
+
+        moved[i] = 1;
+        ++num_written;
+
+        if (written_above[i] == 0) {
+            subtree_roots.push_back(i);
+        }
+    }
+
+    // Going through the setter once per subtree is enough for the engine to mark everything below it dirty.
+    for (const auto index : subtree_roots) {
+        const auto joint = (sdk::Joint*)detail::get_joint_at(transform, index);
+        sdk::set_joint_local_rotation((::REJoint*)joint, *(glm::quat*)&joint->LocalRotation);
+    }
+
+    return num_written;
 }
 
 Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* joint, uint32_t depth) {
@@ -310,20 +731,20 @@ Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* joint, uin
         joints.push_back(cur_joint);
     }
 
-    std::unordered_map<REJoint*, glm::mat4> known_joints{};
+    utility::re_transform::BaseTransforms known_joints{};
     utility::re_transform::calculate_base_transforms(transform, joint, known_joints);
     utility::re_transform::calculate_base_transforms(transform, cur_joint, known_joints);
 
     auto parent_pos = sdk::get_joint_position(cur_joint);
     auto parent_rot = sdk::get_joint_rotation(cur_joint);
-    auto original_parent_pos = player_pos + (player_rot * known_joints[cur_joint][3]);
+    auto original_parent_pos = player_pos + (player_rot * known_joints.get(cur_joint)[3]);
 
     for (auto i = 0; i < depth; ++i) {
         auto joint = joints[depth-i];
 
         utility::re_transform::calculate_base_transforms(transform, cur_joint, known_joints);
 
-        auto original_pos = player_pos + (player_rot * known_joints[joint][3]);
+        auto original_pos = player_pos + (player_rot * known_joints.get(joint)[3]);
         const auto diff = original_pos - original_parent_pos;
         const auto updated_pos = parent_pos + diff;
         
@@ -331,7 +752,7 @@ Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* joint, uin
         parent_pos = updated_pos;
     }
 
-    const auto original_pos = player_pos + (player_rot * known_joints[joint][3]);
+    const auto original_pos = player_pos + (player_rot * known_joints.get(joint)[3]);
     const auto diff = original_pos - original_parent_pos;
 
     return parent_pos + diff;
@@ -364,7 +785,7 @@ void apply_joints_tpose(::RETransform& transform, const std::vector<REJoint*>& j
     std::vector<glm::quat> original_rotations(joints.size());
     std::vector<Vector3f> current_positions(joints.size());
 
-    std::unordered_map<REJoint*, glm::mat4> base_transforms{};
+    utility::re_transform::BaseTransforms base_transforms{};
 
     for (auto i = 0; i < joints.size(); i++) {
         auto joint = joints[i];
@@ -375,13 +796,7 @@ void apply_joints_tpose(::RETransform& transform, const std::vector<REJoint*>& j
 
         utility::re_transform::calculate_base_transforms(transform, joint, base_transforms);
 
-        auto it = base_transforms.find(joint);
-
-        if (it == base_transforms.end()) {
-            continue;
-        }
-
-        const auto& base_transform = it->second;
+        const auto& base_transform = base_transforms.get(joint);
 
         original_positions[i] = player_pos + (player_rot * base_transform[3]);
         original_rotations[i] = player_rot * glm::quat_cast(base_transform);
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <cstdint>
+#include <span>
+#include <string_view>
 
 #include "Math.hpp"
 #include "TDBVer.hpp"
@@ -57,45 +59,19 @@ namespace utility::re_transform {
 
     REJoint* get_joint(const ::RETransform& transform, uint32_t index);
 
-    // Get a bone/joint by name
-    static REJoint* get_joint(const ::RETransform& transform, std::wstring_view name) {
-#if TDB_VER < 69
-        auto& joint_array = transform.joints;
+    // Joint lookups through a per-transform name/hash -> index cache.
+    // The cache is rebuilt whenever the transform's joint array or joint count changes.
+    REJoint* find_joint(const ::RETransform& transform, std::wstring_view name);
+    REJoint* find_joint_by_hash(const ::RETransform& transform, uint32_t hash);
 
-        if (joint_array.size <= 0 || joint_array.numAllocated <= 0 || joint_array.data == nullptr || joint_array.matrices == nullptr) {
-            return nullptr;
-        }
-#endif
-
-#if TDB_VER < 69
-        for (int32_t i = 0; i < joint_array.size; ++i) {
-            auto joint = joint_array.data->joints[i];
-#else
-        if (transform.joints.data == nullptr) {
-            return nullptr;
-        }
-
-        for (int32_t i = 0; i < transform.joints.data->numElements; ++i) {
-
-            auto joint = utility::re_array::get_element<REJoint>(transform.joints.data, i);
-#endif
+    // Batch versions of the above, joints that don't exist are written as nullptr.
+    // Returns how many were found.
+    size_t resolve_joints(const ::RETransform& transform, std::span<const std::wstring_view> names, std::span<REJoint*> out);
+    size_t resolve_joints(const ::RETransform& transform, std::span<const uint32_t> hashes, std::span<REJoint*> out);
 
-            if (joint == nullptr) {
-                continue;
-            }
-
-            auto joint_info = joint->info;
-
-            if (joint_info == nullptr || joint_info->name == nullptr) {
-                continue;
-            }
-
-            if (name == joint_info->name) {
-                return joint;
-            }
-        }
-
-        return nullptr;
+    // Get a bone/joint by name
+    static REJoint* get_joint(const ::RETransform& transform, std::wstring_view name) {
+        return find_joint(transform, name);
     }
 
     static Matrix4x4f& get_joint_matrix_by_index(const ::RETransform& transform, uint32_t index) {
@@ -248,8 +224,41 @@ namespace utility::re_transform {
         return parents;
     }
 
+    // Base (bind) pose transforms relative to the transform, indexed by joint index.
+    struct BaseTransforms {
+        std::vector<glm::mat4> matrices{};
+        std::vector<uint8_t> computed{};
+
+        // Identity for null joints or ones that haven't been computed.
+        const glm::mat4& get(REJoint* joint) const;
+    };
+
     glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* target);
-    void calculate_base_transforms(const ::RETransform& transform, REJoint* target, std::unordered_map<REJoint*, glm::mat4>& out);
+    // Computes target and its parents, skipping the ones already in out.
+    void calculate_base_transforms(const ::RETransform& transform, REJoint* target, BaseTransforms& out);
+    // Computes every joint.
+    BaseTransforms calculate_base_transforms(const ::RETransform& transform);
+
+    // Structure of arrays pose buffers indexed by joint index. Empty spans are skipped,
+    // and only the joints that fit in a span are read or written through it.
+    struct JointPoseBuffers {
+        std::span<Vector4f> local_positions{};
+        std::span<glm::quat> local_rotations{};
+        std::span<Vector4f> world_positions{};
+        std::span<glm::quat> world_rotations{};
+    };
+
+    uint32_t get_joint_count(const ::RETransform& transform);
+
+    // Copies the pose out of the native joint storage in one pass. Returns the joint count.
+    uint32_t read_pose(const ::RETransform& transform, const JointPoseBuffers& out);
+
+    // Writes the pose straight into the joints' local positions and rotations. World values take precedence over local ones
+    // and are converted using the parent's (possibly just written) world transform, parent scale is ignored.
+    // mask selects the joints to write (non-zero), an empty mask writes all of them.
+    // The engine's setter is then called once per written subtree root so the joints get marked dirty.
+    // Returns how many joints were written.
+    uint32_t write_pose(::RETransform& transform, const JointPoseBuffers& in, std::span<const uint8_t> mask = {});
     Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* target, uint32_t depth=1);
     void apply_joints_tpose(::RETransform& transform, const std::vector<REJoint*>& joints, uint32_t additional_parents = 0);
 }
@@ -34,6 +34,7 @@ void REVTableHook::unhook() {
         spdlog::error("[REVTableHook] Could not unhook vtable, object may have been deallocated");
     }
 
+    utility::re_managed_object::unregister_known_info(m_new_object_info);
     m_hooked = false;
 }
 
@@ -127,6 +128,7 @@ bool REVTableHook::hook() {
     // Now replace the pointer.
     spdlog::info("[REVTableHook] Replacing vtable pointer in original object info...");
     m_new_object_info = &m_new_data[m_offset_from_object_info_base];
+    utility::re_managed_object::register_known_info(m_new_object_info);
     *(void**)m_object = m_new_object_info;
 
     spdlog::info("[REVTableHook] Hooked {:x}", (uintptr_t)m_object);
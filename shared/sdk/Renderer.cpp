@@ -3,10 +3,12 @@
 #include "Memory.hpp"
 #include <utility/Scan.hpp>
 #include <utility/Module.hpp>
+#include <utility/SnapshotBuffer.hpp>
 
 #include "Application.hpp"
 #include "RETypeDB.hpp"
 #include "SceneManager.hpp"
+#include "MathBatch.hpp"
 
 #include "Renderer.hpp"
 
@@ -668,7 +670,10 @@ sdk::renderer::layer::Output* get_output_layer() {
     return sdk::call_native_func<sdk::renderer::layer::Output*>(nullptr, renderer_t, "getOutputLayer", sdk::get_thread_context(), nullptr);
 }
 
-std::optional<Vector2f> world_to_screen(const Vector3f& world_pos) {
+namespace detail {
+utility::SnapshotBuffer<CameraSnapshot> camera_snapshots{};
+
+std::optional<Vector2f> world_to_screen_slow(const Vector3f& world_pos) {
     auto camera = sdk::get_primary_camera();
 
     if (camera == nullptr) {
@@ -719,6 +724,86 @@ std::optional<Vector2f> world_to_screen(const Vector3f& world_pos) {
 
     return Vector2f{screen_pos.x, screen_pos.y};
 }
+}
+
+void update_camera_snapshot() {
+    CameraSnapshot snapshot{};
+    snapshot.frame = detail::camera_snapshots.num_published() + 1;
+
+    auto camera = sdk::get_primary_camera();
+    auto main_view = sdk::get_main_view();
+
+    if (camera == nullptr || main_view == nullptr) {
+        detail::camera_snapshots.publish(snapshot);
+        return;
+    }
+
+    auto context = sdk::get_thread_context();
+
+    static auto transform_def = sdk::find_type_definition("via.Transform");
+    static auto get_gameobject_method = transform_def->get_method("get_GameObject");
+    static auto get_axisz_method = transform_def->get_method("get_AxisZ");
+
+    auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
+
+    if (camera_gameobject == nullptr || camera_gameobject->transform == nullptr) {
+        detail::camera_snapshots.publish(snapshot);
+        return;
+    }
+
+    auto camera_transform = camera_gameobject->transform;
+
+    float screen_size[2]{};
+
+    snapshot.origin = sdk::get_transform_position(camera_transform);
+    get_axisz_method->call<void*>(&snapshot.forward, context, camera_transform);
+
+    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &snapshot.proj, context, camera);
+    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &snapshot.view, context, camera);
+    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+
+    snapshot.view_proj = snapshot.proj * snapshot.view;
+    snapshot.screen_size = Vector2f{screen_size[0], screen_size[1]};
+    snapshot.valid = true;
+
+    detail::camera_snapshots.publish(snapshot);
+}
+
+CameraSnapshot get_camera_snapshot() {
+    return detail::camera_snapshots.get();
+}
+
+std::optional<Vector2f> world_to_screen(const Vector3f& world_pos) {
+    const auto snapshot = get_camera_snapshot();
+
+    // Nothing captured yet (or no camera last frame), ask the game directly.
+    if (!snapshot.valid) {
+        return detail::world_to_screen_slow(world_pos);
+    }
+
+    const Vector4f pos{world_pos, 1.0f};
+    Vector2f screen_pos{};
+    uint8_t visible{0};
+
+    utility::math::batch::project_to_screen({&pos, 1}, snapshot.view_proj, snapshot.screen_size, false, {&screen_pos, 1}, {&visible, 1});
+
+    if (visible == 0) {
+        return std::nullopt;
+    }
+
+    return screen_pos;
+}
+
+size_t world_to_screen(std::span<const Vector4f> world_positions, std::span<Vector2f> out, std::span<uint8_t> visible, bool cull_offscreen) {
+    const auto snapshot = get_camera_snapshot();
+
+    if (!snapshot.valid) {
+        std::fill(visible.begin(), visible.end(), (uint8_t)0);
+        return 0;
+    }
+
+    return utility::math::batch::project_to_screen(world_positions, snapshot.view_proj, snapshot.screen_size, cull_offscreen, out, visible);
+}
 
 /*
 - 0x4B VortexelTurbulenceGPU::VelocitiesX
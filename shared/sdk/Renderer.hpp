@@ -3,9 +3,11 @@
 #include <cstdint>
 #include <tuple>
 #include <optional>
+#include <span>
 
 #include "ReClass.hpp"
 #include "RENativeArray.hpp"
+#include "renderer/CameraSnapshot.hpp"
 #include "renderer/RenderResource.hpp"
 
 class REType;
@@ -442,8 +444,15 @@ RenderLayer* find_layer(::REType* layer_type);
 
 sdk::renderer::layer::Output* get_output_layer();
 
+void update_camera_snapshot();
+CameraSnapshot get_camera_snapshot();
+
 std::optional<Vector2f> world_to_screen(const Vector3f& world_pos);
 
+// Batched version using the camera snapshot. visible[i] is 0 for points behind the camera
+// and, with cull_offscreen, for points outside the view. Returns the number of visible points.
+size_t world_to_screen(std::span<const Vector4f> world_positions, std::span<Vector2f> out, std::span<uint8_t> visible, bool cull_offscreen = false);
+
 ConstantBuffer* create_constant_buffer(void* desc);
 TargetState* create_target_state(TargetState::Desc* desc);
 Texture* create_texture(void* desc);
@@ -0,0 +1,252 @@
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+#include <utility/PointerMap.hpp>
+
+#include "ReClass.hpp"
+#include "REManagedObject.hpp"
+#include "REComponent.hpp"
+#include "RETypeDB.hpp"
+#include "SceneManager.hpp"
+#include "SpatialGrid.hpp"
+
+#include "SceneIndex.hpp"
+
+namespace sdk {
+namespace scene_index {
+namespace detail {
+// Guards against walking a corrupted list forever.
+constexpr size_t MAX_TRANSFORMS = 1 << 20;
+constexpr uint64_t IDLE_FRAMES = 120;
+constexpr float CELL_SIZE = 8.0f;
+
+struct Record {
+    ::RETransform* transform{nullptr};
+    ::REGameObject* owner{nullptr};
+    uint64_t last_seen{0};
+};
+
+struct Visited {
+    ::RETransform* transform{nullptr};
+    ::REGameObject* owner{nullptr};
+    Vector3f position{};
+};
+
+std::shared_mutex mtx{};
+utility::math::SpatialGrid grid{CELL_SIZE};
+utility::PointerMap<uint32_t> ids{}; // transform -> grid id
+std::vector<Record> records{};       // indexed by grid id
+
+std::vector<::REType*> tag_types{};
+std::unordered_map<std::string, uint64_t> tags_by_name{};
+bool needs_retag{false};
+
+std::atomic<uint64_t> frame{0};
+std::atomic<uint64_t> last_query_frame{0};
+std::atomic<bool> dropped{false};
+
+// Serializes refresh() between update() and a query rebuilding a dropped index.
+std::mutex refresh_mtx{};
+std::vector<Visited> visited{}; // guarded by refresh_mtx
+
+uint64_t compute_tags(::RETransform* transform) {
+    uint64_t tags{0};
+
+    for (size_t i = 0; i < tag_types.size(); ++i) {
+        const auto t = tag_types[i];
+
+        if (utility::re_managed_object::is_a(transform, t) || utility::re_component::find(transform, t) != nullptr) {
+            tags |= 1ull << i;
+        }
+    }
+
+    return tags;
+}
+
+void clear() {
+    grid.clear();
+    ids.clear();
+    records.clear();
+}
+
+std::vector<Object> to_objects(const std::vector<uint32_t>& found) {
+    std::vector<Object> out{};
+    out.reserve(found.size());
+
+    for (const auto id : found) {
+        const auto& record = records[id];
+        out.push_back(Object{record.transform, record.owner, grid.get_position(id), grid.get_tags(id)});
+    }
+
+    return out;
+}
+
+// Walks the current scene's transform list and applies it to the grid.
+// Caller holds refresh_mtx.
+void refresh(uint64_t frame) {
+    visited.clear();
+
+    auto scene = sdk::get_current_scene();
+
+    if (scene != nullptr) {
+        static auto scene_def = sdk::find_type_definition("via.Scene");
+        auto first_transform = sdk::call_native_func_easy<::RETransform*>(scene, scene_def, "get_FirstTransform");
+
+        // Walk the list outside of the lock, queries only have to wait for the grid update.
+        for (auto transform = first_transform;
+            transform != nullptr && visited.size() < MAX_TRANSFORMS;
+            transform = transform->next)
+        {
+            if (transform->ownerGameObject == nullptr) {
+                continue;
+            }
+
+            visited.push_back({transform, transform->ownerGameObject, Vector3f{transform->worldTransform[3]}});
+        }
+    }
+
+    std::unique_lock _{mtx};
+
+    const auto retag = needs_retag;
+    needs_retag = false;
+
+    for (const auto& v : visited) {
+        auto existing = ids.find(v.transform);
+
+        if (existing != nullptr) {
+            const auto id = *existing;
+            auto& record = records[id];
+
+            grid.update(id, v.position);
+
+            // Same address but a different object, the transform was freed and reallocated.
+            if (retag || record.owner != v.owner) {
+                record.owner = v.owner;
+                grid.set_tags(id, compute_tags(v.transform));
+            }
+
+            record.last_seen = frame;
+            continue;
+        }
+
+        const auto id = grid.insert(v.position, compute_tags(v.transform));
+
+        if (id >= records.size()) {
+            records.resize(id + 1);
+        }
+
+        records[id] = Record{v.transform, v.owner, frame};
+        ids[v.transform] = id;
+    }
+
+    for (uint32_t id = 0; id < records.size(); ++id) {
+        auto& record = records[id];
+
+        if (record.transform == nullptr || record.last_seen == frame) {
+            continue;
+        }
+
+        grid.remove(id);
+        ids.erase(record.transform);
+        record = Record{};
+    }
+
+    dropped = false;
+}
+
+template <typename F>
+std::vector<Object> query(F&& f) {
+    const auto current_frame = frame.load();
+    last_query_frame = current_frame;
+
+    // Dropped while nobody was asking, rebuild it now rather than answering with nothing.
+    if (dropped) {
+        std::scoped_lock _{refresh_mtx};
+
+        if (dropped) {
+            spdlog::info("[SceneIndex] Queried after being dropped, rebuilding index");
+            refresh(current_frame);
+        }
+    }
+
+    std::vector<uint32_t> found{};
+    std::shared_lock _{mtx};
+
+    f(found);
+
+    return to_objects(found);
+}
+}
+
+void update() {
+    const auto frame = ++detail::frame;
+
+    std::scoped_lock _{detail::refresh_mtx};
+
+    if (frame - detail::last_query_frame.load() > detail::IDLE_FRAMES) {
+        std::unique_lock _{detail::mtx};
+
+        if (detail::grid.size() > 0) {
+            spdlog::info("[SceneIndex] Not queried for {} frames, dropping index", detail::IDLE_FRAMES);
+            detail::clear();
+        }
+
+        detail::dropped = true;
+        return;
+    }
+
+    detail::refresh(frame);
+}
+
+uint64_t get_tag(std::string_view type_name) {
+    std::unique_lock _{detail::mtx};
+
+    const auto name = std::string{type_name};
+
+    if (auto it = detail::tags_by_name.find(name); it != detail::tags_by_name.end()) {
+        return it->second;
+    }
+
+    auto tdef = sdk::find_type_definition(type_name);
+
+    if (tdef == nullptr || tdef->get_type() == nullptr || detail::tag_types.size() >= 64) {
+        return 0;
+    }
+
+    const auto tag = 1ull << detail::tag_types.size();
+
+    detail::tag_types.push_back(tdef->get_type());
+    detail::tags_by_name[name] = tag;
+    detail::needs_retag = true;
+
+    return tag;
+}
+
+std::vector<Object> find_near(const Vector3f& center, float radius, uint64_t tag_mask) {
+    return detail::query([&](std::vector<uint32_t>& found) {
+        detail::grid.query_radius(center, radius, tag_mask, found);
+    });
+}
+
+std::vector<Object> find_in_frustum(const Matrix4x4f& view_proj, uint64_t tag_mask) {
+    return detail::query([&](std::vector<uint32_t>& found) {
+        detail::grid.query_frustum(view_proj, tag_mask, found);
+    });
+}
+
+std::vector<Object> find_nearest(const Vector3f& center, size_t k, float max_radius, uint64_t tag_mask) {
+    return detail::query([&](std::vector<uint32_t>& found) {
+        detail::grid.query_nearest(center, k, max_radius, tag_mask, found);
+    });
+}
+
+size_t size() {
+    std::shared_lock _{detail::mtx};
+    return detail::grid.size();
+}
+}
+}
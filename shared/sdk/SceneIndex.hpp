@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cfloat>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Math.hpp"
+
+class RETransform;
+class REGameObject;
+
+namespace sdk {
+namespace scene_index {
+// Objects are only guaranteed to be alive for the frame they were returned in.
+struct Object {
+    ::RETransform* transform{nullptr};
+    ::REGameObject* owner{nullptr};
+    Vector3f position{};
+    uint64_t tags{0};
+};
+
+// Walks the current scene's transform list with direct field reads and updates the
+// spatial index. Called once per frame at BeginRendering.
+// The index is dropped while nothing queries it, the first query after that
+// rebuilds it before answering.
+void update();
+
+// Tag bit for objects with a component of the given type.
+// Returns 0 if the type doesn't exist or all 64 tags are taken. New tags are applied on the next update.
+uint64_t get_tag(std::string_view type_name);
+
+// Tag masks match objects sharing any bit with them, 0 matches everything.
+std::vector<Object> find_near(const Vector3f& center, float radius, uint64_t tag_mask = 0);
+std::vector<Object> find_in_frustum(const Matrix4x4f& view_proj, uint64_t tag_mask = 0);
+// Up to k objects, closest first.
+std::vector<Object> find_nearest(const Vector3f& center, size_t k, float max_radius = FLT_MAX, uint64_t tag_mask = 0);
+
+size_t size();
+}
+}
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cmath>
+
+#include "SpatialGrid.hpp"
+
+namespace utility::math {
+namespace detail {
+// 21 bits per axis, which is plenty for any sane cell size.
+constexpr int32_t COORD_BITS = 21;
+constexpr int32_t COORD_BIAS = 1 << (COORD_BITS - 1);
+constexpr int32_t COORD_MIN = -COORD_BIAS;
+constexpr int32_t COORD_MAX = COORD_BIAS - 1;
+constexpr uint64_t COORD_MASK = (1ull << COORD_BITS) - 1;
+
+// Gribb-Hartmann plane extraction, normalized. Same planes batch::frustum_cull uses.
+void extract_planes(const Matrix4x4f& view_proj, Vector4f (&planes)[6]) {
+    const auto row = [&](int r) {
+        return Vector4f{view_proj[0][r], view_proj[1][r], view_proj[2][r], view_proj[3][r]};
+    };
+
+    planes[0] = row(3) + row(0);
+    planes[1] = row(3) - row(0);
+    planes[2] = row(3) + row(1);
+    planes[3] = row(3) - row(1);
+    planes[4] = row(2);
+    planes[5] = row(3) - row(2);
+
+    for (auto& plane : planes) {
+        const auto len = glm::length(Vector3f{plane});
+
+        if (len > 0.0f) {
+            plane /= len;
+        }
+    }
+}
+}
+
+SpatialGrid::SpatialGrid(float cell_size)
+    : m_cell_size{std::max(cell_size, 0.001f)},
+    m_inv_cell_size{1.0f / std::max(cell_size, 0.001f)}
+{
+}
+
+SpatialGrid::CellCoord SpatialGrid::coord_of(const Vector3f& position) const {
+    const auto to_coord = [&](float v) {
+        const auto c = std::floor(v * m_inv_cell_size);
+
+        // Also catches NaN, which would otherwise be UB to convert.
+        if (!(c >= (float)detail::COORD_MIN)) {
+            return detail::COORD_MIN;
+        }
+
+        if (c > (float)detail::COORD_MAX) {
+            return detail::COORD_MAX;
+        }
+
+        return (int32_t)c;
+    };
+
+    return CellCoord{to_coord(position.x), to_coord(position.y), to_coord(position.z)};
+}
+
+uint64_t SpatialGrid::key_of(const CellCoord& c) {
+    const auto pack = [](int32_t v) { return (uint64_t)(v + detail::COORD_BIAS) & detail::COORD_MASK; };
+
+    return pack(c.x) | (pack(c.y) << detail::COORD_BITS) | (pack(c.z) << (detail::COORD_BITS * 2));
+}
+
+SpatialGrid::CellCoord SpatialGrid::coord_of_key(uint64_t key) {
+    const auto unpack = [&](int shift) { return (int32_t)((key >> shift) & detail::COORD_MASK) - detail::COORD_BIAS; };
+
+    return CellCoord{unpack(0), unpack(detail::COORD_BITS), unpack(detail::COORD_BITS * 2)};
+}
+
+void SpatialGrid::add_to_cell(uint32_t id, uint64_t cell) {
+    auto& ids = m_cells[cell];
+    auto& item = m_items[id];
+
+    item.cell = cell;
+    item.slot = (uint32_t)ids.size();
+    ids.push_back(id);
+}
+
+void SpatialGrid::remove_from_cell(uint32_t id) {
+    auto& item = m_items[id];
+    auto it = m_cells.find(item.cell);
+
+    if (it == m_cells.end()) {
+        item.cell = INVALID_CELL;
+        return;
+    }
+
+    auto& ids = it->second;
+
+    // Swap remove, the moved item needs to know its new slot.
+    const auto last = ids.back();
+    ids[item.slot] = last;
+    m_items[last].slot = item.slot;
+    ids.pop_back();
+
+    if (ids.empty()) {
+        m_cells.erase(it);
+    }
+
+    item.cell = INVALID_CELL;
+}
+
+uint32_t SpatialGrid::insert(const Vector3f& position, uint64_t tags) {
+    uint32_t id{};
+
+    if (!m_free_ids.empty()) {
+        id = m_free_ids.back();
+        m_free_ids.pop_back();
+    } else {
+        id = (uint32_t)m_items.size();
+        m_items.emplace_back();
+    }
+
+    m_items[id].position = position;
+    m_items[id].tags = tags;
+    add_to_cell(id, key_of(coord_of(position)));
+    ++m_size;
+
+    return id;
+}
+
+void SpatialGrid::update(uint32_t id, const Vector3f& position) {
+    if (!is_valid(id)) {
+        return;
+    }
+
+    auto& item = m_items[id];
+    item.position = position;
+
+    const auto cell = key_of(coord_of(position));
+
+    if (cell != item.cell) {
+        remove_from_cell(id);
+        add_to_cell(id, cell);
+    }
+}
+
+void SpatialGrid::set_tags(uint32_t id, uint64_t tags) {
+    if (is_valid(id)) {
+        m_items[id].tags = tags;
+    }
+}
+
+void SpatialGrid::remove(uint32_t id) {
+    if (!is_valid(id)) {
+        return;
+    }
+
+    remove_from_cell(id);
+    m_free_ids.push_back(id);
+    --m_size;
+}
+
+void SpatialGrid::clear() {
+    m_items.clear();
+    m_free_ids.clear();
+    m_cells.clear();
+    m_size = 0;
+}
+
+void SpatialGrid::query_radius(const Vector3f& center, float radius, uint64_t tag_mask, std::vector<uint32_t>& out) const {
+    if (m_size == 0 || !(radius >= 0.0f)) {
+        return;
+    }
+
+    const auto radius2 = radius * radius;
+    const auto lo = coord_of(center - Vector3f{radius});
+    const auto hi = coord_of(center + Vector3f{radius});
+
+    const auto visit = [&](const std::vector<uint32_t>& ids) {
+        for (const auto id : ids) {
+            const auto& item = m_items[id];
+
+            if (matches(item.tags, tag_mask) && glm::dot(item.position - center, item.position - center) <= radius2) {
+                out.push_back(id);
+            }
+        }
+    };
+
+    const auto span_cells = (uint64_t)(hi.x - lo.x + 1) * (uint64_t)(hi.y - lo.y + 1) * (uint64_t)(hi.z - lo.z + 1);
+
+    // Huge radius compared to the cell size, cheaper to look at the occupied cells only.
+    if (span_cells > m_cells.size()) {
+        for (const auto& [key, ids] : m_cells) {
+            const auto c = coord_of_key(key);
+
+            if (c.x < lo.x || c.x > hi.x || c.y < lo.y || c.y > hi.y || c.z < lo.z || c.z > hi.z) {
+                continue;
+            }
+
+            visit(ids);
+        }
+
+        return;
+    }
+
+    for (auto z = lo.z; z <= hi.z; ++z) {
+        for (auto y = lo.y; y <= hi.y; ++y) {
+            for (auto x = lo.x; x <= hi.x; ++x) {
+                const auto it = m_cells.find(key_of(CellCoord{x, y, z}));
+
+                if (it != m_cells.end()) {
+                    visit(it->second);
+                }
+            }
+        }
+    }
+}
+
+void SpatialGrid::query_frustum(const Matrix4x4f& view_proj, uint64_t tag_mask, std::vector<uint32_t>& out) const {
+    Vector4f planes[6]{};
+    detail::extract_planes(view_proj, planes);
+
+    // Branchless, points are usually spread evenly enough that an early out mispredicts a lot.
+    const auto point_inside = [&](const Vector3f& position) {
+        auto inside = true;
+
+        for (const auto& plane : planes) {
+            inside &= glm::dot(Vector3f{plane}, position) + plane.w >= 0.0f;
+        }
+
+        return inside;
+    };
+
+    // With about one item per cell, culling cells costs more than testing the items directly.
+    if (m_cells.size() * 2 > m_size) {
+        for (uint32_t id = 0; id < m_items.size(); ++id) {
+            const auto& item = m_items[id];
+
+            if (item.cell != INVALID_CELL && matches(item.tags, tag_mask) && point_inside(item.position)) {
+                out.push_back(id);
+            }
+        }
+
+        return;
+    }
+
+    for (const auto& [key, ids] : m_cells) {
+        const auto c = coord_of_key(key);
+        const auto box_min = Vector3f{(float)c.x, (float)c.y, (float)c.z} * m_cell_size;
+        const auto box_max = box_min + Vector3f{m_cell_size};
+
+        bool outside = false;
+        bool fully_inside = true;
+
+        for (const auto& plane : planes) {
+            // Corner furthest along the plane normal, and the one opposite of it.
+            const auto p = Vector3f{
+                plane.x >= 0.0f ? box_max.x : box_min.x,
+                plane.y >= 0.0f ? box_max.y : box_min.y,
+                plane.z >= 0.0f ? box_max.z : box_min.z,
+            };
+            const auto n = box_min + box_max - p;
+
+            if (glm::dot(Vector3f{plane}, p) + plane.w < 0.0f) {
+                outside = true;
+                break;
+            }
+
+            if (glm::dot(Vector3f{plane}, n) + plane.w < 0.0f) {
+                fully_inside = false;
+            }
+        }
+
+        if (outside) {
+            continue;
+        }
+
+        for (const auto id : ids) {
+            const auto& item = m_items[id];
+
+            if (!matches(item.tags, tag_mask)) {
+                continue;
+            }
+
+            if (!fully_inside && !point_inside(item.position)) {
+                continue;
+            }
+
+            out.push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::query_nearest(const Vector3f& center, size_t k, float max_radius, uint64_t tag_mask, std::vector<uint32_t>& out) const {
+    if (k == 0 || m_size == 0 || !(max_radius >= 0.0f)) {
+        return;
+    }
+
+    std::vector<uint32_t> candidates{};
+    auto radius = std::min(m_cell_size, max_radius);
+
+    // Everything within radius is found on every pass, so once there are
+    // k candidates the k nearest overall are among them.
+    for (;;) {
+        candidates.clear();
+        query_radius(center, radius, tag_mask, candidates);
+
+        if (candidates.size() >= k || radius >= max_radius) {
+            break;
+        }
+
+        radius = std::min(radius * 2.0f, max_radius);
+    }
+
+    const auto distance2 = [&](uint32_t id) {
+        const auto delta = m_items[id].position - center;
+        return glm::dot(delta, delta);
+    };
+
+    const auto count = std::min(k, candidates.size());
+
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), [&](uint32_t a, uint32_t b) {
+        return distance2(a) < distance2(b);
+    });
+
+    out.insert(out.end(), candidates.begin(), candidates.begin() + count);
+}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Math.hpp"
+
+namespace utility::math {
+// Sparse uniform grid of points, hashed by cell so there are no world bounds.
+// Items get a dense id on insertion which stays valid until they're removed.
+// Moving an item only touches the grid when it crosses into another cell.
+// Every item carries a 64 bit tag mask, queries with a non-zero mask only return
+// items sharing at least one bit with it. Not thread safe.
+class SpatialGrid {
+public:
+    static constexpr uint32_t INVALID_ID = ~0u;
+
+    SpatialGrid(float cell_size = 8.0f);
+
+    uint32_t insert(const Vector3f& position, uint64_t tags = 0);
+    void update(uint32_t id, const Vector3f& position);
+    void set_tags(uint32_t id, uint64_t tags);
+    void remove(uint32_t id);
+    void clear();
+
+    // Results are appended to out, unsorted.
+    void query_radius(const Vector3f& center, float radius, uint64_t tag_mask, std::vector<uint32_t>& out) const;
+    // D3D style (0 <= z <= w) view projection, same as batch::frustum_cull.
+    void query_frustum(const Matrix4x4f& view_proj, uint64_t tag_mask, std::vector<uint32_t>& out) const;
+    // Up to k items sorted by distance, only looking as far as max_radius.
+    void query_nearest(const Vector3f& center, size_t k, float max_radius, uint64_t tag_mask, std::vector<uint32_t>& out) const;
+
+    const Vector3f& get_position(uint32_t id) const { return m_items[id].position; }
+    uint64_t get_tags(uint32_t id) const { return m_items[id].tags; }
+    bool is_valid(uint32_t id) const { return id < m_items.size() && m_items[id].cell != INVALID_CELL; }
+
+    size_t size() const { return m_size; }
+    size_t num_cells() const { return m_cells.size(); }
+    float get_cell_size() const { return m_cell_size; }
+
+private:
+    static constexpr uint64_t INVALID_CELL = ~0ull;
+
+    struct Item {
+        Vector3f position{};
+        uint64_t tags{0};
+        uint64_t cell{INVALID_CELL};
+        uint32_t slot{0}; // index into the cell's id list
+    };
+
+    struct CellCoord {
+        int32_t x, y, z;
+    };
+
+    CellCoord coord_of(const Vector3f& position) const;
+    static uint64_t key_of(const CellCoord& c);
+    static CellCoord coord_of_key(uint64_t key);
+
+    void add_to_cell(uint32_t id, uint64_t cell);
+    void remove_from_cell(uint32_t id);
+
+    static bool matches(uint64_t tags, uint64_t tag_mask) {
+        return tag_mask == 0 || (tags & tag_mask) != 0;
+    }
+
+    float m_cell_size{8.0f};
+    float m_inv_cell_size{1.0f / 8.0f};
+
+    std::vector<Item> m_items{};
+    std::vector<uint32_t> m_free_ids{};
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells{};
+    size_t m_size{0};
+};
+}
@@ -1,4 +1,5 @@
 #include "RETypeDB.hpp"
+#include "REArray.hpp"
 
 #include "SystemArray.hpp"
 
@@ -10,10 +11,19 @@ size_t sdk::SystemArray::get_size() {
 }
 
 ::REManagedObject* sdk::SystemArray::get_element(int32_t index) {
-    if (index < 0 || index >= get_size()) {
+    // Reference arrays hold the object pointers directly, no need to go through the VM.
+    if (!has_inline_elements()) {
+        const auto elements = view<::REManagedObject*>();
+        const auto element = elements.at(index);
+
+        return element != nullptr ? *element : nullptr;
+    }
+
+    if (index < 0 || index >= get_num_elements()) {
         return nullptr;
     }
 
+    // Value types get boxed by GetValue.
     static auto system_array_type = sdk::find_type_definition("System.Array");
     static auto get_element_method = system_array_type->get_method("GetValue(System.Int32)");
 
@@ -21,7 +31,7 @@ size_t sdk::SystemArray::get_size() {
 }
 
 void sdk::SystemArray::set_element(int32_t index, ::REManagedObject* value) {
-    if (index < 0 || index >= get_size()) {
+    if (index < 0 || index >= get_num_elements()) {
         throw std::out_of_range("index out of range");
     }
 
@@ -32,8 +42,15 @@ void sdk::SystemArray::set_element(int32_t index, ::REManagedObject* value) {
 }
 
 std::vector<::REManagedObject*> sdk::SystemArray::get_elements() {
+    if (!has_inline_elements()) {
+        const auto elements = view<::REManagedObject*>();
+        return std::vector<::REManagedObject*>{elements.begin(), elements.end()};
+    }
+
     std::vector<::REManagedObject*> elements{};
-    const auto size = get_size();
+    const auto size = get_num_elements();
+
+    elements.reserve(size);
 
     for (size_t i = 0; i < size; i++) {
         elements.push_back(get_element(i));
@@ -42,3 +59,31 @@ std::vector<::REManagedObject*> sdk::SystemArray::get_elements() {
     return elements;
 }
 
+size_t sdk::SystemArray::get_num_elements() {
+    const auto num_elements = ((::REArrayBase*)this)->numElements;
+
+    return num_elements > 0 ? (size_t)num_elements : 0;
+}
+
+sdk::RETypeDefinition* sdk::SystemArray::get_contained_type() {
+    return utility::re_array::get_contained_type((::REArrayBase*)this);
+}
+
+bool sdk::SystemArray::has_inline_elements() {
+    return utility::re_array::has_inline_elements((::REArrayBase*)this);
+}
+
+uint32_t sdk::SystemArray::get_element_stride() {
+    return utility::re_array::get_element_size((::REArrayBase*)this);
+}
+
+void* sdk::SystemArray::get_data() {
+    const auto field_ptr = utility::re_managed_object::get_field_ptr((::REManagedObject*)this);
+
+    if (field_ptr == nullptr) {
+        return nullptr;
+    }
+
+    // Same layout utility::re_array uses for element access.
+    return (void*)((uintptr_t)((::REArrayBase*)field_ptr + 1) - sizeof(::REManagedObject));
+}
@@ -4,12 +4,16 @@ struct SystemArray;
 
 #pragma once
 
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 #include "REManagedObject.hpp"
 
 namespace sdk {
 struct SystemArray;
+struct RETypeDefinition;
 
 struct SystemArray : public ::REManagedObject {
     size_t get_size();
@@ -17,6 +21,115 @@ struct SystemArray : public ::REManagedObject {
     void set_element(int32_t index, ::REManagedObject* value);
     std::vector<::REManagedObject*> get_elements();
 
+    // These read the array header directly instead of going through the VM.
+    size_t get_num_elements();
+    sdk::RETypeDefinition* get_contained_type();
+    bool has_inline_elements(); // value type elements stored in the array itself
+    uint32_t get_element_stride();
+    void* get_data();
+
+    // Typed view over the element storage, reads and writes go straight to memory.
+    // T must be ::REManagedObject* for arrays of references, or a type no larger than
+    // the element stride for arrays of value types.
+    template <typename T>
+    class View {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using pointer = T*;
+
+            iterator(uint8_t* ptr, size_t stride)
+                : m_ptr{ptr},
+                m_stride{stride}
+            {
+            }
+
+            reference operator*() const { return *(T*)m_ptr; }
+            pointer operator->() const { return (T*)m_ptr; }
+            reference operator[](difference_type n) const { return *(T*)(m_ptr + n * m_stride); }
+
+            iterator& operator++() { m_ptr += m_stride; return *this; }
+            iterator& operator--() { m_ptr -= m_stride; return *this; }
+            iterator operator++(int) { auto out = *this; m_ptr += m_stride; return out; }
+            iterator operator--(int) { auto out = *this; m_ptr -= m_stride; return out; }
+            iterator& operator+=(difference_type n) { m_ptr += n * m_stride; return *this; }
+            iterator& operator-=(difference_type n) { m_ptr -= n * m_stride; return *this; }
+            iterator operator+(difference_type n) const { return iterator{m_ptr + n * m_stride, m_stride}; }
+            iterator operator-(difference_type n) const { return iterator{m_ptr - n * m_stride, m_stride}; }
+            difference_type operator-(const iterator& other) const { return (m_ptr - other.m_ptr) / (difference_type)m_stride; }
+
+            bool operator==(const iterator& other) const { return m_ptr == other.m_ptr; }
+            bool operator!=(const iterator& other) const { return m_ptr != other.m_ptr; }
+            bool operator<(const iterator& other) const { return m_ptr < other.m_ptr; }
+
+        private:
+            uint8_t* m_ptr{};
+            size_t m_stride{};
+        };
+
+        View() = default;
+        View(void* data, size_t size, size_t stride)
+            : m_data{(uint8_t*)data},
+            m_size{size},
+            m_stride{stride}
+        {
+        }
+
+        T& operator[](size_t index) const { return *(T*)(m_data + index * m_stride); }
+
+        T* at(size_t index) const {
+            if (index >= m_size) {
+                return nullptr;
+            }
+
+            return (T*)(m_data + index * m_stride);
+        }
+
+        iterator begin() const { return iterator{m_data, m_stride}; }
+        iterator end() const { return iterator{m_data + m_size * m_stride, m_stride}; }
+
+        size_t size() const { return m_size; }
+        size_t stride() const { return m_stride; }
+        bool empty() const { return m_size == 0; }
+
+        // Elements are tightly packed, so data() can be treated as a plain T array.
+        bool is_contiguous() const { return m_stride == sizeof(T); }
+        T* data() const { return (T*)m_data; }
+
+    private:
+        uint8_t* m_data{nullptr};
+        size_t m_size{0};
+        size_t m_stride{sizeof(T)};
+    };
+
+    // Returns an empty view if T doesn't fit the element layout.
+    template <typename T>
+    View<T> view() {
+        const auto data = get_data();
+
+        if (data == nullptr) {
+            return {};
+        }
+
+        const auto inline_elements = has_inline_elements();
+
+        if constexpr (std::is_pointer_v<T>) {
+            if (inline_elements) {
+                return {};
+            }
+        } else {
+            if (!inline_elements || sizeof(T) > get_element_stride()) {
+                return {};
+            }
+        }
+
+        return View<T>{data, get_num_elements(), inline_elements ? get_element_stride() : sizeof(void*)};
+    }
+
     using size_type = size_t;
     using value_type = ::REManagedObject*;
 
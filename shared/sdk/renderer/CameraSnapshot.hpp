@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../Math.hpp"
+
+namespace sdk {
+namespace renderer {
+// Camera state captured once per frame at BeginRendering, so projecting points
+// doesn't need to go through the VM for every single one of them.
+struct CameraSnapshot {
+    Matrix4x4f view{};
+    Matrix4x4f proj{};
+    Matrix4x4f view_proj{};
+    Vector4f origin{};
+    Vector4f forward{};
+    Vector2f screen_size{};
+    uint64_t frame{0};
+    bool valid{false};
+};
+}
+}
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cstdio>
+#include <cinttypes>
+#endif
+
+#include "MemoryRegions.hpp"
+
+namespace utility::memory_regions {
+namespace detail {
+// How long a readable image region is trusted before it gets queried again,
+// in case a module gets unloaded without anyone calling invalidate().
+constexpr auto MAX_AGE = std::chrono::milliseconds{250};
+
+struct CachedRegion {
+    Region region{};
+    uint32_t generation{};
+    std::chrono::steady_clock::time_point queried_at{};
+};
+
+std::shared_mutex mtx{};
+std::vector<CachedRegion> regions{}; // sorted by start, never overlapping
+std::atomic<uint32_t> current_generation{0};
+std::atomic<uint64_t> os_queries{0};
+
+bool is_fresh(const CachedRegion& cached, std::chrono::steady_clock::time_point now) {
+    return cached.generation == current_generation.load(std::memory_order_relaxed) && now - cached.queried_at < MAX_AGE;
+}
+
+// First cached region with end > address, caller checks if it actually contains it.
+std::vector<CachedRegion>::iterator find(uintptr_t address) {
+    return std::upper_bound(regions.begin(), regions.end(), address, [](uintptr_t addr, const CachedRegion& r) {
+        return addr < r.region.end;
+    });
+}
+
+// Caller must hold the unique lock.
+void insert(const Region& region, std::chrono::steady_clock::time_point now) {
+    // Drop anything overlapping, the OS view is authoritative. Regions that aren't images
+    // still get here so they can evict an image region that has been unloaded in the meantime.
+    auto first = find(region.start);
+    auto last = first;
+
+    while (last != regions.end() && last->region.start < region.end) {
+        ++last;
+    }
+
+    first = regions.erase(first, last);
+
+    if (region.access != NONE && region.image) {
+        regions.insert(first, CachedRegion{region, current_generation.load(), now});
+    }
+}
+
+bool satisfies(const Region& region, bool write) {
+    const uint32_t wanted = write ? (READ | WRITE) : READ;
+    return (region.access & wanted) == wanted;
+}
+
+// Returns the end of the accessible region containing address, or 0 if it's not accessible.
+uintptr_t lookup(uintptr_t address, bool write, std::chrono::steady_clock::time_point now) {
+    // The uncached gap around address as seen under the lock. A region from the OS that stays inside
+    // it can't be replacing a cached image region, so heap probes never have to lock again.
+    uintptr_t gap_start{0};
+    uintptr_t gap_end{UINTPTR_MAX};
+
+    {
+        std::shared_lock _{mtx};
+
+        const auto it = find(address);
+
+        if (it != regions.end() && it->region.start <= address) {
+            if (is_fresh(*it, now) && satisfies(it->region, write)) {
+                return it->region.end;
+            }
+
+            // Stale or not enough access (the protection may have changed since), whatever the OS says replaces it.
+            gap_start = gap_end = address;
+        } else {
+            if (it != regions.end()) {
+                gap_end = it->region.start;
+            }
+
+            if (it != regions.begin()) {
+                gap_start = std::prev(it)->region.end;
+            }
+        }
+    }
+
+    const auto region = os::query(address);
+    os_queries.fetch_add(1, std::memory_order_relaxed);
+
+    if (!region) {
+        return 0;
+    }
+
+    // Heap memory never gets cached, only take the unique lock for images and for
+    // regions that replace a stale image region.
+    if (region->image || region->start < gap_start || region->end > gap_end) {
+        std::unique_lock _{mtx};
+        insert(*region, now);
+    }
+
+    return satisfies(*region, write) ? region->end : 0;
+}
+}
+
+bool is_accessible(const void* ptr, size_t size, bool write) {
+    if (size == 0) {
+        return true;
+    }
+
+    if (ptr == nullptr) {
+        return false;
+    }
+
+    const auto start = (uintptr_t)ptr;
+    const auto end = start + size;
+
+    if (end < start) {
+        return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    for (auto p = start; p < end;) {
+        const auto region_end = detail::lookup(p, write, now);
+
+        if (region_end == 0) {
+            return false;
+        }
+
+        p = region_end;
+    }
+
+    return true;
+}
+
+uintptr_t accessible_end(const void* ptr, bool write) {
+    if (ptr == nullptr) {
+        return 0;
+    }
+
+    return detail::lookup((uintptr_t)ptr, write, std::chrono::steady_clock::now());
+}
+
+void invalidate() {
+    ++detail::current_generation;
+}
+
+size_t refresh() {
+    auto fresh = os::enumerate();
+    const auto now = std::chrono::steady_clock::now();
+
+    std::unique_lock _{detail::mtx};
+
+    const auto gen = ++detail::current_generation;
+
+    detail::regions.clear();
+    detail::regions.reserve(fresh.size());
+
+    for (const auto& region : fresh) {
+        if (region.image) {
+            detail::regions.push_back(detail::CachedRegion{region, gen, now});
+        }
+    }
+
+    return detail::regions.size();
+}
+
+uint32_t generation() {
+    return detail::current_generation.load();
+}
+
+size_t num_cached_regions() {
+    std::shared_lock _{detail::mtx};
+    return detail::regions.size();
+}
+
+uint64_t num_os_queries() {
+    return detail::os_queries.load(std::memory_order_relaxed);
+}
+
+#ifdef _WIN32
+namespace os {
+namespace detail {
+uint32_t to_access(const MEMORY_BASIC_INFORMATION& mbi) {
+    if (mbi.State != MEM_COMMIT || (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0) {
+        return NONE;
+    }
+
+    constexpr DWORD readable = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    constexpr DWORD writable = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+    uint32_t access = NONE;
+
+    if ((mbi.Protect & readable) != 0) {
+        access |= READ;
+    }
+
+    if ((mbi.Protect & writable) != 0) {
+        access |= WRITE;
+    }
+
+    return access;
+}
+}
+
+std::optional<Region> query(uintptr_t address) {
+    MEMORY_BASIC_INFORMATION mbi{};
+
+    if (VirtualQuery((LPCVOID)address, &mbi, sizeof(mbi)) == 0) {
+        return std::nullopt;
+    }
+
+    return Region{(uintptr_t)mbi.BaseAddress, (uintptr_t)mbi.BaseAddress + mbi.RegionSize, detail::to_access(mbi), mbi.Type == MEM_IMAGE};
+}
+
+std::vector<Region> enumerate() {
+    std::vector<Region> out{};
+    MEMORY_BASIC_INFORMATION mbi{};
+
+    for (uintptr_t p = 0; VirtualQuery((LPCVOID)p, &mbi, sizeof(mbi)) != 0;) {
+        const auto start = (uintptr_t)mbi.BaseAddress;
+        const auto end = start + mbi.RegionSize;
+
+        if (end <= p) {
+            break;
+        }
+
+        const auto access = detail::to_access(mbi);
+        const auto image = mbi.Type == MEM_IMAGE;
+
+        if (access != NONE) {
+            // Adjacent regions with the same protection get merged to keep the snapshot small.
+            if (!out.empty() && out.back().end == start && out.back().access == access && out.back().image == image) {
+                out.back().end = end;
+            } else {
+                out.push_back(Region{start, end, access, image});
+            }
+        }
+
+        p = end;
+    }
+
+    return out;
+}
+}
+#else
+namespace os {
+namespace detail {
+// Calls fn(region) for every mapping, including ones with no access.
+template <typename T>
+void for_each_mapping(T&& fn) {
+    auto f = std::fopen("/proc/self/maps", "r");
+
+    if (f == nullptr) {
+        return;
+    }
+
+    char line[512]{};
+
+    while (std::fgets(line, sizeof(line), f) != nullptr) {
+        uintptr_t start{}, end{};
+        char perms[5]{};
+        unsigned long long inode{};
+
+        if (std::sscanf(line, "%" SCNxPTR "-%" SCNxPTR " %4s %*s %*s %llu", &start, &end, perms, &inode) != 4) {
+            continue;
+        }
+
+        uint32_t access = NONE;
+
+        if (perms[0] == 'r') {
+            access |= READ;
+        }
+
+        if (perms[1] == 'w') {
+            access |= WRITE;
+        }
+
+        // File backed mappings stand in for module images.
+        if (!fn(Region{start, end, access, inode != 0})) {
+            break;
+        }
+    }
+
+    std::fclose(f);
+}
+}
+
+std::optional<Region> query(uintptr_t address) {
+    std::optional<Region> result{};
+    uintptr_t gap_start = 0;
+
+    detail::for_each_mapping([&](const Region& r) {
+        if (address < r.start) {
+            // Unmapped hole between two mappings.
+            result = Region{gap_start, r.start, NONE};
+            return false;
+        }
+
+        if (address < r.end) {
+            result = r;
+            return false;
+        }
+
+        gap_start = r.end;
+        return true;
+    });
+
+    return result;
+}
+
+std::vector<Region> enumerate() {
+    std::vector<Region> out{};
+
+    detail::for_each_mapping([&](const Region& r) {
+        if (r.access == NONE) {
+            return true;
+        }
+
+        if (!out.empty() && out.back().end == r.start && out.back().access == r.access && out.back().image == r.image) {
+            out.back().end = r.end;
+        } else {
+            out.push_back(r);
+        }
+
+        return true;
+    });
+
+    return out;
+}
+}
+#endif
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Cached map of the module images in the process, used to answer "is this pointer readable"
+// without a VirtualQuery per call. Regions are looked up with a binary search over a sorted snapshot.
+// Only image regions are cached (and only for a short time), they can't go away without the
+// module being unloaded. Heap and mapped memory can be freed by any thread at any time, so it
+// always goes straight to the OS, a cached answer there would turn a safe "bad pointer" into
+// an access violation. Thread safe.
+namespace utility::memory_regions {
+enum Access : uint32_t {
+    NONE = 0,
+    READ = 1 << 0,
+    WRITE = 1 << 1,
+};
+
+struct Region {
+    uintptr_t start{};
+    uintptr_t end{};
+    uint32_t access{NONE};
+    bool image{false}; // backed by a loaded module, the only kind of region that gets cached
+};
+
+bool is_accessible(const void* ptr, size_t size, bool write = false);
+
+inline bool is_readable(const void* ptr, size_t size) {
+    return is_accessible(ptr, size, false);
+}
+
+inline bool is_writable(const void* ptr, size_t size) {
+    return is_accessible(ptr, size, true);
+}
+
+// End of the accessible region containing ptr, or 0 if ptr isn't accessible.
+// Lets callers walking memory check once per region instead of once per read.
+uintptr_t accessible_end(const void* ptr, bool write = false);
+
+// Forces every cached region to be queried again on its next use.
+// Call it after catching a fault on memory the cache said was fine, or after unloading a module.
+void invalidate();
+
+// Replaces the snapshot with a full walk of the address space.
+// Returns the number of accessible image regions found.
+size_t refresh();
+
+// Increments whenever the snapshot is invalidated or refreshed.
+uint32_t generation();
+
+size_t num_cached_regions();
+
+// How many lookups had to go to the OS so far.
+uint64_t num_os_queries();
+
+// Thin wrapper over the OS. Windows uses VirtualQuery, everything else parses /proc/self/maps.
+namespace os {
+// The region containing address, with access NONE if it's free/reserved/guarded.
+// nullopt if the address is outside of user space.
+std::optional<Region> query(uintptr_t address);
+
+// All accessible regions, sorted by address.
+std::vector<Region> enumerate();
+}
+}
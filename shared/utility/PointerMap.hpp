@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace utility {
+// Open-addressing hash map keyed by pointer. Linear probing with backward-shift deletion,
+// so there are no tombstones and lookups stay short under heavy insert/erase churn.
+// Null marks empty slots, so a null key is stored on the side. Not thread safe.
+template <typename T>
+class PointerMap {
+public:
+    PointerMap(size_t initial_capacity = 64) {
+        m_slots.resize(std::bit_ceil(std::max<size_t>(initial_capacity, 8)));
+    }
+
+    T* find(const void* key) {
+        if (key == nullptr) {
+            return m_has_null ? &m_null_value : nullptr;
+        }
+
+        for (auto i = index_of(key);; i = next(i)) {
+            auto& slot = m_slots[i];
+
+            if (slot.key == key) {
+                return &slot.value;
+            }
+
+            if (slot.key == nullptr) {
+                return nullptr;
+            }
+        }
+    }
+
+    // Inserts a default constructed value if the key isn't present yet.
+    T& operator[](const void* key) {
+        if (key == nullptr) {
+            if (!m_has_null) {
+                m_has_null = true;
+                m_null_value = T{};
+                ++m_size;
+            }
+
+            return m_null_value;
+        }
+
+        if ((m_size + 1) * 4 > m_slots.size() * 3) {
+            grow();
+        }
+
+        for (auto i = index_of(key);; i = next(i)) {
+            auto& slot = m_slots[i];
+
+            if (slot.key == key) {
+                return slot.value;
+            }
+
+            if (slot.key == nullptr) {
+                slot.key = key;
+                slot.value = T{};
+                ++m_size;
+                return slot.value;
+            }
+        }
+    }
+
+    bool erase(const void* key) {
+        if (key == nullptr) {
+            if (!m_has_null) {
+                return false;
+            }
+
+            m_has_null = false;
+            m_null_value = T{};
+            --m_size;
+            return true;
+        }
+
+        auto i = index_of(key);
+
+        for (;; i = next(i)) {
+            if (m_slots[i].key == key) {
+                break;
+            }
+
+            if (m_slots[i].key == nullptr) {
+                return false;
+            }
+        }
+
+        // Shift following entries back into the hole until one is already in its home slot.
+        for (auto j = next(i);; j = next(j)) {
+            auto& slot = m_slots[j];
+
+            if (slot.key == nullptr) {
+                break;
+            }
+
+            const auto home = index_of(slot.key);
+
+            // Is home cyclically outside of (i, j]?
+            if (((j - home) & mask()) >= ((j - i) & mask())) {
+                m_slots[i] = std::move(slot);
+                i = j;
+            }
+        }
+
+        m_slots[i] = Slot{};
+        --m_size;
+        return true;
+    }
+
+    void clear() {
+        for (auto& slot : m_slots) {
+            slot = Slot{};
+        }
+
+        m_has_null = false;
+        m_null_value = T{};
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    struct Slot {
+        const void* key{nullptr};
+        T value{};
+    };
+
+    size_t mask() const { return m_slots.size() - 1; }
+    size_t next(size_t i) const { return (i + 1) & mask(); }
+
+    size_t index_of(const void* key) const {
+        // Fibonacci hashing, pointers have their low bits mostly zero.
+        const auto h = (uint64_t)(uintptr_t)key * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h >> 32) & mask();
+    }
+
+    void grow() {
+        auto old_slots = std::move(m_slots);
+
+        m_slots = std::vector<Slot>(old_slots.size() * 2);
+        m_size = m_has_null ? 1 : 0;
+
+        for (auto& slot : old_slots) {
+            if (slot.key != nullptr) {
+                (*this)[slot.key] = std::move(slot.value);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots{};
+    size_t m_size{0};
+
+    bool m_has_null{false};
+    T m_null_value{};
+};
+}
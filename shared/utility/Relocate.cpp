@@ -1,118 +1,308 @@
-#include <optional>
-#include <vector>
-#include <array>
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
 #include <stdexcept>
-#include <unordered_set>
+#include <thread>
+#include <vector>
 #include <spdlog/spdlog.h>
 
-#include <Windows.h>
-
-#include <utility/String.hpp>
+#include "MemoryRegions.hpp"
+#include "PointerMap.hpp"
 #include "Relocate.hpp"
 
 using namespace std;
 
 namespace utility {
     namespace detail {
+        // Byte granular set of addresses, one bitmap per 4KB page.
+        class VisitedSet {
+        public:
+            // Returns false if addr was already in the set.
+            bool insert(uintptr_t addr) {
+                if (addr < PAGE_SIZE) {
+                    return false;
+                }
+
+                auto& page = m_pages[(const void*)(addr & ~PAGE_MASK)];
+                const auto bit = addr & PAGE_MASK;
 
-        BOOL IsBadMemPtr(BOOL write, void* ptr, size_t size) {
-            MEMORY_BASIC_INFORMATION mbi;
-            BOOL ok;
-            DWORD mask;
-            BYTE* p = (BYTE*)ptr;
-            BYTE* maxp = p + size;
-            BYTE* regend = NULL;
+                if (page.test(bit)) {
+                    return false;
+                }
 
-            if (size == 0) {
-                return FALSE;
+                page.set(bit);
+                return true;
             }
 
-            if (p == NULL) {
-                return TRUE;
+            // Inserts count addresses starting at addr, step bytes apart, looking each page up once.
+            void insert_range(uintptr_t addr, size_t count, size_t step) {
+                while (count > 0) {
+                    if (addr < PAGE_SIZE) {
+                        return;
+                    }
+
+                    const auto page_base = addr & ~PAGE_MASK;
+                    auto& page = m_pages[(const void*)page_base];
+
+                    for (; count > 0 && (addr & ~PAGE_MASK) == page_base; --count, addr += step) {
+                        page.set(addr & PAGE_MASK);
+                    }
+                }
             }
 
-            if (write == FALSE) {
-                mask = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
-            } else {
-                mask = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+        private:
+            static constexpr uintptr_t PAGE_SIZE = 0x1000;
+            static constexpr uintptr_t PAGE_MASK = PAGE_SIZE - 1;
+
+            utility::PointerMap<std::bitset<PAGE_SIZE>> m_pages{};
+        };
+
+        // Depth first walk with an explicit stack, visiting memory in the same order the old recursive version did.
+        class Relocator {
+        public:
+            Relocator(uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, uint32_t skip_length)
+                : m_old_start{old_start},
+                m_old_size{old_end - old_start},
+                m_new_start{new_start},
+                m_skip_length{skip_length}
+            {
             }
 
-            do {
-                if (p == ptr || p == regend) {
-                    if (VirtualQuery((LPCVOID)p, &mbi, sizeof(mbi)) == 0) {
-                        return TRUE;
-                    } else {
-                        regend = ((BYTE*)mbi.BaseAddress + mbi.RegionSize);
+            void run(uint8_t* scan_start, int32_t depth, uint32_t scan_size) {
+                push(scan_start, depth, scan_size);
+
+                while (!m_stack.empty()) {
+                    const auto frame_index = m_stack.size() - 1;
+
+                    try {
+                        step();
+                    } catch(...) {
+                        // We reached the end of readable memory in this frame.
+                        // The region cache said it was readable, make sure it asks again.
+                        memory_regions::invalidate();
+
+                        // Only give up on the frame that faulted (and anything it pushed),
+                        // its parents still have slots left to scan.
+                        m_stack.resize(frame_index);
                     }
                 }
+            }
+
+            const RelocationStats& stats() const {
+                return m_stats;
+            }
 
-                ok = (mbi.Protect & mask) != 0;
+        private:
+            struct Frame {
+                uint8_t* base{};
+                uintptr_t readable_end{};
+                uint32_t size{};
+                uint32_t offset{};
+                int32_t depth{};
+            };
 
-                if (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) {
-                    ok = FALSE;
+            bool in_range(uintptr_t ptr) const {
+                return ptr - m_old_start < m_old_size;
+            }
+
+            void push(uint8_t* base, int32_t depth, uint32_t size) {
+                if (!m_visited.insert((uintptr_t)base)) {
+                    return;
                 }
 
-                if (!ok) {
-                    return TRUE;
+                if (!memory_regions::is_readable(base, m_skip_length)) {
+                    return;
                 }
 
-                if (maxp <= regend) {
-                    return FALSE;
-                } else if (maxp > regend) {
-                    p = regend;
+                spdlog::debug("[relocate_pointers] Scanning {:x} for range <{:x}, {:x}> (size {:x})", (uintptr_t)base, m_old_start, m_old_start + m_old_size, size);
+
+                m_stack.push_back(Frame{base, memory_regions::accessible_end(base), size, 0, depth});
+                ++m_stats.regions_scanned;
+            }
+
+            // Makes sure the pointer sized slot at the current offset can be read.
+            bool ensure_readable(Frame& frame, uintptr_t slot) {
+                if (slot + sizeof(void*) <= frame.readable_end) {
+                    return true;
                 }
-            } while (p < maxp);
 
-            return FALSE;
-        }
+                if (!memory_regions::is_readable((void*)slot, sizeof(void*))) {
+                    return false;
+                }
 
-        void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth, uint32_t skip_length, uint32_t scan_size, std::unordered_set<uint8_t*>& seen) {
-            try {
-                if (seen.find(scan_start) != seen.end()) {
+                frame.readable_end = std::max(memory_regions::accessible_end((void*)(slot + sizeof(void*) - 1)), slot + sizeof(void*));
+                return true;
+            }
+
+            void relocate(uintptr_t& ptr, uintptr_t slot, const Frame& frame) {
+                const auto new_ptr = m_new_start + (ptr - m_old_start);
+                spdlog::debug("[relocate_pointers] {:x}+{:x}, {:x} -> {:x}", (uintptr_t)frame.base, slot - (uintptr_t)frame.base, ptr, new_ptr);
+
+                ptr = new_ptr;
+                ++m_stats.pointers_relocated;
+            }
+
+            void step() {
+                auto& frame = m_stack.back();
+
+                if (frame.offset >= frame.size) {
+                    m_stack.pop_back();
                     return;
                 }
 
-                seen.insert(scan_start);
+                if (frame.depth <= 0) {
+                    scan_leaf(frame);
+                    m_stack.pop_back();
+                    return;
+                }
 
-                if (IsBadMemPtr(false, scan_start, skip_length)) {
+                const auto slot = (uintptr_t)frame.base + frame.offset;
+
+                if (!ensure_readable(frame, slot)) {
+                    m_stack.pop_back();
                     return;
                 }
 
-                spdlog::info("[relocate_pointers] Scanning {:x} for range <{:x}, {:x}> (size {:x})", (uintptr_t)scan_start, old_start, old_end, scan_size);
+                frame.offset += m_skip_length;
+                ++m_stats.slots_scanned;
+                m_visited.insert(slot);
+
+                auto& ptr = *(uintptr_t*)slot;
+                const auto depth = frame.depth;
 
-                for (auto i = 0; i < scan_size; i += skip_length) {
-                    if (IsBadMemPtr(false, scan_start + i, sizeof(void*))) {
-                        break;
+                if (in_range(ptr)) {
+                    const auto prev = ptr;
+                    relocate(ptr, slot, frame);
+
+                    if (memory_regions::is_readable((void*)prev, sizeof(void*))) {
+                        push((uint8_t*)prev, depth - 1, 0x1000); // invalidates frame
+                    }
+                } else if (memory_regions::is_readable((void*)ptr, sizeof(void*))) {
+                    push((uint8_t*)ptr, depth - 1, 0x1000); // invalidates frame
+                }
+            }
+
+            // Nothing gets pushed at depth 0, so whole readable runs of slots can be checked at once.
+            void scan_leaf(Frame& frame) {
+                while (frame.offset < frame.size) {
+                    const auto first = (uintptr_t)frame.base + frame.offset;
+
+                    if (!ensure_readable(frame, first)) {
+                        return;
                     }
 
-                    auto& ptr = *(uintptr_t*)(scan_start + i);
-                    seen.insert(scan_start + i);
+                    // Slots that fit in both the scan size and the readable region.
+                    const auto scan_end = std::min<uintptr_t>((uintptr_t)frame.base + frame.size, frame.readable_end - sizeof(void*) + 1);
+                    const size_t count = (scan_end - first + m_skip_length - 1) / m_skip_length;
+
+                    m_visited.insert_range(first, count, m_skip_length);
+                    m_stats.slots_scanned += count;
+
+                    size_t i = 0;
 
-                    if (ptr >= old_start && ptr < old_end) {
-                        const auto new_ptr = new_start + (ptr - old_start);
-                        spdlog::info("[relocate_pointers] {:x}+{:x}, {:x} -> {:x}", (uintptr_t)scan_start, (uintptr_t)i, (uintptr_t)ptr, (uintptr_t)new_ptr);
-                        const auto prev = ptr;
-                        ptr = new_ptr;
+                    // 4 slots per iteration with a branchless range check, only branching when one of them hits.
+                    for (; i + 4 <= count; i += 4) {
+                        const auto p = first + i * m_skip_length;
+                        const auto a = *(uintptr_t*)p;
+                        const auto b = *(uintptr_t*)(p + m_skip_length);
+                        const auto c = *(uintptr_t*)(p + m_skip_length * 2);
+                        const auto d = *(uintptr_t*)(p + m_skip_length * 3);
 
-                        if (depth > 0 && !IsBadMemPtr(false, (void*)prev, sizeof(void*))) {
-                            detail::relocate_pointers((uint8_t*)prev, old_start, old_end, new_start, depth - 1, skip_length, 0x1000, seen);
+                        if ((int)in_range(a) | (int)in_range(b) | (int)in_range(c) | (int)in_range(d)) {
+                            for (size_t j = 0; j < 4; ++j) {
+                                const auto slot = p + j * m_skip_length;
+
+                                if (auto& ptr = *(uintptr_t*)slot; in_range(ptr)) {
+                                    relocate(ptr, slot, frame);
+                                }
+                            }
                         }
-                    } else if (depth > 0 && !IsBadMemPtr(false, (void*)ptr, sizeof(void*))) {
-                        detail::relocate_pointers((uint8_t*)ptr, old_start, old_end, new_start, depth - 1, skip_length, 0x1000, seen);
                     }
+
+                    for (; i < count; ++i) {
+                        const auto slot = first + i * m_skip_length;
+
+                        if (auto& ptr = *(uintptr_t*)slot; in_range(ptr)) {
+                            relocate(ptr, slot, frame);
+                        }
+                    }
+
+                    frame.offset += (uint32_t)(count * m_skip_length);
                 }
-            } catch(...) {
-                // We reached the end of readable memory.
             }
+
+            uintptr_t m_old_start{};
+            uintptr_t m_old_size{};
+            uintptr_t m_new_start{};
+            uint32_t m_skip_length{};
+
+            VisitedSet m_visited{};
+            std::vector<Frame> m_stack{};
+            RelocationStats m_stats{};
+        };
+
+        void add_stats(RelocationStats& total, const RelocationStats& stats) {
+            total.regions_scanned += stats.regions_scanned;
+            total.slots_scanned += stats.slots_scanned;
+            total.pointers_relocated += stats.pointers_relocated;
         }
     }
 
     void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth, uint32_t skip_length, uint32_t scan_size) {
+        const RelocationRoot root{scan_start, depth, scan_size};
+        relocate_pointers(std::span{&root, 1}, old_start, old_end, new_start, skip_length, false);
+    }
+
+    RelocationStats relocate_pointers(std::span<const RelocationRoot> roots, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, uint32_t skip_length, bool parallel) {
         if (skip_length == 0) {
             throw std::runtime_error("relocate_pointers: skip_length must be greater than 0");
         }
 
-        std::unordered_set<uint8_t*> seen{};
-        detail::relocate_pointers(scan_start, old_start, old_end, new_start, depth, skip_length, scan_size, seen);
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        RelocationStats total{};
+
+        const auto num_threads = parallel ? std::min<size_t>(roots.size(), std::max(1u, std::thread::hardware_concurrency())) : 1;
+
+        if (num_threads <= 1) {
+            detail::Relocator relocator{old_start, old_end, new_start, skip_length};
+
+            for (const auto& root : roots) {
+                relocator.run(root.scan_start, root.depth, root.scan_size);
+            }
+
+            total = relocator.stats();
+        } else {
+            std::atomic<size_t> next_root{0};
+            std::vector<RelocationStats> thread_stats(num_threads);
+            std::vector<std::thread> threads{};
+
+            for (size_t t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&, t]() {
+                    detail::Relocator relocator{old_start, old_end, new_start, skip_length};
+
+                    for (auto i = next_root++; i < roots.size(); i = next_root++) {
+                        relocator.run(roots[i].scan_start, roots[i].depth, roots[i].scan_size);
+                    }
+
+                    thread_stats[t] = relocator.stats();
+                });
+            }
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            for (const auto& stats : thread_stats) {
+                detail::add_stats(total, stats);
+            }
+        }
+
+        const auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+        spdlog::info("[relocate_pointers] Relocated {} pointers into <{:x}, {:x}> -> {:x}, scanned {} regions ({} slots) from {} roots in {:.2f}ms",
+            total.pointers_relocated, old_start, old_end, new_start, total.regions_scanned, total.slots_scanned, roots.size(), elapsed);
+
+        return total;
     }
 }
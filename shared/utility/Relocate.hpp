@@ -1,7 +1,27 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 
 namespace utility {
+    struct RelocationRoot {
+        uint8_t* scan_start{};
+        int32_t depth{0};
+        uint32_t scan_size{0x1000};
+    };
+
+    struct RelocationStats {
+        size_t regions_scanned{0};
+        size_t slots_scanned{0};
+        size_t pointers_relocated{0};
+    };
+
+    // Scans scan_start for pointers into [old_start, old_end) and rewrites them to point at the same offset from new_start.
+    // With depth > 0, memory pointed to by the scanned slots is scanned too, 0x1000 bytes at a time.
     void relocate_pointers(uint8_t* scan_start, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, int32_t depth = 0, uint32_t skip_length = sizeof(void*), uint32_t scan_size = 0x1000);
+
+    // Same as above for several roots at once, sharing one visited set.
+    // With parallel set, roots are split across threads, each with its own visited set,
+    // so the memory reachable from different roots must not overlap.
+    RelocationStats relocate_pointers(std::span<const RelocationRoot> roots, uintptr_t old_start, uintptr_t old_end, uintptr_t new_start, uint32_t skip_length = sizeof(void*), bool parallel = false);
 }
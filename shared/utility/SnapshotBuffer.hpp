@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace utility {
+// Single writer, many readers. The writer publishes whole copies of T into a ring of slots,
+// readers copy out of the latest slot without taking any locks and retry if it was overwritten
+// while they were reading (a seqlock per slot). With a few slots and one publish per frame,
+// a reader practically never has to retry.
+// Writers must be serialized by the caller.
+template <typename T, size_t N = 4>
+class SnapshotBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "SnapshotBuffer requires a trivially copyable type");
+    static_assert(N >= 2, "SnapshotBuffer needs at least 2 slots");
+
+public:
+    void publish(const T& value) {
+        const auto index = (m_latest.load(std::memory_order_relaxed) + 1) % N;
+        auto& slot = m_slots[index];
+        const auto seq = slot.seq.load(std::memory_order_relaxed);
+
+        // Odd while the slot is being written.
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.value = value;
+
+        slot.seq.store(seq + 2, std::memory_order_release);
+        m_latest.store(index, std::memory_order_release);
+        m_num_published.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Calls f with the latest snapshot and returns its result.
+    // f may be called more than once and must only copy things out of the snapshot.
+    template <typename F>
+    auto read(F&& f) const {
+        for (;;) {
+            const auto& slot = m_slots[m_latest.load(std::memory_order_acquire)];
+            const auto seq = slot.seq.load(std::memory_order_acquire);
+
+            if ((seq & 1) != 0) {
+                continue;
+            }
+
+            auto result = f(slot.value);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.seq.load(std::memory_order_relaxed) == seq) {
+                return result;
+            }
+        }
+    }
+
+    T get() const {
+        return read([](const T& value) { return value; });
+    }
+
+    // How many snapshots have been published so far.
+    uint64_t num_published() const {
+        return m_num_published.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> seq{0};
+        T value{};
+    };
+
+    std::array<Slot, N> m_slots{};
+    std::atomic<size_t> m_latest{0};
+    std::atomic<uint64_t> m_num_published{0};
+};
+}
@@ -7,6 +7,9 @@
 #include <utility/Profiler.hpp>
 
 #include "sdk/Application.hpp"
+#include "sdk/Renderer.hpp"
+#include "sdk/SceneIndex.hpp"
+#include "sdk/REComponent.hpp"
 
 #include "Hooks.hpp"
 
@@ -874,6 +877,9 @@ void Hooks::global_application_entry_hook_internal(void* entry, const char* name
         auto& mods = g_framework->get_mods()->get_mods();
 
         if (hash == "BeginRendering"_fnv) {
+            utility::re_component::advance_cache_frame();
+            sdk::renderer::update_camera_snapshot();
+            sdk::scene_index::update();
             g_framework->run_imgui_frame(false);
         }
 
@@ -901,6 +907,9 @@ void Hooks::global_application_entry_hook_internal(void* entry, const char* name
         m_application_entry_times[name] = profiler_entry;
     } else {
         if (hash == "BeginRendering"_fnv) {
+            utility::re_component::advance_cache_frame();
+            sdk::renderer::update_camera_snapshot();
+            sdk::scene_index::update();
             g_framework->run_imgui_frame(false);
         }
 
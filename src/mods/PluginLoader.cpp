@@ -9,7 +9,13 @@
 #include "utility/Module.hpp"
 
 #include "sdk/ResourceManager.hpp"
+#include "sdk/SystemArray.hpp"
 #include "sdk/Memory.hpp"
+#include "sdk/ManagedObjectHandles.hpp"
+#include "sdk/RETransform.hpp"
+#include "sdk/REComponent.hpp"
+#include "sdk/Renderer.hpp"
+#include "sdk/SceneIndex.hpp"
 
 #include "APIProxy.hpp"
 #include "ScriptRunner.hpp"
@@ -69,6 +75,41 @@ REFrameworkPluginFunctions g_plugin_functions {
     reframework::is_drawing_ui
 };
 
+// Writes up to max_out game objects and returns how many were found in total.
+unsigned int write_scene_objects(const std::vector<sdk::scene_index::Object>& objects, REFrameworkManagedObjectHandle* out, unsigned int max_out) {
+    if (out != nullptr) {
+        const auto count = std::min<size_t>(objects.size(), max_out);
+
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = (REFrameworkManagedObjectHandle)objects[i].owner;
+        }
+    }
+
+    return (unsigned int)objects.size();
+}
+
+utility::re_transform::JointPoseBuffers get_joint_pose_buffers(float* local_positions, float* local_rotations, float* world_positions, float* world_rotations, unsigned int count) {
+    utility::re_transform::JointPoseBuffers out{};
+
+    if (local_positions != nullptr) {
+        out.local_positions = std::span{(Vector4f*)local_positions, count};
+    }
+
+    if (local_rotations != nullptr) {
+        out.local_rotations = std::span{(glm::quat*)local_rotations, count};
+    }
+
+    if (world_positions != nullptr) {
+        out.world_positions = std::span{(Vector4f*)world_positions, count};
+    }
+
+    if (world_rotations != nullptr) {
+        out.world_rotations = std::span{(glm::quat*)world_rotations, count};
+    }
+
+    return out;
+}
+
 REFrameworkSDKFunctions g_sdk_functions {
     []() -> REFrameworkTDBHandle { return (REFrameworkTDBHandle)sdk::RETypeDB::get(); },
     []() { return (REFrameworkResourceManagerHandle)sdk::ResourceManager::get(); },
@@ -182,7 +223,132 @@ REFrameworkSDKFunctions g_sdk_functions {
     },
     [](REFrameworkMethodHandle fn, unsigned int id) { g_hookman.remove((sdk::REMethodDefinition*)fn, (HookManager::HookId)id); },
     &sdk::memory::allocate,
-    &sdk::memory::deallocate
+    &sdk::memory::deallocate,
+    [](REFrameworkManagedObjectHandle transform, const char** names, unsigned int count, REFrameworkManagedObjectHandle* out) -> unsigned int {
+        if (transform == nullptr || names == nullptr || out == nullptr) {
+            return 0;
+        }
+
+        std::vector<std::wstring> wide_names{};
+        std::vector<std::wstring_view> name_views{};
+        wide_names.reserve(count);
+        name_views.reserve(count);
+
+        for (unsigned int i = 0; i < count; ++i) {
+            name_views.emplace_back(wide_names.emplace_back(names[i] != nullptr ? utility::widen(names[i]) : L""));
+        }
+
+        return (unsigned int)utility::re_transform::resolve_joints(*(::RETransform*)transform, name_views, std::span{(::REJoint**)out, count});
+    },
+    [](REFrameworkManagedObjectHandle transform, const unsigned int* hashes, unsigned int count, REFrameworkManagedObjectHandle* out) -> unsigned int {
+        if (transform == nullptr || hashes == nullptr || out == nullptr) {
+            return 0;
+        }
+
+        const auto in = std::span{(const uint32_t*)hashes, count};
+        return (unsigned int)utility::re_transform::resolve_joints(*(::RETransform*)transform, in, std::span{(::REJoint**)out, count});
+    },
+    [](REFrameworkManagedObjectHandle transform) -> unsigned int {
+        if (transform == nullptr) {
+            return 0;
+        }
+
+        return utility::re_transform::get_joint_count(*(::RETransform*)transform);
+    },
+    [](REFrameworkManagedObjectHandle transform, float* local_positions, float* local_rotations, float* world_positions, float* world_rotations, unsigned int count) -> unsigned int {
+        if (transform == nullptr) {
+            return 0;
+        }
+
+        const auto buffers = get_joint_pose_buffers(local_positions, local_rotations, world_positions, world_rotations, count);
+        return utility::re_transform::read_pose(*(::RETransform*)transform, buffers);
+    },
+    [](REFrameworkManagedObjectHandle transform, const float* local_positions, const float* local_rotations, const float* world_positions, const float* world_rotations, 
+       const unsigned char* mask, unsigned int count) -> unsigned int 
+    {
+        if (transform == nullptr) {
+            return 0;
+        }
+
+        // The buffers are only read from when writing.
+        const auto buffers = get_joint_pose_buffers((float*)local_positions, (float*)local_rotations, (float*)world_positions, (float*)world_rotations, count);
+        const auto mask_span = mask != nullptr ? std::span{(const uint8_t*)mask, count} : std::span<const uint8_t>{};
+
+        return utility::re_transform::write_pose(*(::RETransform*)transform, buffers, mask_span);
+    },
+    [](const float* world_positions, unsigned int count, bool cull_offscreen, float* out_screen_positions, unsigned char* out_visible) -> unsigned int {
+        if (world_positions == nullptr || out_screen_positions == nullptr || out_visible == nullptr) {
+            return 0;
+        }
+
+        const auto in = std::span{(const Vector4f*)world_positions, count};
+        const auto out = std::span{(Vector2f*)out_screen_positions, count};
+
+        return (unsigned int)sdk::renderer::world_to_screen(in, out, std::span{(uint8_t*)out_visible, count}, cull_offscreen);
+    },
+    [](const char* type_name) -> unsigned long long {
+        if (type_name == nullptr) {
+            return 0;
+        }
+
+        return sdk::scene_index::get_tag(type_name);
+    },
+    [](const float* position, float radius, unsigned long long tag_mask, REFrameworkManagedObjectHandle* out, unsigned int max_out) -> unsigned int {
+        if (position == nullptr) {
+            return 0;
+        }
+
+        const auto objects = sdk::scene_index::find_near(Vector3f{position[0], position[1], position[2]}, radius, tag_mask);
+        return write_scene_objects(objects, out, max_out);
+    },
+    [](const float* view_proj, unsigned long long tag_mask, REFrameworkManagedObjectHandle* out, unsigned int max_out) -> unsigned int {
+        if (view_proj == nullptr) {
+            return 0;
+        }
+
+        const auto objects = sdk::scene_index::find_in_frustum(glm::make_mat4(view_proj), tag_mask);
+        return write_scene_objects(objects, out, max_out);
+    },
+    [](const float* position, unsigned int k, float max_radius, unsigned long long tag_mask, REFrameworkManagedObjectHandle* out) -> unsigned int {
+        if (position == nullptr) {
+            return 0;
+        }
+
+        const auto objects = sdk::scene_index::find_nearest(Vector3f{position[0], position[1], position[2]}, k, max_radius, tag_mask);
+        return write_scene_objects(objects, out, k);
+    },
+    [](REFrameworkManagedObjectHandle game_object, REFrameworkTypeDefinitionHandle type) -> REFrameworkManagedObjectHandle {
+        if (game_object == nullptr || type == nullptr) {
+            return nullptr;
+        }
+
+        // Same check as sdk.find_component, anything else would be read as an REGameObject.
+        static auto game_object_t = sdk::find_type_definition("via.GameObject")->get_type();
+
+        if (!utility::re_managed_object::is_managed_object(game_object) || !utility::re_managed_object::is_a((::REManagedObject*)game_object, game_object_t)) {
+            return nullptr;
+        }
+
+        auto t = ((sdk::RETypeDefinition*)type)->get_type();
+        return (REFrameworkManagedObjectHandle)utility::re_component::find_cached((::REGameObject*)game_object, t);
+    },
+    [](REFrameworkTypeDefinitionHandle type, REFrameworkManagedObjectHandle* out, unsigned int max_out) -> unsigned int {
+        if (type == nullptr) {
+            return 0;
+        }
+
+        const auto components = utility::re_component::find_all(((sdk::RETypeDefinition*)type)->get_type());
+
+        if (out != nullptr) {
+            const auto count = std::min<size_t>(components.size(), max_out);
+
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = (REFrameworkManagedObjectHandle)components[i];
+            }
+        }
+
+        return (unsigned int)components.size();
+    }
 };
 
 #define RETYPEDEF(var) ((sdk::RETypeDefinition*)var)
@@ -421,6 +587,22 @@ REFrameworkTDB g_tdb_data {
 
 #define REMANAGEDOBJECT(var) ((::REManagedObject*)var)
 
+// Plugins can pass any handle to the array functions, only treat it as an REArrayBase
+// if it really is a System.Array (same check the Lua side does before pushing a SystemArray).
+static sdk::SystemArray* as_system_array(REFrameworkManagedObjectHandle obj) {
+    if (obj == nullptr || !utility::re_managed_object::is_managed_object(obj)) {
+        return nullptr;
+    }
+
+    const auto td = utility::re_managed_object::get_type_definition(REMANAGEDOBJECT(obj));
+
+    if (td == nullptr || !td->is_array()) {
+        return nullptr;
+    }
+
+    return (sdk::SystemArray*)obj;
+}
+
 REFrameworkManagedObject g_managed_object_data {
     [](REFrameworkManagedObjectHandle obj) { utility::re_managed_object::add_ref(REMANAGEDOBJECT(obj)); },
     [](REFrameworkManagedObjectHandle obj) { utility::re_managed_object::release(REMANAGEDOBJECT(obj)); },
@@ -433,6 +615,74 @@ REFrameworkManagedObject g_managed_object_data {
     [](REFrameworkManagedObjectHandle obj) { return (void*)utility::re_managed_object::get_variables(REMANAGEDOBJECT(obj)); },
     [](REFrameworkManagedObjectHandle obj, const char* name) { return (REFrameworkReflectionPropertyHandle)utility::re_managed_object::get_field_desc(REMANAGEDOBJECT(obj), name); },
     [](REFrameworkManagedObjectHandle obj, const char* name) { return (REFrameworkReflectionMethodHandle)utility::re_managed_object::get_method_desc(REMANAGEDOBJECT(obj), name); },
+    [](REFrameworkManagedObjectHandle obj, REFrameworkManagedObjectHandle* out, unsigned int out_size) -> unsigned int {
+        const auto arr = as_system_array(obj);
+
+        if (arr == nullptr) {
+            return 0;
+        }
+
+        const auto count = (unsigned int)arr->get_num_elements();
+
+        if (out == nullptr || out_size == 0) {
+            return count;
+        }
+
+        const auto to_copy = std::min(count, out_size);
+
+        if (!arr->has_inline_elements()) {
+            const auto elements = arr->view<::REManagedObject*>();
+            std::copy_n(elements.begin(), std::min<size_t>(to_copy, elements.size()), (::REManagedObject**)out);
+        } else {
+            for (unsigned int i = 0; i < to_copy; ++i) {
+                out[i] = (REFrameworkManagedObjectHandle)arr->get_element(i);
+            }
+        }
+
+        return count;
+    },
+    [](REFrameworkManagedObjectHandle obj, unsigned int* out_count, unsigned int* out_stride) -> void* {
+        if (out_count != nullptr) {
+            *out_count = 0;
+        }
+
+        if (out_stride != nullptr) {
+            *out_stride = 0;
+        }
+
+        const auto arr = as_system_array(obj);
+
+        if (arr == nullptr) {
+            return nullptr;
+        }
+
+        if (out_count != nullptr) {
+            *out_count = (unsigned int)arr->get_num_elements();
+        }
+
+        if (out_stride != nullptr) {
+            *out_stride = arr->get_element_stride();
+        }
+
+        return arr->get_data();
+    },
+    [](REFrameworkManagedObjectHandle obj) -> REFrameworkGenerationalHandle {
+        return sdk::managed_handles::acquire(REMANAGEDOBJECT(obj));
+    },
+    [](REFrameworkGenerationalHandle handle) {
+        return sdk::managed_handles::release(handle);
+    },
+    [](REFrameworkGenerationalHandle handle) {
+        return (REFrameworkManagedObjectHandle)sdk::managed_handles::resolve(handle);
+    },
+    [](const REFrameworkGenerationalHandle* handles, REFrameworkManagedObjectHandle* out, unsigned int count) -> unsigned int {
+        if (handles == nullptr || out == nullptr) {
+            return 0;
+        }
+
+        const auto in = std::span{(const sdk::managed_handles::Handle*)handles, count};
+        return (unsigned int)sdk::managed_handles::resolve(in, std::span{(::REManagedObject**)out, count});
+    },
 };
 
 #define RERESOURCEMGR(var) ((sdk::ResourceManager*)var)
@@ -19,6 +19,9 @@
 #include "bindings/ImGui.hpp"
 #include "bindings/Json.hpp"
 #include "bindings/FS.hpp"
+#include "bindings/VecBuf.hpp"
+#include "bindings/DrawBuf.hpp"
+#include "bindings/IK.hpp"
 
 #include "ScriptRunner.hpp"
 
@@ -55,6 +58,7 @@ ScriptState::ScriptState(const ScriptState::GarbageCollectionData& gc_data) {
     std::scoped_lock _{ m_execution_mutex };
 
     m_lua.registry()["state"] = this;
+    *(ScriptState**)lua_getextraspace(m_lua.lua_state()) = this;
     m_lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::math, sol::lib::table, sol::lib::bit32,
         sol::lib::utf8, sol::lib::os, sol::lib::coroutine);
 
@@ -70,21 +74,31 @@ ScriptState::ScriptState(const ScriptState::GarbageCollectionData& gc_data) {
     os["setlocale"] = sol::nil;
     os["getenv"] = sol::nil;
 
+    lua_newtable(m_lua);
+    lua_newtable(m_lua);
+    lua_pushstring(m_lua, "v");
+    lua_setfield(m_lua, -2, "__mode");
+    lua_setmetatable(m_lua, -2);
+    m_managed_object_cache = luaL_ref(m_lua, LUA_REGISTRYINDEX);
+
     bindings::open_sdk(this);
     bindings::open_imgui(this);
     bindings::open_json(this);
     bindings::open_fs(this);
+    bindings::open_vecbuf(this);
+    bindings::open_drawbuf(this);
+    bindings::open_ik(this);
 
     auto re = m_lua.create_table();
     re["msg"] = api::re::msg;
-    re["on_pre_application_entry"] = [this](const char* name, sol::function fn) { m_pre_application_entry_fns.emplace(utility::hash(name), fn); };
-    re["on_application_entry"] = [this](const char* name, sol::function fn) { m_application_entry_fns.emplace(utility::hash(name), fn); };
-    re["on_pre_gui_draw_element"] = [this](sol::function fn) { m_pre_gui_draw_element_fns.emplace_back(fn); };
-    re["on_gui_draw_element"] = [this](sol::function fn) { m_gui_draw_element_fns.emplace_back(fn); };
-    re["on_draw_ui"] = [this](sol::function fn) { m_on_draw_ui_fns.emplace_back(fn); };
-    re["on_frame"] = [this](sol::function fn) { m_on_frame_fns.emplace_back(fn); };
-    re["on_script_reset"] = [this](sol::function fn) { m_on_script_reset_fns.emplace_back(fn); };
-    re["on_config_save"] = [this](sol::function fn) { m_on_config_save_fns.emplace_back(fn); };
+    re["on_pre_application_entry"] = [this](const char* name, sol::function fn) { m_pre_application_entry_fns.emplace(utility::hash(name), ScriptCallback{m_current_script, fn}); };
+    re["on_application_entry"] = [this](const char* name, sol::function fn) { m_application_entry_fns.emplace(utility::hash(name), ScriptCallback{m_current_script, fn}); };
+    re["on_pre_gui_draw_element"] = [this](sol::function fn) { m_pre_gui_draw_element_fns.emplace_back(m_current_script, fn); };
+    re["on_gui_draw_element"] = [this](sol::function fn) { m_gui_draw_element_fns.emplace_back(m_current_script, fn); };
+    re["on_draw_ui"] = [this](sol::function fn) { m_on_draw_ui_fns.emplace_back(m_current_script, fn); };
+    re["on_frame"] = [this](sol::function fn) { m_on_frame_fns.emplace_back(m_current_script, fn); };
+    re["on_script_reset"] = [this](sol::function fn) { m_on_script_reset_fns.emplace_back(m_current_script, fn); };
+    re["on_config_save"] = [this](sol::function fn) { m_on_config_save_fns.emplace_back(m_current_script, fn); };
     m_lua["re"] = re;
 
 
@@ -308,13 +322,26 @@ ScriptState::ScriptState(const ScriptState::GarbageCollectionData& gc_data) {
 
 ScriptState::~ScriptState() {
     std::scoped_lock _{m_execution_mutex};
-    for (auto&& [fn, hook_ids] : m_hooks) {
-        for (auto&& id : hook_ids) {
-            g_hookman.remove(fn, id);
+    for (auto&& [fn, hooks] : m_hooks) {
+        for (auto&& hook : hooks) {
+            g_hookman.remove(fn, hook.id);
         }
     }
 }
 
+ScriptState::ScriptId ScriptState::get_script_id(const std::string& p) {
+    const auto path = std::filesystem::path{p}.lexically_normal().string();
+
+    if (auto it = m_script_ids.find(path); it != m_script_ids.end()) {
+        return it->second;
+    }
+
+    const auto id = (ScriptId)m_script_ids.size() + 1;
+    m_script_ids.emplace(path, id);
+
+    return id;
+}
+
 void ScriptState::run_script(const std::string& p) {
     std::scoped_lock _{ m_execution_mutex };
 
@@ -333,6 +360,8 @@ void ScriptState::run_script(const std::string& p) {
         package_path = package_path + ";" + dir.string() + "/?.dll";
 
         m_lua["package"]["path"] = package_path;
+
+        ScriptScope scope{this, get_script_id(p)};
         m_lua.safe_script_file(p);
     } catch (const std::exception& e) {
         ScriptRunner::get()->spew_error(e.what());
@@ -345,6 +374,63 @@ void ScriptState::run_script(const std::string& p) {
     m_lua["package"]["path"] = old_path;
 }
 
+void ScriptState::unload_script(const std::string& p) {
+    std::scoped_lock _{ m_execution_mutex };
+
+    const auto id = get_script_id(p);
+
+    spdlog::info("[ScriptState] Unloading script {}...", p);
+
+    try {
+        ScriptScope scope{this, id};
+
+        // Same order as on_script_reset, so the script can save before cleaning up.
+        for (auto& cb : m_on_config_save_fns) {
+            if (cb.owner == id) {
+                handle_protected_result(cb.fn());
+            }
+        }
+
+        for (auto& cb : m_on_script_reset_fns) {
+            if (cb.owner == id) {
+                handle_protected_result(cb.fn());
+            }
+        }
+    } catch (const std::exception& e) {
+        ScriptRunner::get()->spew_error(e.what());
+    } catch (...) {
+        ScriptRunner::get()->spew_error("Unknown exception in on_script_reset");
+    }
+
+    const auto owned = [id](const ScriptCallback& cb) { return cb.owner == id; };
+    const auto owned_entry = [id](const auto& entry) { return entry.second.owner == id; };
+
+    std::erase_if(m_pre_application_entry_fns, owned_entry);
+    std::erase_if(m_application_entry_fns, owned_entry);
+    std::erase_if(m_pre_gui_draw_element_fns, owned);
+    std::erase_if(m_gui_draw_element_fns, owned);
+    std::erase_if(m_on_draw_ui_fns, owned);
+    std::erase_if(m_on_frame_fns, owned);
+    std::erase_if(m_on_script_reset_fns, owned);
+    std::erase_if(m_on_config_save_fns, owned);
+
+    std::erase_if(m_hooks_to_add, [id](const HookDef& def) { return def.owner == id; });
+
+    for (auto&& [fn, hooks] : m_hooks) {
+        std::erase_if(hooks, [fn = fn, id](const InstalledHook& hook) {
+            if (hook.owner != id) {
+                return false;
+            }
+
+            g_hookman.remove(fn, hook.id);
+            return true;
+        });
+    }
+
+    // Let the collector pick up whatever the callbacks were keeping alive.
+    lua_gc(m_lua, LUA_GCCOLLECT);
+}
+
 // i have to wonder why this isn't in sol when they have safe_script stuff
 sol::protected_function_result ScriptState::handle_protected_result(sol::protected_function_result result) {
     if (result.valid()) {
@@ -359,8 +445,9 @@ void ScriptState::on_frame() {
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        for (auto& fn : m_on_frame_fns) {
-            handle_protected_result(fn());
+        for (auto& cb : m_on_frame_fns) {
+            ScriptScope scope{this, cb.owner};
+            handle_protected_result(cb.fn());
         }
     } catch (const std::exception& e) {
         ScriptRunner::get()->spew_error(e.what());
@@ -379,8 +466,9 @@ void ScriptState::on_draw_ui() {
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        for (auto& fn : m_on_draw_ui_fns) {
-            handle_protected_result(fn());
+        for (auto& cb : m_on_draw_ui_fns) {
+            ScriptScope scope{this, cb.owner};
+            handle_protected_result(cb.fn());
         }
     } catch (const std::exception& e) {
         ScriptRunner::get()->spew_error(e.what());
@@ -403,7 +491,8 @@ void ScriptState::on_pre_application_entry(size_t hash) {
             std::scoped_lock _{ m_execution_mutex };
 
             for (auto it = range.first; it != range.second; ++it) {
-                handle_protected_result(it->second());
+                ScriptScope scope{this, it->second.owner};
+                handle_protected_result(it->second.fn());
             }
         }
     } catch (const std::exception& e) {
@@ -422,7 +511,8 @@ void ScriptState::on_application_entry(size_t hash) {
                 std::scoped_lock _{ m_execution_mutex };
 
                 for (auto it = range.first; it != range.second; ++it) {
-                    handle_protected_result(it->second());
+                    ScriptScope scope{this, it->second.owner};
+                    handle_protected_result(it->second.fn());
                 }
             }
         }
@@ -465,8 +555,10 @@ bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* contex
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        for (auto& fn : m_pre_gui_draw_element_fns) {
-            if (sol::object result = handle_protected_result(fn(gui_element, context)); !result.is<sol::nil_t>() && result.is<bool>() && result.as<bool>() == false) {
+        for (auto& cb : m_pre_gui_draw_element_fns) {
+            ScriptScope scope{this, cb.owner};
+
+            if (sol::object result = handle_protected_result(cb.fn(gui_element, context)); !result.is<sol::nil_t>() && result.is<bool>() && result.as<bool>() == false) {
                 any_false = true;
             }
         }
@@ -483,8 +575,9 @@ void ScriptState::on_gui_draw_element(REComponent* gui_element, void* context) {
     try {
         std::scoped_lock _{ m_execution_mutex };
 
-        for (auto& fn : m_gui_draw_element_fns) {
-            handle_protected_result(fn(gui_element, context));
+        for (auto& cb : m_gui_draw_element_fns) {
+            ScriptScope scope{this, cb.owner};
+            handle_protected_result(cb.fn(gui_element, context));
         }
     } catch (const std::exception& e) {
         ScriptRunner::get()->spew_error(e.what());
@@ -497,12 +590,14 @@ void ScriptState::on_script_reset() try {
     std::scoped_lock _{ m_execution_mutex };
 
     // We first call on_config_save functions so scripts can save prior to reset.
-    for (auto& fn : m_on_config_save_fns) {
-        handle_protected_result(fn());
+    for (auto& cb : m_on_config_save_fns) {
+        ScriptScope scope{this, cb.owner};
+        handle_protected_result(cb.fn());
     }
 
-    for (auto& fn : m_on_script_reset_fns) {
-        handle_protected_result(fn());
+    for (auto& cb : m_on_script_reset_fns) {
+        ScriptScope scope{this, cb.owner};
+        handle_protected_result(cb.fn());
     }
 } catch (const std::exception& e) {
     ScriptRunner::get()->spew_error(e.what());
@@ -513,8 +608,9 @@ void ScriptState::on_script_reset() try {
 void ScriptState::on_config_save() try {
     std::scoped_lock _{ m_execution_mutex };
 
-    for (auto& fn : m_on_config_save_fns) {
-        handle_protected_result(fn());
+    for (auto& cb : m_on_config_save_fns) {
+        ScriptScope scope{this, cb.owner};
+        handle_protected_result(cb.fn());
     }
 }
 catch (const std::exception& e) {
@@ -525,11 +621,11 @@ catch (const std::exception& e) {
 
 void ScriptState::add_hook(
     sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_obj) {
-    m_hooks_to_add.emplace_back((::REManagedObject*)nullptr, fn, pre_cb, post_cb, ignore_jmp_obj);
+    m_hooks_to_add.emplace_back((::REManagedObject*)nullptr, fn, pre_cb, post_cb, ignore_jmp_obj, m_current_script);
 }
 
 void ScriptState::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb) {
-    m_hooks_to_add.emplace_back(obj, fn, pre_cb, post_cb);
+    m_hooks_to_add.emplace_back(obj, fn, pre_cb, post_cb, sol::object{}, m_current_script);
 }
 
 void ScriptState::install_hooks() {
@@ -539,13 +635,15 @@ void ScriptState::install_hooks() {
         auto pre_cb = hookdef.pre_cb;
         auto post_cb = hookdef.post_cb;
         auto ignore_jmp_object = hookdef.ignore_jmp_obj;
+        auto owner = hookdef.owner;
         const auto hookman_data = HookManager::EitherOr{hookdef.obj, hookdef.fn, ignore_jmp_object.is<bool>() ? ignore_jmp_object.as<bool>() : false};
         auto id = g_hookman.add_either_or(
             hookman_data,
-            [pre_cb, state = this](auto& args, auto& arg_tys) -> HookManager::PreHookResult {
+            [pre_cb, owner, state = this](auto& args, auto& arg_tys) -> HookManager::PreHookResult {
                 using PreHookResult = HookManager::PreHookResult;
 
                 auto _ = state->scoped_lock();
+                ScriptScope scope{state, owner};
                 auto result = PreHookResult::CALL_ORIGINAL;
 
                 try {
@@ -586,8 +684,9 @@ void ScriptState::install_hooks() {
 
                 return result;
             },
-            [post_cb, state = this](auto& ret_val, auto* ret_ty) {
+            [post_cb, owner, state = this](auto& ret_val, auto* ret_ty) {
                 auto _ = state->scoped_lock();
+                ScriptScope scope{state, owner};
 
                 try {
                     if (post_cb.is<sol::nil_t>()) {
@@ -608,7 +707,7 @@ void ScriptState::install_hooks() {
                 }
             }
         );
-        m_hooks[fn].emplace_back(id);
+        m_hooks[fn].emplace_back(id, owner);
     }
 }
 
@@ -669,6 +768,8 @@ void ScriptRunner::on_config_load(const utility::Config& cfg) {
         option.config_load(cfg);
     }
 
+    utility::re_managed_object::set_deferred_releases_enabled(m_defer_releases->value());
+
     if (m_state != nullptr) {
         m_state->gc_data_changed(make_gc_data());
     }
@@ -703,6 +804,13 @@ void ScriptRunner::on_frame() {
         return;
     }
 
+    if (m_hot_reload->value()) {
+        check_for_script_changes();
+    } else if (m_autorun_watch != INVALID_HANDLE_VALUE) {
+        FindCloseChangeNotification(m_autorun_watch);
+        m_autorun_watch = INVALID_HANDLE_VALUE;
+    }
+
     m_state->on_frame();
 
     // install_hooks gets called here because it ensures hooks get installed the next frame after they've been 
@@ -727,8 +835,14 @@ void ScriptRunner::on_draw_ui() {
 
             if (GetOpenFileName(&ofn) != FALSE) {
                 std::scoped_lock _{ m_access_mutex };
+                const auto name = std::filesystem::path{file}.filename().string();
+
+                std::error_code ec{};
+                m_script_paths[name] = file;
+                m_script_write_times[name] = std::filesystem::last_write_time(m_script_paths[name], ec);
+
                 m_state->run_script(file);
-                m_loaded_scripts.emplace_back(std::filesystem::path{file}.filename().string());
+                m_loaded_scripts.emplace_back(name);
             }
         }
 
@@ -799,6 +913,11 @@ void ScriptRunner::on_draw_ui() {
         }
 
         m_log_to_disk->draw("Log Lua Errors to Disk");
+        m_hot_reload->draw("Hot Reload Changed Scripts");
+
+        if (m_defer_releases->draw("Defer Managed Object Releases")) {
+            utility::re_managed_object::set_deferred_releases_enabled(m_defer_releases->value());
+        }
 
         if (!m_last_script_error.empty()) {
             std::shared_lock _{m_script_error_mutex};
@@ -820,10 +939,30 @@ void ScriptRunner::on_draw_ui() {
             ImGui::Text("Known scripts:");
 
             for (auto&& name : m_known_scripts) {
+                ImGui::PushID(name.data());
+
                 if (ImGui::Checkbox(name.data(), &m_loaded_scripts_map[name])) {
-                    reset_scripts();
+                    if (m_loaded_scripts_map[name]) {
+                        load_script(name);
+                    } else {
+                        unload_script(name);
+                    }
+
+                    ImGui::PopID();
                     break;
                 }
+
+                if (m_loaded_scripts_map[name]) {
+                    ImGui::SameLine();
+
+                    if (ImGui::SmallButton("Reload")) {
+                        reload_script(name);
+                        ImGui::PopID();
+                        break;
+                    }
+                }
+
+                ImGui::PopID();
             }
         } else {
             ImGui::Text("No scripts loaded.");
@@ -854,11 +993,14 @@ void ScriptRunner::on_pre_application_entry(void* entry, const char* name, size_
 void ScriptRunner::on_application_entry(void* entry, const char* name, size_t hash) {
     std::scoped_lock _{ m_access_mutex };
 
-    if (m_state == nullptr) {
-        return;
+    if (m_state != nullptr) {
+        m_state->on_application_entry(hash);
     }
 
-    m_state->on_application_entry(hash);
+    // After the Lua GC step, so the releases from this frame's collected objects go out too.
+    if (hash == "EndRendering"_fnv) {
+        utility::re_managed_object::flush_deferred_releases();
+    }
 }
 
 bool ScriptRunner::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_context) {
@@ -921,9 +1063,15 @@ void ScriptRunner::reset_scripts() {
     // if we didn't destroy the state before creating a new one
     // the FirstPerson mod would attempt to hook an already hooked function
     m_state.reset();
+
+    // The old state released everything it held when it was closed.
+    utility::re_managed_object::flush_deferred_releases();
+
     m_state = std::make_unique<ScriptState>(make_gc_data());
     m_loaded_scripts.clear();
     m_known_scripts.clear();
+    m_script_paths.clear();
+    m_script_write_times.clear();
 
     std::string module_path{};
 
@@ -946,7 +1094,12 @@ void ScriptRunner::reset_scripts() {
                 m_loaded_scripts_map.emplace(path.filename().string(), true);
             }
 
+            m_script_paths[path.filename().string()] = path.string();
+
             if (m_loaded_scripts_map[path.filename().string()] == true) {
+                std::error_code ec{};
+                m_script_write_times[path.filename().string()] = std::filesystem::last_write_time(path, ec);
+
                 m_state->run_script(path.string());
                 m_loaded_scripts.emplace_back(path.filename().string());
             }
@@ -958,3 +1111,105 @@ void ScriptRunner::reset_scripts() {
     std::sort(m_known_scripts.begin(), m_known_scripts.end());
     std::sort(m_loaded_scripts.begin(), m_loaded_scripts.end());
 }
+
+void ScriptRunner::load_script(const std::string& name) {
+    std::scoped_lock _{ m_access_mutex };
+
+    if (m_state == nullptr) {
+        return;
+    }
+
+    auto it = m_script_paths.find(name);
+
+    if (it == m_script_paths.end()) {
+        return;
+    }
+
+    if (std::find(m_loaded_scripts.begin(), m_loaded_scripts.end(), name) != m_loaded_scripts.end()) {
+        return;
+    }
+
+    std::error_code ec{};
+    m_script_write_times[name] = std::filesystem::last_write_time(it->second, ec);
+
+    m_state->run_script(it->second);
+    m_loaded_scripts.emplace_back(name);
+    std::sort(m_loaded_scripts.begin(), m_loaded_scripts.end());
+}
+
+void ScriptRunner::unload_script(const std::string& name) {
+    std::scoped_lock _{ m_access_mutex };
+
+    if (m_state == nullptr) {
+        return;
+    }
+
+    auto it = m_script_paths.find(name);
+
+    if (it == m_script_paths.end()) {
+        return;
+    }
+
+    m_state->unload_script(it->second);
+    std::erase(m_loaded_scripts, name);
+    m_script_write_times.erase(name);
+}
+
+void ScriptRunner::reload_script(const std::string& name) {
+    std::scoped_lock _{ m_access_mutex };
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    unload_script(name);
+    load_script(name);
+
+    const auto took = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    spdlog::info("[ScriptRunner] Reloaded {} in {:.2f}ms", name, took);
+}
+
+void ScriptRunner::check_for_script_changes() {
+    const auto now = std::chrono::steady_clock::now();
+    bool autorun_changed{false};
+
+    // The autorun directory may not exist yet, don't retry a failed watch every frame.
+    if (m_autorun_watch == INVALID_HANDLE_VALUE) {
+        if (now >= m_next_autorun_watch_attempt) {
+            const auto autorun_path = REFramework::get_persistent_dir() / "reframework" / "autorun";
+
+            m_autorun_watch = FindFirstChangeNotificationW(autorun_path.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+            m_next_autorun_watch_attempt = now + std::chrono::seconds{1};
+        }
+    } else if (WaitForSingleObject(m_autorun_watch, 0) == WAIT_OBJECT_0) {
+        FindNextChangeNotification(m_autorun_watch);
+        autorun_changed = true;
+    }
+
+    // Scripts run from the file dialog live outside the watched directory, so everything
+    // also gets polled once a second. That covers the autorun scripts while the watch is down too.
+    if (!autorun_changed && now < m_next_script_poll) {
+        return;
+    }
+
+    m_next_script_poll = now + std::chrono::seconds{1};
+
+    std::vector<std::string> changed_scripts{};
+
+    for (const auto& name : m_loaded_scripts) {
+        auto it = m_script_write_times.find(name);
+
+        if (it == m_script_write_times.end()) {
+            continue;
+        }
+
+        std::error_code ec{};
+        const auto write_time = std::filesystem::last_write_time(m_script_paths[name], ec);
+
+        if (!ec && write_time != it->second) {
+            changed_scripts.push_back(name);
+        }
+    }
+
+    for (const auto& name : changed_scripts) {
+        reload_script(name);
+    }
+}
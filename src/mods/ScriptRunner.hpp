@@ -1,6 +1,7 @@
 #pragma once
 
 #include <deque>
+#include <filesystem>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -14,6 +15,7 @@
 
 #include "sdk/RETypeDB.hpp"
 #include "utility/FunctionHook.hpp"
+#include "utility/PointerMap.hpp"
 
 #include "Mod.hpp"
 
@@ -125,10 +127,25 @@ public:
         uint32_t gc_major_multiplier{100};
     };
 
+    // Native bookkeeping for an REManagedObject pushed into this state. See sol_lua_push in bindings/Sdk.cpp.
+    struct ManagedObjectRefs {
+        int32_t ref_count{};       // references we hold on the engine side
+        int32_t ephemeral_count{}; // pushes of objects we didn't add a reference to
+    };
+
     ScriptState(const GarbageCollectionData& gc_data);
     ~ScriptState();
 
+    static ScriptState* get(lua_State* l) {
+        return *(ScriptState**)lua_getextraspace(l);
+    }
+
     void run_script(const std::string& p);
+
+    // Removes every callback and hook that the script at p registered, after giving it a chance
+    // to save and clean up through its on_config_save and on_script_reset callbacks.
+    // Other scripts and the Lua state itself are left untouched.
+    void unload_script(const std::string& p);
     sol::protected_function_result handle_protected_result(sol::protected_function_result result); // because protected_functions don't throw
 
     void on_frame();
@@ -154,23 +171,64 @@ public:
 
     void gc_data_changed(GarbageCollectionData data);
 
+    auto& managed_object_refs() { return m_managed_object_refs; }
+
+    // Registry reference to the weak-valued table caching the userdata pushed for each object.
+    int managed_object_cache() const { return m_managed_object_cache; }
+
 private:
+    // Identifies the script file that registered a callback or hook. 0 means it isn't owned by any script file.
+    using ScriptId = uint32_t;
+
+    // Anything registered while a ScriptScope is alive gets attributed to its script. Scopes are opened
+    // around running a script file and around every callback invocation, so callbacks registered from
+    // inside other callbacks (or from required modules) still end up with the right owner.
+    struct ScriptScope {
+        ScriptScope(ScriptState* state, ScriptId id)
+            : state{state},
+            prev{state->m_current_script}
+        {
+            state->m_current_script = id;
+        }
+
+        ~ScriptScope() {
+            state->m_current_script = prev;
+        }
+
+        ScriptState* state;
+        ScriptId prev;
+    };
+
+    struct ScriptCallback {
+        ScriptId owner{};
+        sol::protected_function fn{};
+    };
+
+    ScriptId get_script_id(const std::string& p);
+
+    // Declared before m_lua, the finalizers that run when the Lua state closes still release through it.
+    utility::PointerMap<ManagedObjectRefs> m_managed_object_refs{4096};
+    int m_managed_object_cache{LUA_NOREF};
+
     sol::state m_lua{};
 
     GarbageCollectionData m_gc_data{};
 
     std::recursive_mutex m_execution_mutex{};
 
+    std::unordered_map<std::string, ScriptId> m_script_ids{};
+    ScriptId m_current_script{0};
+
     // FNV-1A
-    std::unordered_multimap<size_t, sol::protected_function> m_pre_application_entry_fns{};
-    std::unordered_multimap<size_t, sol::protected_function> m_application_entry_fns{};
+    std::unordered_multimap<size_t, ScriptCallback> m_pre_application_entry_fns{};
+    std::unordered_multimap<size_t, ScriptCallback> m_application_entry_fns{};
 
-    std::vector<sol::protected_function> m_pre_gui_draw_element_fns{};
-    std::vector<sol::protected_function> m_gui_draw_element_fns{};
-    std::vector<sol::protected_function> m_on_draw_ui_fns{};
-    std::vector<sol::protected_function> m_on_frame_fns{};
-    std::vector<sol::protected_function> m_on_script_reset_fns{};
-    std::vector<sol::protected_function> m_on_config_save_fns{};
+    std::vector<ScriptCallback> m_pre_gui_draw_element_fns{};
+    std::vector<ScriptCallback> m_gui_draw_element_fns{};
+    std::vector<ScriptCallback> m_on_draw_ui_fns{};
+    std::vector<ScriptCallback> m_on_frame_fns{};
+    std::vector<ScriptCallback> m_on_script_reset_fns{};
+    std::vector<ScriptCallback> m_on_config_save_fns{};
 
     struct HookDef {
         ::REManagedObject* obj{nullptr};
@@ -178,10 +236,16 @@ private:
         sol::protected_function pre_cb;
         sol::protected_function post_cb;
         sol::object ignore_jmp_obj;
+        ScriptId owner{};
+    };
+
+    struct InstalledHook {
+        HookManager::HookId id{};
+        ScriptId owner{};
     };
 
     std::deque<HookDef> m_hooks_to_add{};
-    std::unordered_map<sdk::REMethodDefinition*, std::vector<HookManager::HookId>> m_hooks{};
+    std::unordered_map<sdk::REMethodDefinition*, std::vector<InstalledHook>> m_hooks{};
 };
 
 class ScriptRunner : public Mod {
@@ -246,6 +310,13 @@ private:
     std::vector<std::string> m_known_scripts{};
     std::unordered_map<std::string, bool> m_loaded_scripts_map{};
 
+    // Full path and last write time of every known script, keyed by filename like the lists above.
+    std::unordered_map<std::string, std::string> m_script_paths{};
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_script_write_times{};
+    HANDLE m_autorun_watch{INVALID_HANDLE_VALUE};
+    std::chrono::steady_clock::time_point m_next_autorun_watch_attempt{};
+    std::chrono::steady_clock::time_point m_next_script_poll{};
+
     std::string m_last_script_error{};
     std::shared_mutex m_script_error_mutex{};
     std::chrono::system_clock::time_point m_last_script_error_time{};
@@ -253,6 +324,8 @@ private:
     bool m_console_spawned{false};
     bool m_needs_first_reset{true};
     const ModToggle::Ptr m_log_to_disk{ ModToggle::create(generate_name("LogToDisk"), false) };
+    const ModToggle::Ptr m_hot_reload{ ModToggle::create(generate_name("HotReload"), false) };
+    const ModToggle::Ptr m_defer_releases{ ModToggle::create(generate_name("DeferManagedObjectReleases"), false) };
 
     const ModCombo::Ptr m_gc_handler { 
         ModCombo::create(generate_name("GarbageCollectionHandlerV2"),
@@ -293,6 +366,8 @@ private:
 
     ValueList m_options{
         *m_log_to_disk,
+        *m_hot_reload,
+        *m_defer_releases,
         *m_gc_handler,
         *m_gc_type,
         *m_gc_mode,
@@ -303,5 +378,13 @@ private:
 
     // Resets the ScriptState and runs autorun scripts again.
     void reset_scripts();
+
+    // Incremental versions of reset_scripts that only touch a single script, by filename.
+    void load_script(const std::string& name);
+    void unload_script(const std::string& name);
+    void reload_script(const std::string& name);
+
+    // Reloads loaded autorun scripts whose files changed on disk. Only used when hot reload is enabled.
+    void check_for_script_changes();
 };
 
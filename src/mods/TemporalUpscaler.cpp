@@ -1257,8 +1257,8 @@ void TemporalUpscaler::update_extra_scene_layer() {
         scene_layers_output.num = 0;
     } else if (scene_layers.size() == 2 && scene_layers_output.size() == 1) {
         scene_layers_output[0] = (sdk::renderer::layer::Scene*)scene_layers[0];
-        if (scene_layers_output.num_allocated == 1) {
-            scene_layers_output.emplace();
+        if (scene_layers_output.num_allocated == 1 && scene_layers_output.emplace() == nullptr) {
+            return; // couldn't grow it, try again next frame.
         }
         scene_layers_output[1] = (sdk::renderer::layer::Scene*)scene_layers[1];
         m_made_extra_scene_layer = true;
@@ -765,9 +765,13 @@ float VR::get_sharpness_hook(void* tonemapping) {
 
 // Called when the mod is initialized
 std::optional<std::string> VR::on_initialize() try {
-    auto openvr_error = initialize_openvr();
+    // REFRAMEWORK_VR_MOCK=<path to a session recording> replays it instead of looking for a headset.
+    wchar_t mock_path[MAX_PATH]{};
+    const auto mock_path_length = GetEnvironmentVariableW(L"REFRAMEWORK_VR_MOCK", mock_path, MAX_PATH);
 
-    if (openvr_error || !m_openvr->loaded) {
+    if (mock_path_length > 0 && mock_path_length < MAX_PATH) {
+        initialize_mock(mock_path);
+    } else if (auto openvr_error = initialize_openvr(); openvr_error || !m_openvr->loaded) {
         if (m_openvr->error) {
             spdlog::info("OpenVR failed to load: {}", *m_openvr->error);
         }
@@ -893,6 +897,8 @@ void VR::on_lua_state_created(sol::state& lua) {
         "is_openxr_loaded", &VR::is_openxr_loaded,
         "is_hmd_active", &VR::is_hmd_active,
         "is_action_active", &VR::is_action_active,
+        "is_action_pressed", &VR::is_action_pressed,
+        "is_action_released", &VR::is_action_released,
         "is_using_hmd_oriented_audio", &VR::is_using_hmd_oriented_audio,
         "toggle_hmd_oriented_audio", &VR::toggle_hmd_oriented_audio,
         "apply_hmd_transform", [](VR* vr, glm::quat& rotation, Vector4f& position) {
@@ -912,6 +918,32 @@ void VR::on_lua_state_created(sol::state& lua) {
     lua["vrmod"] = this;
 }
 
+std::optional<std::string> VR::initialize_mock(const std::filesystem::path& path) {
+    m_mock = std::make_shared<runtimes::MockRuntime>();
+
+    if (auto err = m_mock->load(path)) {
+        spdlog::error("[VR] Failed to load the session recording for the mock runtime: {}", *err);
+        return std::nullopt;
+    }
+
+    // Action handles become indices into the recorded actions, offset by one so unrecorded actions stay 0.
+    // The input sources are hands, like with OpenXR.
+    for (auto& [name, handle] : m_action_handles) {
+        handle.get() = (vr::VRActionHandle_t)(m_mock->recording.find_action(name) + 1);
+    }
+
+    m_left_joystick = (decltype(m_left_joystick))VRRuntime::Hand::LEFT;
+    m_right_joystick = (decltype(m_right_joystick))VRRuntime::Hand::RIGHT;
+
+    m_runtime = m_mock;
+
+    spdlog::info("[VR] Replaying {} frames from {}", m_mock->recording.frames.size(), path.string());
+
+    detect_controllers();
+
+    return std::nullopt;
+}
+
 std::optional<std::string> VR::initialize_openvr() {
     m_openvr = std::make_shared<runtimes::OpenVR>();
     m_openvr->loaded = false;
@@ -1463,6 +1495,16 @@ bool VR::detect_controllers() {
 
         spdlog::info("Left Hand: {}", 1);
         spdlog::info("Right Hand: {}", 2);
+    } else if (get_runtime()->is_mock()) {
+        const auto& controllers = m_mock->recording.controllers;
+
+        m_controllers.push_back(controllers[VRRuntime::Hand::LEFT]);
+        m_controllers.push_back(controllers[VRRuntime::Hand::RIGHT]);
+        m_controllers_set.insert(controllers[VRRuntime::Hand::LEFT]);
+        m_controllers_set.insert(controllers[VRRuntime::Hand::RIGHT]);
+
+        spdlog::info("Left Hand: {}", controllers[VRRuntime::Hand::LEFT]);
+        spdlog::info("Right Hand: {}", controllers[VRRuntime::Hand::RIGHT]);
     }
 
 
@@ -1542,6 +1584,8 @@ void VR::update_hmd_state() {
 
     runtime->got_first_poses = true;
 
+    record_session_frame();
+
     // Forcefully update the camera transform after submitting the frame
     // because the game logic thread does not run in sync with the rendering thread
     // This will massively improve HMD rotation smoothness for the user
@@ -1578,6 +1622,176 @@ void VR::update_hmd_state() {
 #endif
 }
 
+void VR::record_session_frame() {
+    if (!m_session_recorder.is_recording()) {
+        return;
+    }
+
+    auto runtime = get_runtime();
+
+    // The frame captured last time has ended by now, tag it with what the runtime did with it.
+    if (const auto frame = runtime->telemetry.get_latest_frame(); frame && frame->index != m_last_flagged_telemetry_frame) {
+        m_last_flagged_telemetry_frame = frame->index;
+
+        if (!frame->submitted) {
+            m_session_recorder.flag_last_frame(vrmod::SessionRecording::DROPPED);
+        } else if (frame->missed) {
+            m_session_recorder.flag_last_frame(vrmod::SessionRecording::LATE_POSES);
+        }
+    }
+
+    std::array<uint64_t, 2> actions{};
+
+    // Only 64 action bits per hand, the recorder drops the names past that too.
+    for (size_t i = 0; i < std::min<size_t>(m_recorded_actions.size(), 64); ++i) {
+        const auto action = m_action_handles.at(m_recorded_actions[i]).get();
+
+        if (is_action_active(action, m_left_joystick)) {
+            actions[VRRuntime::Hand::LEFT] |= 1ull << i;
+        }
+
+        if (is_action_active(action, m_right_joystick)) {
+            actions[VRRuntime::Hand::RIGHT] |= 1ull << i;
+        }
+    }
+
+    const std::array<Vector2f, 2> sticks{ get_left_stick_axis(), get_right_stick_axis() };
+
+    m_session_recorder.capture(runtime->get_pose_snapshot(), sticks, actions);
+}
+
+void VR::draw_session_recorder_ui() {
+    if (!ImGui::TreeNode("Session Recorder")) {
+        return;
+    }
+
+    if (!m_session_recorder.is_recording()) {
+        if (ImGui::Button("Start Recording")) {
+            m_recorded_actions.clear();
+
+            for (const auto& [name, _] : m_action_handles) {
+                if (name.find("/in/") != std::string::npos) {
+                    m_recorded_actions.push_back(name);
+                }
+            }
+
+            std::sort(m_recorded_actions.begin(), m_recorded_actions.end());
+
+            std::array<uint32_t, 2> controllers{1, 2};
+
+            if (m_controllers.size() >= 2) {
+                controllers = {(uint32_t)m_controllers[0], (uint32_t)m_controllers[1]};
+            }
+
+            m_session_recorder.start(get_hmd_width(), get_hmd_height(), controllers, m_recorded_actions);
+        }
+    } else {
+        ImGui::Text("Recorded frames: %zu", m_session_recorder.size());
+
+        if (ImGui::Button("Stop and Save")) {
+            const auto path = REFramework::get_persistent_dir("vr_session.rfvr");
+            const auto recording = m_session_recorder.stop();
+
+            if (auto err = recording.save(path)) {
+                spdlog::error("[VR] Failed to save session recording: {}", *err);
+            } else {
+                spdlog::info("[VR] Saved {} frames to {}", recording.frames.size(), path.string());
+            }
+        }
+    }
+
+    ImGui::TreePop();
+}
+
+void VR::draw_frame_telemetry_ui() {
+    using vrmod::FrameTelemetry;
+
+    if (!ImGui::TreeNode("Frame Telemetry")) {
+        return;
+    }
+
+    auto& telemetry = get_runtime()->telemetry;
+    auto enabled = telemetry.enabled.load();
+
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+        telemetry.enabled = enabled;
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Clear")) {
+        telemetry.clear();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Export CSV")) {
+        const auto path = REFramework::get_persistent_dir("vr_frame_telemetry.csv");
+
+        if (telemetry.export_csv(path)) {
+            spdlog::info("[VR] Exported frame telemetry to {}", path.string());
+        } else {
+            spdlog::error("[VR] Failed to export frame telemetry to {}", path.string());
+        }
+    }
+
+    const auto frames = telemetry.get_frames();
+    const auto summary = telemetry.get_summary();
+
+    constexpr size_t NUM_BUCKETS = 64;
+    constexpr float BUCKET_MS = 0.5f;
+
+    std::vector<float> intervals{};
+    std::array<float, NUM_BUCKETS> buckets{};
+    intervals.reserve(frames.size());
+
+    for (const auto& frame : frames) {
+        intervals.push_back(frame.interval_ms);
+        buckets[std::min((size_t)(frame.interval_ms / BUCKET_MS), NUM_BUCKETS - 1)] += 1.0f;
+    }
+
+    ImGui::Text("Frames: %zu, missed: %zu", summary.frames, summary.missed);
+
+    if (!intervals.empty()) {
+        ImGui::PlotLines("Frame Interval (ms)", intervals.data(), (int)intervals.size(), 0, nullptr, 0.0f, summary.interval.p99 * 1.5f, ImVec2{0, 80});
+        ImGui::PlotHistogram("Interval Histogram (0.5ms)", buckets.data(), (int)buckets.size(), 0, nullptr, 0.0f, FLT_MAX, ImVec2{0, 80});
+    }
+
+    if (ImGui::BeginTable("Percentiles", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p90");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+
+        const auto row = [](const char* name, const FrameTelemetry::Percentiles& p) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", p.p50);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", p.p90);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", p.p99);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", p.max);
+        };
+
+        for (size_t s = 0; s < FrameTelemetry::NUM_STAGES; ++s) {
+            row(FrameTelemetry::get_stage_name((FrameTelemetry::Stage)s), summary.stages[s]);
+        }
+
+        row("Interval", summary.interval);
+        row("Pose to Submit", summary.pose_to_submit);
+
+        ImGui::EndTable();
+    }
+
+    ImGui::TreePop();
+}
+
 void VR::update_action_states() {
     REF_PROFILE_FUNCTION();
 
@@ -2373,17 +2587,12 @@ Vector4f VR::get_current_offset() {
         return Vector4f{};
     }
 
-    std::shared_lock _{ get_runtime()->eyes_mtx };
-
     const auto count = is_using_multipass() ? m_multipass.pass : m_frame_count;
+    const auto eye = count % 2 == m_left_eye_interval ? vr::Eye_Left : vr::Eye_Right;
 
-    if (count % 2 == m_left_eye_interval) {
-        //return Vector4f{m_eye_distance * -1.0f, 0.0f, 0.0f, 0.0f};
-        return get_runtime()->eyes[vr::Eye_Left][3];
-    }
-    
-    return get_runtime()->eyes[vr::Eye_Right][3];
-    //return Vector4f{m_eye_distance, 0.0f, 0.0f, 0.0f};
+    return get_runtime()->read_pose_snapshot([eye](const VRRuntime::PoseSnapshot& snapshot) {
+        return snapshot.eyes[eye][3];
+    });
 }
 
 Matrix4x4f VR::get_current_eye_transform(bool flip) {
@@ -2391,16 +2600,13 @@ Matrix4x4f VR::get_current_eye_transform(bool flip) {
         return glm::identity<Matrix4x4f>();
     }
 
-    std::shared_lock _{get_runtime()->eyes_mtx};
-
     const auto count = is_using_multipass() ? m_multipass.pass : m_frame_count;
     const auto mod_count = flip ? m_right_eye_interval : m_left_eye_interval;
+    const auto eye = count % 2 == mod_count ? vr::Eye_Left : vr::Eye_Right;
 
-    if (count % 2 == mod_count) {
-        return get_runtime()->eyes[vr::Eye_Left];
-    }
-
-    return get_runtime()->eyes[vr::Eye_Right];
+    return get_runtime()->read_pose_snapshot([eye](const VRRuntime::PoseSnapshot& snapshot) {
+        return snapshot.eyes[eye];
+    });
 }
 
 Matrix4x4f VR::get_current_projection_matrix(bool flip) {
@@ -2408,16 +2614,13 @@ Matrix4x4f VR::get_current_projection_matrix(bool flip) {
         return glm::identity<Matrix4x4f>();
     }
 
-    std::shared_lock _{get_runtime()->eyes_mtx};
-
     const auto count = is_using_multipass() ? m_multipass.pass : m_frame_count;
     const auto mod_count = flip ? m_right_eye_interval : m_left_eye_interval;
+    const auto eye = count % 2 == mod_count ? VRRuntime::Eye::LEFT : VRRuntime::Eye::RIGHT;
 
-    if (count % 2 == mod_count) {
-        return get_runtime()->projections[(uint32_t)VRRuntime::Eye::LEFT];
-    }
-
-    return get_runtime()->projections[(uint32_t)VRRuntime::Eye::RIGHT];
+    return get_runtime()->read_pose_snapshot([eye](const VRRuntime::PoseSnapshot& snapshot) {
+        return snapshot.projections[(uint32_t)eye];
+    });
 }
 
 Matrix4x4f VR::get_projection_matrix(uint32_t pass) {
@@ -2425,13 +2628,11 @@ Matrix4x4f VR::get_projection_matrix(uint32_t pass) {
         return glm::identity<Matrix4x4f>();
     }
 
-    std::shared_lock _{get_runtime()->eyes_mtx};
+    const auto eye = pass % 2 == 0 ? VRRuntime::Eye::LEFT : VRRuntime::Eye::RIGHT;
 
-    if (pass % 2 == 0) {
-        return get_runtime()->projections[(uint32_t)VRRuntime::Eye::LEFT];
-    }
-
-    return get_runtime()->projections[(uint32_t)VRRuntime::Eye::RIGHT];
+    return get_runtime()->read_pose_snapshot([eye](const VRRuntime::PoseSnapshot& snapshot) {
+        return snapshot.projections[(uint32_t)eye];
+    });
 }
 
 Matrix4x4f VR::get_eye_transform(uint32_t pass) {
@@ -2439,13 +2640,11 @@ Matrix4x4f VR::get_eye_transform(uint32_t pass) {
         return glm::identity<Matrix4x4f>();
     }
 
-    std::shared_lock _{get_runtime()->eyes_mtx};
-
-    if (pass % 2 == 0) {
-        return get_runtime()->eyes[vr::Eye_Left];
-    }
+    const auto eye = pass % 2 == 0 ? vr::Eye_Left : vr::Eye_Right;
 
-    return get_runtime()->eyes[vr::Eye_Right];
+    return get_runtime()->read_pose_snapshot([eye](const VRRuntime::PoseSnapshot& snapshot) {
+        return snapshot.eyes[eye];
+    });
 }
 
 void VR::on_pre_imgui_frame() {
@@ -2513,6 +2712,11 @@ void VR::on_present() {
     const auto renderer = g_framework->get_renderer_type();
     vr::EVRCompositorError e = vr::EVRCompositorError::VRCompositorError_None;
 
+    // OpenXR records its submit in end_frame.
+    if (runtime->is_openvr()) {
+        runtime->telemetry.begin(vrmod::FrameTelemetry::Stage::SUBMIT);
+    }
+
     if (renderer == REFramework::RendererType::D3D11) {
         // if we don't do this then D3D11 OpenXR freezes for some reason.
         if (!runtime->got_first_sync) {
@@ -2527,6 +2731,11 @@ void VR::on_present() {
         e = m_d3d12.on_frame(this);
     }
 
+    // Nothing to show the mock's frames on, they're submitted as soon as the last eye is rendered.
+    if (runtime->is_mock() && (is_using_multipass() || m_render_frame_count % 2 != m_left_eye_interval)) {
+        m_submitted = m_mock->submit() == VRRuntime::Error::SUCCESS;
+    }
+
     // force a waitgetposes call to fix this...
     if (e == vr::EVRCompositorError::VRCompositorError_AlreadySubmitted && runtime->is_openvr()) {
         openvr->got_first_poses = false;
@@ -2535,6 +2744,8 @@ void VR::on_present() {
 
     m_last_frame_count = m_render_frame_count;
 
+    const auto submitted = m_submitted;
+
     if (m_submitted || runtime->needs_pose_update) {
         if (m_submitted) {
             m_overlay_component.on_post_compositor_submit();
@@ -2549,6 +2760,14 @@ void VR::on_present() {
         m_submitted = false;
     }
 
+    if (runtime->is_openvr()) {
+        runtime->telemetry.end(vrmod::FrameTelemetry::Stage::SUBMIT);
+
+        if (submitted) {
+            runtime->telemetry.end_frame();
+        }
+    }
+
     if (is_using_multipass() || (m_render_frame_count + 1) % 2 == m_left_eye_interval) {
         SetEvent(m_present_finished_event);
     }
@@ -4036,8 +4255,12 @@ void VR::on_draw_ui() {
         ImGui::Separator();
     };
 
-    display_error(m_openxr, "openxr_loader.dll");
-    display_error(m_openvr, "openvr_api.dll");
+    if (m_mock != nullptr) {
+        display_error(m_mock, "");
+    } else {
+        display_error(m_openxr, "openxr_loader.dll");
+        display_error(m_openvr, "openvr_api.dll");
+    }
 
     if (!get_runtime()->loaded) {
         ImGui::TextWrapped("No runtime loaded.");
@@ -4069,6 +4292,9 @@ void VR::on_draw_ui() {
         if (m_resolution_scale->draw("Resolution Scale")) {
             m_openxr->resolution_scale = m_resolution_scale->value();
         }
+    } else if (get_runtime()->is_mock()) {
+        ImGui::TextWrapped("Replaying a %zu frame session recording", m_mock->recording.frames.size());
+        ImGui::TextWrapped("Played: %zu, dropped: %zu, late poses: %zu", m_mock->frames_played.load(), m_mock->frames_dropped.load(), m_mock->late_poses.load());
     }
     
     ImGui::Combo("Sync Mode", (int*)&get_runtime()->custom_stage, "Early\0Late\0Very Late\0");
@@ -4144,6 +4370,8 @@ void VR::on_draw_ui() {
     ImGui::Separator();
     ImGui::Text("Debug info");
     m_camera_duplicator.on_draw_ui();
+    draw_frame_telemetry_ui();
+    draw_session_recorder_ui();
     
 
     ImGui::Checkbox("Disable Projection Matrix Override", &m_disable_projection_matrix_override);
@@ -4233,34 +4461,36 @@ std::array<RECamera*, 2> VR::get_cameras() const {
 }
 
 Vector4f VR::get_position(uint32_t index) const {
-    if (index >= vr::k_unMaxTrackedDeviceCount) {
-        return Vector4f{};
-    }
+    return get_runtime()->read_pose_snapshot([index](const VRRuntime::PoseSnapshot& snapshot) {
+        if (index >= snapshot.num_devices || !snapshot.devices[index].valid) {
+            return Vector4f{};
+        }
 
-    std::shared_lock _{ get_runtime()->pose_mtx };
-    std::shared_lock __{ get_runtime()->eyes_mtx };
+        auto result = snapshot.devices[index].transform[3];
+        result.w = 1.0f;
 
-    return get_position_unsafe(index);
+        return result;
+    });
 }
 
 Vector4f VR::get_velocity(uint32_t index) const {
-    if (index >= vr::k_unMaxTrackedDeviceCount) {
-        return Vector4f{};
-    }
-
-    std::shared_lock _{ get_runtime()->pose_mtx };
+    return get_runtime()->read_pose_snapshot([index](const VRRuntime::PoseSnapshot& snapshot) {
+        if (index >= snapshot.num_devices || !snapshot.devices[index].valid) {
+            return Vector4f{};
+        }
 
-    return get_velocity_unsafe(index);
+        return snapshot.devices[index].velocity;
+    });
 }
 
 Vector4f VR::get_angular_velocity(uint32_t index) const {
-    if (index >= vr::k_unMaxTrackedDeviceCount) {
-        return Vector4f{};
-    }
-
-    std::shared_lock _{ get_runtime()->pose_mtx };
+    return get_runtime()->read_pose_snapshot([index](const VRRuntime::PoseSnapshot& snapshot) {
+        if (index >= snapshot.num_devices || !snapshot.devices[index].valid) {
+            return Vector4f{};
+        }
 
-    return get_angular_velocity_unsafe(index);
+        return snapshot.devices[index].angular_velocity;
+    });
 }
 
 Vector4f VR::get_position_unsafe(uint32_t index) const {
@@ -4288,7 +4518,10 @@ Vector4f VR::get_position_unsafe(uint32_t index) const {
         }
 
         return Vector4f{};
-    } 
+    } else if (get_runtime()->is_mock()) {
+        // The mock has no poses of its own besides the snapshot.
+        return get_position(index);
+    }
 
     return Vector4f{};
 }
@@ -4346,71 +4579,19 @@ Vector4f VR::get_angular_velocity_unsafe(uint32_t index) const {
 }
 
 Matrix4x4f VR::get_rotation(uint32_t index) const {
-    if (get_runtime()->is_openvr()) {
-        if (index >= vr::k_unMaxTrackedDeviceCount) {
-            return glm::identity<Matrix4x4f>();
-        }
-
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
-        auto& pose = get_openvr_poses()[index];
-        auto matrix = Matrix4x4f{ *(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking };
-        return glm::extractMatrixRotation(glm::rowMajor4(matrix));
-    } else if (get_runtime()->is_openxr()) {
-        std::shared_lock _{ get_runtime()->pose_mtx };
-        std::shared_lock __{ get_runtime()->eyes_mtx };
-
-        // HMD rotation
-        if (index == 0 && !m_openxr->stage_views.empty()) {
-            return Matrix4x4f{*(glm::quat*)&m_openxr->view_space_location.pose.orientation};
-            //return Matrix4x4f{*(glm::quat*)&m_openxr->stage_views[0].pose.orientation};
-        } else if (index > 0) {
-            if (index == VRRuntime::Hand::LEFT+1) {
-                return Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::LEFT].location.pose.orientation};
-            } else if (index == VRRuntime::Hand::RIGHT+1) {
-                return Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::RIGHT].location.pose.orientation};
-            }
-        }
-
-        return glm::identity<Matrix4x4f>();
-    }
+    const auto transform = get_transform(index);
 
-    return glm::identity<Matrix4x4f>();
+    return glm::extractMatrixRotation(transform);
 }
 
 Matrix4x4f VR::get_transform(uint32_t index) const {
-    if (get_runtime()->is_openvr()) {
-        if (index >= vr::k_unMaxTrackedDeviceCount) {
+    return get_runtime()->read_pose_snapshot([index](const VRRuntime::PoseSnapshot& snapshot) {
+        if (index >= snapshot.num_devices || !snapshot.devices[index].valid) {
             return glm::identity<Matrix4x4f>();
         }
 
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
-        auto& pose = get_openvr_poses()[index];
-        auto matrix = Matrix4x4f{ *(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking };
-        return glm::rowMajor4(matrix);
-    } else if (get_runtime()->is_openxr()) {
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
-        // HMD rotation
-        if (index == 0 && !m_openxr->stage_views.empty()) {
-            auto mat = Matrix4x4f{*(glm::quat*)&m_openxr->view_space_location.pose.orientation};
-            mat[3] = Vector4f{*(Vector3f*)&m_openxr->view_space_location.pose.position, 1.0f};
-            return mat;
-        } else if (index > 0) {
-            if (index == VRRuntime::Hand::LEFT+1) {
-                auto mat = Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::LEFT].location.pose.orientation};
-                mat[3] = Vector4f{*(Vector3f*)&m_openxr->hands[VRRuntime::Hand::LEFT].location.pose.position, 1.0f};
-                return mat;
-            } else if (index == VRRuntime::Hand::RIGHT+1) {
-                auto mat = Matrix4x4f{*(glm::quat*)&m_openxr->hands[VRRuntime::Hand::RIGHT].location.pose.orientation};
-                mat[3] = Vector4f{*(Vector3f*)&m_openxr->hands[VRRuntime::Hand::RIGHT].location.pose.position, 1.0f};
-                return mat;
-            }
-        }
-    }
-
-    return glm::identity<Matrix4x4f>();
+        return snapshot.devices[index].transform;
+    });
 }
 
 vr::HmdMatrix34_t VR::get_raw_transform(uint32_t index) const {
@@ -4443,6 +4624,8 @@ bool VR::is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t
         active = data.bActive && data.bState;
     } else if (get_runtime()->is_openxr()) {
         active = m_openxr->is_action_active((XrAction)action, (VRRuntime::Hand)source);
+    } else if (get_runtime()->is_mock()) {
+        active = m_mock->is_action_active((int32_t)action - 1, (VRRuntime::Hand)source);
     }
 
     if (!active && action == m_action_minimap) {
@@ -4452,6 +4635,44 @@ bool VR::is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t
     return active;
 }
 
+bool VR::is_action_pressed(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const {
+    if (!get_runtime()->loaded) {
+        return false;
+    }
+
+    if (get_runtime()->is_openvr()) {
+        vr::InputDigitalActionData_t data{};
+        vr::VRInput()->GetDigitalActionData(action, &data, sizeof(data), source);
+
+        return data.bActive && data.bState && data.bChanged;
+    } else if (get_runtime()->is_openxr()) {
+        return m_openxr->is_action_pressed((XrAction)action, (VRRuntime::Hand)source);
+    } else if (get_runtime()->is_mock()) {
+        return m_mock->is_action_pressed((int32_t)action - 1, (VRRuntime::Hand)source);
+    }
+
+    return false;
+}
+
+bool VR::is_action_released(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const {
+    if (!get_runtime()->loaded) {
+        return false;
+    }
+
+    if (get_runtime()->is_openvr()) {
+        vr::InputDigitalActionData_t data{};
+        vr::VRInput()->GetDigitalActionData(action, &data, sizeof(data), source);
+
+        return data.bActive && !data.bState && data.bChanged;
+    } else if (get_runtime()->is_openxr()) {
+        return m_openxr->is_action_released((XrAction)action, (VRRuntime::Hand)source);
+    } else if (get_runtime()->is_mock()) {
+        return m_mock->is_action_released((int32_t)action - 1, (VRRuntime::Hand)source);
+    }
+
+    return false;
+}
+
 Vector2f VR::get_joystick_axis(vr::VRInputValueHandle_t handle) const {
     if (!get_runtime()->loaded) {
         return Vector2f{};
@@ -4473,6 +4694,11 @@ Vector2f VR::get_joystick_axis(vr::VRInputValueHandle_t handle) const {
             auto out = m_openxr->get_right_stick_axis();
             return glm::length(out) > m_joystick_deadzone->value() ? out : Vector2f{};
         }
+    } else if (get_runtime()->is_mock()) {
+        if (handle <= (vr::VRInputValueHandle_t)VRRuntime::Hand::RIGHT) {
+            auto out = m_mock->get_stick_axis((VRRuntime::Hand)handle);
+            return glm::length(out) > m_joystick_deadzone->value() ? out : Vector2f{};
+        }
     }
 
     return Vector2f{};
@@ -22,7 +22,9 @@
 #include "vr/OverlayComponent.hpp"
 #include "vr/runtimes/OpenXR.hpp"
 #include "vr/runtimes/OpenVR.hpp"
+#include "vr/runtimes/MockRuntime.hpp"
 #include "vr/CameraDuplicator.hpp"
+#include "vr/SessionRecording.hpp"
 
 #include "Mod.hpp"
 
@@ -188,6 +190,9 @@ public:
     
     bool is_hand_behind_head(VRRuntime::Hand hand, float sensitivity = 0.2f) const;
     bool is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source = vr::k_ulInvalidInputValueHandle) const;
+    // Edges since the last input update.
+    bool is_action_pressed(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source = vr::k_ulInvalidInputValueHandle) const;
+    bool is_action_released(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source = vr::k_ulInvalidInputValueHandle) const;
     Vector2f get_joystick_axis(vr::VRInputValueHandle_t handle) const;
 
     Vector2f get_left_stick_axis() const;
@@ -296,6 +301,7 @@ private:
     std::optional<std::string> initialize_openxr();
     std::optional<std::string> initialize_openxr_input();
     std::optional<std::string> initialize_openxr_swapchains();
+    std::optional<std::string> initialize_mock(const std::filesystem::path& path);
     std::optional<std::string> hijack_resolution();
     std::optional<std::string> hijack_input();
     std::optional<std::string> hijack_camera();
@@ -351,6 +357,9 @@ private:
     bool detect_controllers();
     bool is_any_action_down();
     void update_hmd_state();
+    void record_session_frame();
+    void draw_session_recorder_ui();
+    void draw_frame_telemetry_ui();
     void update_action_states();
     void update_camera(); // if not in firstperson mode
     void update_camera_origin(); // every frame
@@ -392,6 +401,7 @@ private:
     std::shared_ptr<VRRuntime> m_runtime{std::make_shared<VRRuntime>()}; // will point to the real runtime if it exists
     std::shared_ptr<runtimes::OpenVR> m_openvr{std::make_shared<runtimes::OpenVR>()};
     std::shared_ptr<runtimes::OpenXR> m_openxr{std::make_shared<runtimes::OpenXR>()};
+    std::shared_ptr<runtimes::MockRuntime> m_mock{}; // only created when replaying a session recording
 
     Vector4f m_standing_origin{ 0.0f, 1.5f, 0.0f, 0.0f };
     glm::quat m_rotation_offset{ glm::identity<glm::quat>() };
@@ -483,6 +493,10 @@ private:
     vrmod::OverlayComponent m_overlay_component{};
     vrmod::CameraDuplicator m_camera_duplicator{};
 
+    vrmod::SessionRecorder m_session_recorder{};
+    std::vector<std::string> m_recorded_actions{}; // in the order their bits are recorded in
+    uint64_t m_last_flagged_telemetry_frame{UINT64_MAX};
+
     template <typename T> using ComPtr = Microsoft::WRL::ComPtr<T>;
 
     struct MultiPass {
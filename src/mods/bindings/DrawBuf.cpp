@@ -0,0 +1,178 @@
+#include <algorithm>
+
+#include <imgui.h>
+
+#include <sdk/Renderer.hpp>
+
+#include "../ScriptRunner.hpp"
+
+#include "VecBuf.hpp"
+#include "DrawBuf.hpp"
+
+namespace api::drawbuf {
+namespace detail {
+Vector4f get_point(sol::object obj, bool& world, const char* fn) {
+    if (obj.is<Vector2f>()) {
+        world = false;
+        const auto& v = obj.as<Vector2f&>();
+        return Vector4f{v.x, v.y, 0.0f, 1.0f};
+    }
+
+    world = true;
+
+    if (obj.is<Vector3f>()) {
+        return Vector4f{obj.as<Vector3f&>(), 1.0f};
+    }
+
+    if (obj.is<Vector4f>()) {
+        return obj.as<Vector4f>();
+    }
+
+    throw sol::error{std::string{"DrawBuf:"} + fn + ": expected a Vector2f (screen) or Vector3f/Vector4f (world) position"};
+}
+
+void add(DrawBuf& buf, Primitive type, std::initializer_list<sol::object> points, uint32_t color, float size, bool filled, int segments, const char* fn) {
+    Command cmd{};
+    cmd.type = type;
+    cmd.color = color;
+    cmd.size = size;
+    cmd.segments = (uint16_t)std::clamp(segments, 0, 512);
+    cmd.first_point = (uint32_t)buf.points.size();
+
+    bool first = true;
+    bool world = false;
+
+    for (const auto& obj : points) {
+        bool is_world = false;
+        buf.points.push_back(get_point(obj, is_world, fn));
+
+        if (!first && is_world != world) {
+            buf.points.resize(cmd.first_point);
+            throw sol::error{std::string{"DrawBuf:"} + fn + ": can't mix screen and world positions"};
+        }
+
+        world = is_world;
+        first = false;
+    }
+
+    cmd.flags = (uint8_t)((world ? Flags::WORLD : 0) | (filled ? Flags::FILLED : 0));
+    buf.commands.push_back(cmd);
+}
+
+std::span<Vector4f> get_points_buffer(sol::object obj, const char* fn) {
+    if (!obj.is<api::vecbuf::VecBuf&>()) {
+        throw sol::error{std::string{"DrawBuf:"} + fn + ": expected a VEC3 or VEC4 vecbuf"};
+    }
+
+    auto& vb = obj.as<api::vecbuf::VecBuf&>();
+
+    if (vb.type != api::vecbuf::Type::VEC3 && vb.type != api::vecbuf::Type::VEC4) {
+        throw sol::error{std::string{"DrawBuf:"} + fn + ": expected a VEC3 or VEC4 vecbuf"};
+    }
+
+    return vb.vec4s();
+}
+
+// Same default as the immediate draw.*_circle functions.
+int get_segments(sol::object obj) {
+    return obj.is<int>() ? obj.as<int>() : 32;
+}
+}
+
+void line(DrawBuf& buf, sol::object a, sol::object b, uint32_t color, sol::object thickness) {
+    detail::add(buf, Primitive::LINE, {a, b}, color, thickness.is<float>() ? thickness.as<float>() : 1.0f, false, 0, "line");
+}
+
+void rect(DrawBuf& buf, sol::object min, sol::object max, uint32_t color, sol::object filled) {
+    detail::add(buf, Primitive::RECT, {min, max}, color, 1.0f, filled.is<bool>() && filled.as<bool>(), 0, "rect");
+}
+
+void quad(DrawBuf& buf, sol::object p1, sol::object p2, sol::object p3, sol::object p4, uint32_t color, sol::object filled) {
+    detail::add(buf, Primitive::QUAD, {p1, p2, p3, p4}, color, 1.0f, filled.is<bool>() && filled.as<bool>(), 0, "quad");
+}
+
+void circle(DrawBuf& buf, sol::object center, float radius, uint32_t color, sol::object filled, sol::object segments) {
+    detail::add(buf, Primitive::CIRCLE, {center}, color, radius, filled.is<bool>() && filled.as<bool>(), detail::get_segments(segments), "circle");
+}
+
+void text(DrawBuf& buf, sol::object pos, const std::string& str, uint32_t color) {
+    detail::add(buf, Primitive::TEXT, {pos}, color, 1.0f, false, 0, "text");
+
+    auto& cmd = buf.commands.back();
+    cmd.text_offset = (uint32_t)buf.text.size();
+    cmd.text_length = (uint32_t)str.size();
+    buf.text += str;
+}
+
+// World space lines between consecutive pairs of points.
+void lines(DrawBuf& buf, sol::object points_obj, uint32_t color, sol::object thickness) {
+    const auto points = detail::get_points_buffer(points_obj, "lines");
+    const auto size = thickness.is<float>() ? thickness.as<float>() : 1.0f;
+
+    for (size_t i = 0; i + 1 < points.size(); i += 2) {
+        Command cmd{};
+        cmd.type = Primitive::LINE;
+        cmd.flags = Flags::WORLD;
+        cmd.color = color;
+        cmd.size = size;
+        cmd.first_point = (uint32_t)buf.points.size();
+
+        buf.points.push_back(Vector4f{Vector3f{points[i]}, 1.0f});
+        buf.points.push_back(Vector4f{Vector3f{points[i + 1]}, 1.0f});
+        buf.commands.push_back(cmd);
+    }
+}
+
+// A world space circle around every point.
+void circles(DrawBuf& buf, sol::object points_obj, float radius, uint32_t color, sol::object filled, sol::object segments) {
+    const auto points = detail::get_points_buffer(points_obj, "circles");
+    const auto is_filled = filled.is<bool>() && filled.as<bool>();
+
+    Command cmd{};
+    cmd.type = Primitive::CIRCLE;
+    cmd.flags = (uint8_t)(Flags::WORLD | (is_filled ? Flags::FILLED : 0));
+    cmd.color = color;
+    cmd.size = radius;
+    cmd.segments = (uint16_t)std::clamp(detail::get_segments(segments), 0, 512);
+
+    buf.commands.reserve(buf.commands.size() + points.size());
+    buf.points.reserve(buf.points.size() + points.size());
+
+    for (const auto& p : points) {
+        cmd.first_point = (uint32_t)buf.points.size();
+        buf.points.push_back(Vector4f{Vector3f{p}, 1.0f});
+        buf.commands.push_back(cmd);
+    }
+}
+
+size_t submit_to_background(DrawBuf& buf) {
+    return submit(buf, ImGui::GetBackgroundDrawList(), sdk::renderer::get_camera_snapshot());
+}
+}
+
+void bindings::open_drawbuf(ScriptState* s) {
+    auto& lua = s->lua();
+    auto drawbuf = lua.create_table();
+
+    drawbuf.new_usertype<api::drawbuf::DrawBuf>("DrawBuf",
+        sol::no_constructor,
+        sol::meta_function::length, [](api::drawbuf::DrawBuf& buf) { return buf.commands.size(); },
+        "size", [](api::drawbuf::DrawBuf& buf) { return buf.commands.size(); },
+        "clear", [](api::drawbuf::DrawBuf& buf) { buf.clear(); },
+        "line", api::drawbuf::line,
+        "rect", api::drawbuf::rect,
+        "quad", api::drawbuf::quad,
+        "circle", api::drawbuf::circle,
+        "text", api::drawbuf::text,
+        "lines", api::drawbuf::lines,
+        "circles", api::drawbuf::circles,
+        "submit", api::drawbuf::submit_to_background
+    );
+
+    drawbuf["new"] = []() { return api::drawbuf::DrawBuf{}; };
+    lua["drawbuf"] = drawbuf;
+
+    // draw is created by open_imgui, which runs first.
+    lua["draw"]["submit"] = api::drawbuf::submit_to_background;
+}
+
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sdk/Math.hpp>
+
+class ScriptState;
+struct ImDrawList;
+
+namespace sdk::renderer {
+struct CameraSnapshot;
+}
+
+namespace bindings {
+void open_drawbuf(ScriptState* s);
+}
+
+namespace api::drawbuf {
+enum class Primitive : uint8_t {
+    LINE,
+    RECT,
+    QUAD,
+    CIRCLE,
+    TEXT,
+};
+
+enum Flags : uint8_t {
+    WORLD = 1 << 0, // points are world positions, projected on submit
+    FILLED = 1 << 1,
+};
+
+struct Command {
+    Primitive type{Primitive::LINE};
+    uint8_t flags{0};
+    uint16_t segments{0};
+    uint32_t color{0xFFFFFFFF};
+    float size{1.0f}; // line thickness or circle radius, in world units for world circles
+    uint32_t first_point{0};
+    uint32_t text_offset{0};
+    uint32_t text_length{0};
+};
+
+// A retained list of draw commands. Scripts fill it whenever what they draw changes
+// and submit it every frame, instead of crossing into C++ once per primitive.
+struct DrawBuf {
+    std::vector<Command> commands{};
+    std::vector<Vector4f> points{};
+    std::string text{};
+
+    static uint32_t num_points(Primitive p) {
+        switch (p) {
+        case Primitive::LINE:
+        case Primitive::RECT:
+            return 2;
+        case Primitive::QUAD:
+            return 4;
+        default:
+            return 1;
+        }
+    }
+
+    void clear() {
+        commands.clear();
+        points.clear();
+        text.clear();
+    }
+};
+
+// Projects every world space point in one batch with the given camera and writes the
+// vertices straight into draw_list. World space commands with a point behind the camera are skipped.
+// Returns the number of commands drawn.
+size_t submit(const DrawBuf& buf, ImDrawList* draw_list, const sdk::renderer::CameraSnapshot& camera);
+}
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <sdk/MathBatch.hpp>
+#include <sdk/renderer/CameraSnapshot.hpp>
+
+#include "DrawBuf.hpp"
+
+// The part of DrawBuf that turns commands into ImGui vertices. Kept free of Lua and
+// the renderer so it can be tested against a bare ImDrawList.
+namespace api::drawbuf {
+namespace detail {
+// Reused between submits.
+struct Scratch {
+    std::vector<Vector4f> world{};
+    std::vector<Vector2f> screen{};
+    std::vector<uint8_t> visible{};
+    std::vector<uint32_t> first_projected{}; // per command, index into world or ~0 for screen space
+};
+
+Scratch& get_scratch() {
+    thread_local Scratch scratch{};
+    return scratch;
+}
+
+// A thickness wide quad around a -> b, no anti-aliasing fringe.
+void prim_line(ImDrawList* draw_list, const ImVec2& a, const ImVec2& b, ImU32 color, float thickness, const ImVec2& uv) {
+    const auto d = b - a;
+    const auto len2 = d.x * d.x + d.y * d.y;
+
+    if (len2 <= 0.0f) {
+        return;
+    }
+
+    const auto scale = 0.5f * thickness / std::sqrt(len2);
+    const auto n = ImVec2{-d.y * scale, d.x * scale};
+
+    draw_list->PrimReserve(6, 4);
+    draw_list->PrimQuadUV(a + n, b + n, b - n, a - n, uv, uv, uv, uv, color);
+}
+
+void prim_outline(ImDrawList* draw_list, const ImVec2* pts, size_t count, ImU32 color, float thickness, const ImVec2& uv) {
+    for (size_t i = 0; i < count; ++i) {
+        prim_line(draw_list, pts[i], pts[(i + 1) % count], color, thickness, uv);
+    }
+}
+}
+
+size_t submit(const DrawBuf& buf, ImDrawList* draw_list, const sdk::renderer::CameraSnapshot& camera) {
+    if (draw_list == nullptr || buf.commands.empty()) {
+        return 0;
+    }
+
+    auto& scratch = detail::get_scratch();
+    scratch.world.clear();
+    scratch.first_projected.resize(buf.commands.size());
+
+    // Camera right axis in world space, used to turn world radii into screen radii.
+    const auto right = Vector3f{camera.view[0][0], camera.view[1][0], camera.view[2][0]};
+
+    // Gather every world space point (plus one on the rim of each world circle) so they get projected in one go.
+    for (size_t i = 0; i < buf.commands.size(); ++i) {
+        const auto& cmd = buf.commands[i];
+
+        if ((cmd.flags & Flags::WORLD) == 0 || !camera.valid) {
+            scratch.first_projected[i] = ~0u;
+            continue;
+        }
+
+        scratch.first_projected[i] = (uint32_t)scratch.world.size();
+
+        const auto n = DrawBuf::num_points(cmd.type);
+
+        for (uint32_t j = 0; j < n; ++j) {
+            scratch.world.push_back(buf.points[cmd.first_point + j]);
+        }
+
+        if (cmd.type == Primitive::CIRCLE) {
+            const auto& center = buf.points[cmd.first_point];
+            scratch.world.push_back(Vector4f{Vector3f{center} + right * cmd.size, 1.0f});
+        }
+    }
+
+    scratch.screen.resize(scratch.world.size());
+    scratch.visible.resize(scratch.world.size());
+
+    if (!scratch.world.empty()) {
+        utility::math::batch::project_to_screen(scratch.world, camera.view_proj, camera.screen_size, false, scratch.screen, scratch.visible);
+    }
+
+    const auto uv = ImGui::GetFontTexUvWhitePixel();
+    size_t drawn = 0;
+
+    for (size_t i = 0; i < buf.commands.size(); ++i) {
+        const auto& cmd = buf.commands[i];
+        const auto n = DrawBuf::num_points(cmd.type);
+        const auto world = (cmd.flags & Flags::WORLD) != 0;
+
+        if (world && !camera.valid) {
+            continue;
+        }
+
+        ImVec2 pts[5]{};
+        bool visible = true;
+
+        for (uint32_t j = 0; j < n + (world && cmd.type == Primitive::CIRCLE ? 1 : 0); ++j) {
+            if (world) {
+                const auto k = scratch.first_projected[i] + j;
+                visible = visible && scratch.visible[k] != 0;
+                pts[j] = ImVec2{scratch.screen[k].x, scratch.screen[k].y};
+            } else {
+                const auto& p = buf.points[cmd.first_point + j];
+                pts[j] = ImVec2{p.x, p.y};
+            }
+        }
+
+        if (!visible) {
+            continue;
+        }
+
+        const auto color = (ImU32)cmd.color;
+        const auto filled = (cmd.flags & Flags::FILLED) != 0;
+
+        switch (cmd.type) {
+        case Primitive::LINE:
+            detail::prim_line(draw_list, pts[0], pts[1], color, cmd.size, uv);
+            break;
+        case Primitive::RECT:
+            if (filled) {
+                draw_list->PrimReserve(6, 4);
+                draw_list->PrimRect(ImMin(pts[0], pts[1]), ImMax(pts[0], pts[1]), color);
+            } else {
+                const ImVec2 corners[4]{pts[0], ImVec2{pts[1].x, pts[0].y}, pts[1], ImVec2{pts[0].x, pts[1].y}};
+                detail::prim_outline(draw_list, corners, 4, color, cmd.size, uv);
+            }
+            break;
+        case Primitive::QUAD:
+            if (filled) {
+                draw_list->PrimReserve(6, 4);
+                draw_list->PrimQuadUV(pts[0], pts[1], pts[2], pts[3], uv, uv, uv, uv, color);
+            } else {
+                detail::prim_outline(draw_list, pts, 4, color, cmd.size, uv);
+            }
+            break;
+        case Primitive::CIRCLE: {
+            const auto radius = world ? std::sqrt(ImLengthSqr(pts[1] - pts[0])) : cmd.size;
+
+            if (filled) {
+                draw_list->AddCircleFilled(pts[0], radius, color, cmd.segments);
+            } else {
+                draw_list->AddCircle(pts[0], radius, color, cmd.segments);
+            }
+            break;
+        }
+        case Primitive::TEXT: {
+            const auto begin = buf.text.data() + cmd.text_offset;
+            draw_list->AddText(pts[0], color, begin, begin + cmd.text_length);
+            break;
+        }
+        default:
+            continue;
+        }
+
+        ++drawn;
+    }
+
+    return drawn;
+}
+}
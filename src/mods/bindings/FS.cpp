@@ -1,7 +1,15 @@
+#include <cctype>
+#include <chrono>
 #include <filesystem>
 #include <regex>
 #include <fstream>
 #include <filesystem>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
 
 #include "../ScriptRunner.hpp"
 
@@ -52,29 +60,240 @@ namespace detail {
 
     return out;
 }
+
+bool is_separator(char c) {
+    return c == '\\' || c == '/';
 }
 
-sol::table glob(sol::this_state l, const char* filter) {
-    sol::state_view state{l};
-    std::regex filter_regex{filter};
-    auto results = state.create_table();
-    auto datadir = detail::get_datadir();
-    auto i = 0;
+// Glob-style matching against a relative path. "*" matches within a single path component,
+// "**" matches across components ("**/" also matches nothing), "?" matches one character.
+// Either slash matches either separator and ASCII letters compare case-insensitively, like the filesystem.
+bool wildcard_match(std::string_view pattern, std::string_view str) {
+    thread_local std::vector<uint8_t> prev{}, next{};
+
+    prev.assign(str.size() + 1, 0);
+    next.assign(str.size() + 1, 0);
+    prev[0] = 1;
+
+    for (size_t p = 0; p < pattern.size(); ++p) {
+        const auto c = pattern[p];
+
+        if (c == '*' && p + 1 < pattern.size() && pattern[p + 1] == '*') {
+            ++p;
+
+            const auto consume_separator = p + 1 < pattern.size() && is_separator(pattern[p + 1]);
+
+            if (consume_separator) {
+                ++p;
+
+                // "**/" - either nothing, or anything that ends with a separator.
+                bool any = false;
+
+                for (size_t j = 0; j <= str.size(); ++j) {
+                    next[j] = prev[j] || (j > 0 && any && is_separator(str[j - 1]));
+                    any = any || prev[j];
+                }
+            } else {
+                for (size_t j = 0; j <= str.size(); ++j) {
+                    next[j] = prev[j] || (j > 0 && next[j - 1]);
+                }
+            }
+        } else if (c == '*') {
+            for (size_t j = 0; j <= str.size(); ++j) {
+                next[j] = prev[j] || (j > 0 && next[j - 1] && !is_separator(str[j - 1]));
+            }
+        } else {
+            next[0] = 0;
+
+            for (size_t j = 1; j <= str.size(); ++j) {
+                const auto s = str[j - 1];
+                bool matches = false;
+
+                if (c == '?') {
+                    matches = !is_separator(s);
+                } else if (is_separator(c)) {
+                    matches = is_separator(s);
+                } else {
+                    matches = std::tolower((unsigned char)c) == std::tolower((unsigned char)s);
+                }
+
+                next[j] = prev[j - 1] && matches;
+            }
+        }
+
+        std::swap(prev, next);
+    }
+
+    return prev[str.size()] != 0;
+}
+
+// Cached listing of every file under the data directory, plus cached glob results.
+// The listing is rebuilt lazily once a change notification fires on the directory tree
+// (or when one of our own write APIs touches it), so repeated globs don't hit the disk.
+class DataIndex {
+public:
+    enum class PatternType : uint8_t {
+        REGEX,
+        WILDCARD,
+    };
+
+    static DataIndex& get() {
+        static DataIndex index{};
+        return index;
+    }
+
+    ~DataIndex() {
+        if (m_watch != INVALID_HANDLE_VALUE) {
+            FindCloseChangeNotification(m_watch);
+        }
+    }
+
+    void invalidate() {
+        std::scoped_lock _{m_mtx};
+        m_dirty = true;
+    }
+
+    std::vector<std::string> glob(const std::string& pattern, PatternType type) {
+        std::scoped_lock _{m_mtx};
+
+        refresh();
+
+        auto key = std::string{type == PatternType::REGEX ? "r:" : "w:"} + pattern;
+
+        if (auto it = m_results.find(key); it != m_results.end()) {
+            return it->second;
+        }
+
+        std::vector<std::string> matches{};
+
+        if (type == PatternType::REGEX) {
+            const auto& filter_regex = get_regex(pattern);
+
+            for (const auto& relpath : m_files) {
+                if (std::regex_match(relpath, filter_regex)) {
+                    matches.push_back(relpath);
+                }
+            }
+        } else {
+            for (const auto& relpath : m_files) {
+                if (wildcard_match(pattern, relpath)) {
+                    matches.push_back(relpath);
+                }
+            }
+        }
+
+        if (m_results.size() >= MAX_CACHED_RESULTS) {
+            m_results.clear();
+        }
 
-    for (const auto& entry : ::fs::recursive_directory_iterator{datadir}) {
-        if (!entry.is_regular_file()) {
-            continue;
+        m_results.emplace(std::move(key), matches);
+
+        return matches;
+    }
+
+private:
+    static constexpr size_t MAX_CACHED_RESULTS = 256;
+    static constexpr size_t MAX_CACHED_REGEXES = 64;
+
+    // How long the listing is trusted when the directory can't be watched.
+    static constexpr std::chrono::seconds UNWATCHED_MAX_AGE{1};
+
+    const std::regex& get_regex(const std::string& pattern) {
+        if (auto it = m_regexes.find(pattern); it != m_regexes.end()) {
+            return it->second;
+        }
+
+        // Compile first so a bad pattern throws before we touch the cache.
+        std::regex filter_regex{pattern};
+
+        if (m_regexes.size() >= MAX_CACHED_REGEXES) {
+            m_regexes.clear();
+        }
+
+        return m_regexes.emplace(pattern, std::move(filter_regex)).first->second;
+    }
+
+    bool poll_changes(const ::fs::path& datadir) {
+        if (m_watch == INVALID_HANDLE_VALUE && !m_watch_failed) {
+            m_watch = FindFirstChangeNotificationW(datadir.c_str(), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+
+            if (m_watch == INVALID_HANDLE_VALUE) {
+                spdlog::warn("[FS] Failed to watch {} for changes ({}), fs.glob results may be up to {}s old", datadir.string(), GetLastError(), UNWATCHED_MAX_AGE.count());
+                m_watch_failed = true;
+            }
+
+            // Anything could have changed before the watcher was set up.
+            return true;
+        }
+
+        // Don't retry the watcher on every call, just rescan once the listing is old enough.
+        if (m_watch == INVALID_HANDLE_VALUE) {
+            return std::chrono::steady_clock::now() - m_last_scan >= UNWATCHED_MAX_AGE;
+        }
+
+        if (WaitForSingleObject(m_watch, 0) == WAIT_OBJECT_0) {
+            // Re-arm before rescanning so anything that changes during the scan is picked up next time.
+            FindNextChangeNotification(m_watch);
+            return true;
+        }
+
+        return false;
+    }
+
+    void refresh() {
+        const auto datadir = get_datadir();
+        const auto changed = poll_changes(datadir);
+
+        if (!changed && !m_dirty) {
+            return;
         }
 
-        auto relpath = relative(entry.path(), datadir).string();
+        m_dirty = false;
+        m_last_scan = std::chrono::steady_clock::now();
+        m_files.clear();
+        m_results.clear();
 
-        if (std::regex_match(relpath, filter_regex)) {
-            results[++i] = relpath;
+        for (const auto& entry : ::fs::recursive_directory_iterator{datadir}) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            m_files.push_back(relative(entry.path(), datadir).string());
         }
     }
 
+    std::mutex m_mtx{};
+    HANDLE m_watch{INVALID_HANDLE_VALUE};
+    bool m_watch_failed{false};
+    bool m_dirty{true};
+    std::chrono::steady_clock::time_point m_last_scan{};
+
+    std::vector<std::string> m_files{};
+    std::unordered_map<std::string, std::regex> m_regexes{};
+    std::unordered_map<std::string, std::vector<std::string>> m_results{};
+};
+
+sol::table to_table(sol::this_state l, const std::vector<std::string>& paths) {
+    sol::state_view state{l};
+    auto results = state.create_table(paths.size(), 0);
+    auto i = 0;
+
+    for (const auto& relpath : paths) {
+        results[++i] = relpath;
+    }
+
     return results;
 }
+}
+
+sol::table glob(sol::this_state l, const char* filter) {
+    return detail::to_table(l, detail::DataIndex::get().glob(filter, detail::DataIndex::PatternType::REGEX));
+}
+
+// Same as glob, but takes a wildcard pattern like "mymod/**/*.json" instead of a regex.
+sol::table glob_wildcard(sol::this_state l, const char* pattern) {
+    return detail::to_table(l, detail::DataIndex::get().glob(pattern, detail::DataIndex::PatternType::WILDCARD));
+}
 
 void write(sol::this_state l, const std::string& filepath, const std::string& data) {
     if (filepath.find("..") != std::string::npos) {
@@ -102,6 +321,8 @@ void write(sol::this_state l, const std::string& filepath, const std::string& da
     std::ofstream file{path};
 
     file << data;
+
+    detail::DataIndex::get().invalidate();
 }
 
 std::string read(sol::this_state l, const std::string& filepath) {
@@ -173,6 +394,7 @@ void bindings::open_fs(ScriptState* s) {
     auto fs = lua.create_table();
 
     fs["glob"] = api::fs::glob;
+    fs["glob_wildcard"] = api::fs::glob_wildcard;
     fs["write"] = api::fs::write;
     fs["read"] = api::fs::read;
     lua["fs"] = fs;
@@ -196,6 +418,12 @@ void bindings::open_fs(ScriptState* s) {
 
         ::fs::create_directories(path->parent_path());
 
+        // Only opens that can create a file change the listing, reading configs every frame
+        // shouldn't throw the glob cache away.
+        if (mode.is<std::string>() && mode.as<std::string>().find_first_of("wa+") != std::string::npos) {
+            api::fs::detail::DataIndex::get().invalidate();
+        }
+
         return old_open(path->string().c_str(), mode);
     };
 
@@ -301,6 +529,7 @@ void bindings::open_fs(ScriptState* s) {
         }
 
         ::fs::create_directories(path->parent_path());
+        api::fs::detail::DataIndex::get().invalidate();
 
         return old_output(path->string().c_str());
     };
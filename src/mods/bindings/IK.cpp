@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <sstream>
+
+#include <sdk/IK.hpp>
+
+#include "../ScriptRunner.hpp"
+
+#include "VecBuf.hpp"
+#include "IK.hpp"
+
+namespace api::ik {
+namespace detail {
+using api::vecbuf::Type;
+using api::vecbuf::VecBuf;
+
+VecBuf& expect_points(sol::object obj, const char* fn, const char* name) {
+    if (!obj.is<VecBuf*>()) {
+        throw sol::error{(std::stringstream{} << "ik." << fn << ": " << name << " must be a vecbuf").str()};
+    }
+
+    auto& buf = *obj.as<VecBuf*>();
+
+    if (buf.type != Type::VEC3 && buf.type != Type::VEC4) {
+        throw sol::error{(std::stringstream{} << "ik." << fn << ": " << name << " must hold vec3 or vec4 elements").str()};
+    }
+
+    return buf;
+}
+
+// Same rules as the vecbuf methods, a new buffer is created if the script didn't pass one.
+VecBuf& get_output(sol::this_state s, sol::object out_obj, Type type, size_t count, sol::object& holder) {
+    if (out_obj.is<VecBuf*>()) {
+        holder = out_obj;
+    } else {
+        holder = sol::make_object(s, VecBuf{type, count});
+    }
+
+    auto& out = *holder.as<VecBuf*>();
+
+    if (out.type != Type::VEC3 && out.type != Type::VEC4) {
+        throw sol::error{"ik: output buffer must hold vec3 or vec4 elements"};
+    }
+
+    out.resize(count);
+    return out;
+}
+}
+
+// ik.solve_batch(root, mid, end, target, [pole], [opts]) -> out_mid, out_end, num_reached
+// opts: { min_bend = radians, max_bend = radians, out_mid = vecbuf, out_end = vecbuf }
+std::tuple<sol::object, sol::object, size_t> solve_batch(sol::this_state s, sol::object root_obj, sol::object mid_obj, sol::object end_obj,
+    sol::object target_obj, sol::object pole_obj, sol::object opts_obj)
+{
+    auto& root = detail::expect_points(root_obj, "solve_batch", "root");
+    auto& mid = detail::expect_points(mid_obj, "solve_batch", "mid");
+    auto& end = detail::expect_points(end_obj, "solve_batch", "end");
+    auto& target = detail::expect_points(target_obj, "solve_batch", "target");
+
+    auto count = std::min({root.count, mid.count, end.count, target.count});
+    std::span<const Vector4f> pole{};
+
+    if (pole_obj.valid() && pole_obj != sol::lua_nil) {
+        auto& pole_buf = detail::expect_points(pole_obj, "solve_batch", "pole");
+        pole = pole_buf.vec4s();
+        count = std::min(count, pole_buf.count);
+    }
+
+    utility::math::ik::TwoBoneLimits limits{};
+    sol::object out_mid_obj{};
+    sol::object out_end_obj{};
+
+    if (opts_obj.is<sol::table>()) {
+        auto opts = opts_obj.as<sol::table>();
+
+        limits.min_bend = opts.get_or("min_bend", limits.min_bend);
+        limits.max_bend = opts.get_or("max_bend", limits.max_bend);
+        out_mid_obj = opts["out_mid"];
+        out_end_obj = opts["out_end"];
+    }
+
+    sol::object mid_holder{};
+    sol::object end_holder{};
+    auto& out_mid = detail::get_output(s, out_mid_obj, root.type, count, mid_holder);
+    auto& out_end = detail::get_output(s, out_end_obj, root.type, count, end_holder);
+
+    const auto num_reached = utility::math::ik::solve_two_bone(root.vec4s().first(count), mid.vec4s(), end.vec4s(),
+        target.vec4s(), pole, limits, out_mid.vec4s(), out_end.vec4s());
+
+    return std::make_tuple(mid_holder, end_holder, num_reached);
+}
+
+// ik.fabrik(chains, joints_per_chain, target, [pole], [opts]) -> num_reached
+// chains is solved in place. opts: { iterations = 10, tolerance = 0.001 }
+size_t fabrik(sol::object chains_obj, size_t joints_per_chain, sol::object target_obj, sol::object pole_obj, sol::object opts_obj) {
+    auto& chains = detail::expect_points(chains_obj, "fabrik", "chains");
+    auto& target = detail::expect_points(target_obj, "fabrik", "target");
+
+    if (joints_per_chain < 2) {
+        throw sol::error{"ik.fabrik: joints_per_chain must be at least 2"};
+    }
+
+    std::span<const Vector4f> pole{};
+
+    if (pole_obj.valid() && pole_obj != sol::lua_nil) {
+        pole = detail::expect_points(pole_obj, "fabrik", "pole").vec4s();
+    }
+
+    utility::math::ik::FabrikSettings settings{};
+
+    if (opts_obj.is<sol::table>()) {
+        auto opts = opts_obj.as<sol::table>();
+
+        settings.iterations = opts.get_or("iterations", settings.iterations);
+        settings.tolerance = opts.get_or("tolerance", settings.tolerance);
+    }
+
+    return utility::math::ik::fabrik(chains.vec4s(), joints_per_chain, target.vec4s(), pole, settings);
+}
+}
+
+void bindings::open_ik(ScriptState* s) {
+    auto& lua = s->lua();
+    auto ik = lua.create_table();
+
+    ik["solve_batch"] = api::ik::solve_batch;
+    ik["fabrik"] = api::ik::fabrik;
+    lua["ik"] = ik;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+class ScriptState;
+
+namespace bindings {
+void open_ik(ScriptState* s);
+}
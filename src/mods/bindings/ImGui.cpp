@@ -3,9 +3,11 @@
 
 #include "../ScriptRunner.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/Renderer.hpp"
 #include "REFramework.hpp"
 #include "utility/ImGui.hpp"
 
+#include "VecBuf.hpp"
 #include "ImGui.hpp"
 
 namespace api::imgui {
@@ -1277,89 +1279,118 @@ ImGuiTableSortSpecs* table_get_sort_specs() {
 } // namespace api::imgui
 
 namespace api::draw {
-std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
-    auto scene = sdk::get_current_scene();
-
-    if (scene == nullptr) {
-        return std::nullopt;
+std::optional<Vector4f> get_world_pos(sol::object world_pos_object) {
+    if (world_pos_object.is<Vector2f>()) {
+        auto& v2f = world_pos_object.as<Vector2f&>();
+        return Vector4f{v2f.x, v2f.y, 0.0f, 1.0f};
+    } else if (world_pos_object.is<Vector3f>()) {
+        auto& v3f = world_pos_object.as<Vector3f&>();
+        return Vector4f{v3f.x, v3f.y, v3f.z, 1.0f};
+    } else if (world_pos_object.is<Vector4f>()) {
+        return world_pos_object.as<Vector4f>();
     }
 
-    auto context = sdk::get_thread_context();
-
-    static auto scene_def = sdk::find_type_definition("via.Scene");
-    auto first_transform = sdk::call_native_func_easy<RETransform*>(scene, scene_def, "get_FirstTransform");
+    return std::nullopt;
+}
 
-    if (first_transform == nullptr) {
+std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
+    if (sdk::get_current_scene() == nullptr) {
         return std::nullopt;
     }
 
-    if (world_pos_object.is<sol::nil_t>()) {
+    const auto world_pos = get_world_pos(world_pos_object);
+
+    if (!world_pos) {
         return std::nullopt;
     }
 
-    Vector4f world_pos{};
+    return sdk::renderer::world_to_screen(Vector3f{*world_pos});
+}
 
-    if (world_pos_object.is<Vector2f>()) {
-        auto& v2f = world_pos_object.as<Vector2f&>();
-        world_pos = Vector4f{v2f.x, v2f.y, 0.0f, 1.0f};
-    } else if (world_pos_object.is<Vector3f>()) {
-        auto& v3f = world_pos_object.as<Vector3f&>();
-        world_pos = Vector4f{v3f.x, v3f.y, v3f.z, 1.0f};
-    } else if (world_pos_object.is<Vector4f>()) {
-        auto& v4f = world_pos_object.as<Vector4f&>();
-        world_pos = Vector4f{v4f.x, v4f.y, v4f.z, v4f.w};
-    } else {
-        return std::nullopt;
-    }
+// Projects many points at once with the camera captured at the start of the frame.
+// points is a VEC3/VEC4 vecbuf or a table of vectors.
+// With an out vecbuf (VEC3/VEC4), it's resized to fit and each element is set to (x, y, visible, 0),
+// and the number of visible points is returned.
+// Otherwise a table is returned with a Vector2f per point, or false for points that aren't visible.
+sol::object world_to_screen_batch(sol::this_state s, sol::object points_object, sol::object out_object, sol::object cull_object) {
+    auto l = s.lua_state();
+    const auto cull_offscreen = cull_object.is<bool>() && cull_object.as<bool>();
 
-    static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
-    static auto next_transform_method = transform_def->get_method("get_Next");
-    static auto get_gameobject_method = transform_def->get_method("get_GameObject");
-    static auto get_position_method = transform_def->get_method("get_Position");
-    static auto get_axisz_method = transform_def->get_method("get_AxisZ");
-    static auto math_t = sdk::find_type_definition("via.math");
+    std::vector<Vector4f> table_points{};
+    std::span<const Vector4f> points{};
 
-    auto camera = sdk::get_primary_camera();
+    if (points_object.is<api::vecbuf::VecBuf&>()) {
+        auto& buf = points_object.as<api::vecbuf::VecBuf&>();
 
-    if (camera == nullptr) {
-        return std::nullopt;
-    }
+        if (buf.type != api::vecbuf::Type::VEC3 && buf.type != api::vecbuf::Type::VEC4) {
+            throw sol::error("draw.world_to_screen_batch: points must be a VEC3 or VEC4 vecbuf");
+        }
 
-    auto main_view = sdk::get_main_view();
+        points = buf.vec4s();
+    } else if (points_object.is<sol::table>()) {
+        auto tbl = points_object.as<sol::table>();
+        const auto n = tbl.size();
 
-    if (main_view == nullptr) {
-        return std::nullopt;
+        table_points.reserve(n);
+
+        for (size_t i = 1; i <= n; ++i) {
+            const auto world_pos = get_world_pos(tbl.get<sol::object>(i));
+
+            if (!world_pos) {
+                throw sol::error("draw.world_to_screen_batch: points table must only contain vectors");
+            }
+
+            table_points.push_back(*world_pos);
+        }
+
+        points = table_points;
+    } else {
+        throw sol::error("draw.world_to_screen_batch: points must be a vecbuf or a table");
     }
 
-    auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
-    auto camera_transform = camera_gameobject->transform;
+    std::vector<Vector2f> screen_positions(points.size());
+    std::vector<uint8_t> visible(points.size());
+
+    const auto num_visible = sdk::renderer::world_to_screen(points, screen_positions, visible, cull_offscreen);
 
-    Vector4f camera_origin{};
-    get_position_method->call<void*>(&camera_origin, context, camera_transform);
+    if (!out_object.is<sol::nil_t>()) {
+        if (!out_object.is<api::vecbuf::VecBuf&>()) {
+            throw sol::error("draw.world_to_screen_batch: out must be a vecbuf or nil");
+        }
+
+        auto& out = out_object.as<api::vecbuf::VecBuf&>();
 
-    Vector4f camera_forward{};
-    get_axisz_method->call<void*>(&camera_forward, context, camera_transform);
+        if (out.type != api::vecbuf::Type::VEC3 && out.type != api::vecbuf::Type::VEC4) {
+            throw sol::error("draw.world_to_screen_batch: out must be a VEC3 or VEC4 vecbuf");
+        }
 
-    // Translate 2d position to 3d position (screen to world)
-    Matrix4x4f proj{}, view{};
-    float screen_size[2]{};
-    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
-    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
-    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+        // Resizing out would pull the points out from under us.
+        if (points_object.is<api::vecbuf::VecBuf&>() && &points_object.as<api::vecbuf::VecBuf&>() == &out) {
+            throw sol::error("draw.world_to_screen_batch: out can't be the points vecbuf");
+        }
 
-    Vector4f screen_pos{};
+        out.resize(points.size());
 
-    const auto delta = world_pos - camera_origin;
+        auto dst = out.vec4s();
 
-    // behind camera
-    if (glm::dot(delta, -camera_forward) <= 0.0f) {
-        return std::nullopt;
+        for (size_t i = 0; i < points.size(); ++i) {
+            dst[i] = visible[i] != 0 ? Vector4f{screen_positions[i], 1.0f, 0.0f} : Vector4f{0.0f, 0.0f, 0.0f, 0.0f};
+        }
+
+        return sol::make_object(l, num_visible);
     }
 
-    static auto world_to_screen_method = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)"); // there are 2 of them.
-    world_to_screen_method->call<void*>(&screen_pos, context, &world_pos, &view, &proj, &screen_size);
+    auto result = sol::state_view{l}.create_table((int)points.size(), 0);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (visible[i] != 0) {
+            result[i + 1] = screen_positions[i];
+        } else {
+            result[i + 1] = false;
+        }
+    }
 
-    return Vector2f{screen_pos.x, screen_pos.y};
+    return sol::make_object(l, result);
 }
 
 void world_text(const char* text, sol::object world_pos_object, ImU32 color = 0xFFFFFFFF) {
@@ -2086,6 +2117,7 @@ void bindings::open_imgui(ScriptState* s) {
     auto draw = lua.create_table();
 
     draw["world_to_screen"] = api::draw::world_to_screen;
+    draw["world_to_screen_batch"] = api::draw::world_to_screen_batch;
     draw["world_text"] = api::draw::world_text;
     draw["text"] = api::draw::text;
     draw["filled_rect"] = api::draw::filled_rect;
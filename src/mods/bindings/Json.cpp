@@ -6,6 +6,7 @@
 
 #include "../ScriptRunner.hpp"
 
+#include "JsonCodec.hpp"
 #include "Json.hpp"
 
 namespace api::json {
@@ -13,99 +14,24 @@ using json = nlohmann::json;
 namespace fs = std::filesystem;
 
 namespace detail {
-json encode_any(sol::object obj) {
-    switch (obj.get_type()) {
-    case sol::type::nil:
-        return json{};
-    case sol::type::boolean:
-        return obj.as<bool>();
-    case sol::type::number: {
-        obj.push();
-        if (lua_isinteger(obj.lua_state(), -1)) {
-            obj.pop();
-            return obj.as<int64_t>();
-        }
-        
-        obj.pop();
-        
-        return obj.as<double>();
-    }
-    case sol::type::string:
-        return obj.as<std::string>();
-    case sol::type::table: {
-        auto table = obj.as<sol::table>();
-        bool is_array = true;
-        auto i = 1;
-
-        for (auto& kvp : table) {
-            if (kvp.first.get_type() != sol::type::number || kvp.first.as<int>() != i++) {
-                is_array = false;
-                break;
-            }
-        }
-
-        json j{};
-
-        for (auto& kvp : table) {
-            if (is_array) {
-                j.push_back(encode_any(kvp.second));
-            } else {
-                j[kvp.first.as<std::string>()] = encode_any(kvp.second);
-            }
-        }
-
-        return j;
-    }
-    default:
-        return json{};
-    }
+fs::path get_datadir() {
+    return REFramework::get_persistent_dir() / "reframework" / "data";
 }
 
-sol::object decode_any(sol::this_state l, const json& j) {
-    using value_t = nlohmann::detail::value_t;
-
-    auto state = sol::state_view{l};
-
-    switch (j.type()) {
-    case value_t::null:
-        return sol::nil;
-    case value_t::boolean:
-        return sol::make_object(l, j.get<bool>());
-    case value_t::number_integer:
-        return sol::make_object(l, j.get<int64_t>());
-    case value_t::number_unsigned:
-        return sol::make_object(l, j.get<uint64_t>());
-    case value_t::number_float:
-        return sol::make_object(l, j.get<double>());
-    case value_t::string:
-        return sol::make_object(l, j.get<std::string>());
-    case value_t::array: {
-        sol::table t = state.create_table();
-        for (size_t i = 0; i < j.size(); ++i) {
-            t[i + 1] = decode_any(l, j[i]);
-        }
-        return t;
-    }
-    case value_t::object: {
-        sol::table t = state.create_table();
-        for (auto it = j.begin(); it != j.end(); ++it) {
-            t[it.key()] = decode_any(l, it.value());
-        }
-        return t;
-    }
-    default:
-        return sol::nil;
+void check_path(const std::string& filepath, std::string_view api_name) {
+    if (filepath.find("..") != std::string::npos) {
+        throw std::runtime_error{fmt::format("{} does not allow access to parent directories", api_name)};
     }
-}
 
-fs::path get_datadir() {
-    return REFramework::get_persistent_dir() / "reframework" / "data";
+    if (std::filesystem::path(filepath).is_absolute()) {
+        throw std::runtime_error{fmt::format("{} does not allow absolute paths", api_name)};
+    }
 }
 } // namespace detail
 
 sol::object load_string(sol::this_state l, const std::string& s) try {
-    const auto j = json::parse(s);
-    return detail::decode_any(l, j);
+    std::string error{};
+    return decode(l, s, json::input_format_t::json, error);
 } catch (const std::exception& e) {
     return sol::nil;
 }
@@ -117,25 +43,23 @@ std::string dump_string(sol::object obj, sol::object indent_obj) try {
         indent = indent_obj.as<int>();
     }
 
-    return detail::encode_any(obj).dump(indent);
+    return encode_json(obj, indent);
 } catch (const std::exception& e) {
     return "";
 }
 
-sol::object load_file(sol::this_state l, const std::string& filepath) try {
-    if (filepath.find("..") != std::string::npos) {
-        throw std::runtime_error{"json.load_file does not allow access to parent directories"};
-    }
+sol::object load_file(sol::this_state l, const std::string& filepath) {
+    detail::check_path(filepath, "json.load_file");
 
-    if (std::filesystem::path(filepath).is_absolute()) {
-        throw std::runtime_error{"json.load_file does not allow absolute paths"};
+    std::string error{};
+    std::ifstream f{detail::get_datadir() / filepath};
+    auto result = decode(l, f, json::input_format_t::json, error);
+
+    if (!error.empty()) {
+        spdlog::error("[JSON] Failed to load file {}: {}", filepath, error);
     }
 
-    const auto j = json::parse(std::ifstream{detail::get_datadir() / filepath});
-    return detail::decode_any(l, j);
-} catch (const json::exception& e) {
-    spdlog::error("[JSON] Failed to load file {}: {}", filepath, e.what());
-    return sol::nil;
+    return result;
 }
 
 bool dump_file(const std::string& filepath, sol::object obj, sol::object indent_obj) try {
@@ -145,26 +69,63 @@ bool dump_file(const std::string& filepath, sol::object obj, sol::object indent_
         indent = indent_obj.as<int>();
     }
 
-    if (filepath.find("..") != std::string::npos) {
-        throw std::runtime_error{"json.dump_file does not allow access to parent directories"};
-    }
-
-    if (std::filesystem::path(filepath).is_absolute()) {
-        throw std::runtime_error{"json.dump_file does not allow absolute paths"};
-    }
+    detail::check_path(filepath, "json.dump_file");
 
+    const auto out = encode_json(obj, indent);
     auto path = detail::get_datadir() / filepath;
 
     fs::create_directories(path.parent_path());
 
     std::ofstream f{path};
-    f << detail::encode_any(obj).dump(indent);
+    f << out;
     return true;
 } catch (const std::exception& e) {
     spdlog::error("[JSON] Failed to dump file {}: {}", filepath, e.what());
     return false;
 }
 
+// Compact binary variants for script persistence. Same value model as the JSON functions.
+sol::object load_cbor_string(sol::this_state l, const std::string& s) {
+    std::string error{};
+    return decode(l, s, json::input_format_t::cbor, error);
+}
+
+std::string dump_cbor_string(sol::object obj) try {
+    return encode_cbor(obj);
+} catch (const std::exception& e) {
+    return "";
+}
+
+sol::object load_cbor_file(sol::this_state l, const std::string& filepath) {
+    detail::check_path(filepath, "json.load_cbor_file");
+
+    std::string error{};
+    std::ifstream f{detail::get_datadir() / filepath, std::ios::binary};
+    auto result = decode(l, f, json::input_format_t::cbor, error);
+
+    if (!error.empty()) {
+        spdlog::error("[JSON] Failed to load CBOR file {}: {}", filepath, error);
+    }
+
+    return result;
+}
+
+bool dump_cbor_file(const std::string& filepath, sol::object obj) try {
+    detail::check_path(filepath, "json.dump_cbor_file");
+
+    const auto out = encode_cbor(obj);
+    auto path = detail::get_datadir() / filepath;
+
+    fs::create_directories(path.parent_path());
+
+    std::ofstream f{path, std::ios::binary};
+    f.write(out.data(), out.size());
+    return true;
+} catch (const std::exception& e) {
+    spdlog::error("[JSON] Failed to dump CBOR file {}: {}", filepath, e.what());
+    return false;
+}
+
 } // namespace api::json
 
 void bindings::open_json(ScriptState* s) {
@@ -175,5 +136,9 @@ void bindings::open_json(ScriptState* s) {
     json["dump_string"] = api::json::dump_string;
     json["load_file"] = api::json::load_file;
     json["dump_file"] = api::json::dump_file;
+    json["load_cbor_string"] = api::json::load_cbor_string;
+    json["dump_cbor_string"] = api::json::dump_cbor_string;
+    json["load_cbor_file"] = api::json::load_cbor_file;
+    json["dump_cbor_file"] = api::json::dump_cbor_file;
     lua["json"] = json;
-}
\ No newline at end of file
+}
@@ -0,0 +1,540 @@
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include <utility/ScopeGuard.hpp>
+
+#include "JsonCodec.hpp"
+
+namespace api::json {
+using json = nlohmann::json;
+
+namespace detail {
+// Deep enough for any sane save table, shallow enough to catch self-referencing tables
+// before we blow the C stack.
+constexpr auto MAX_DEPTH = 512;
+
+// Writes JSON text straight into a string buffer. Mirrors the layout nlohmann's dump() used
+// to produce so existing files and scripts don't notice the difference.
+class JsonWriter {
+public:
+    JsonWriter(std::string& out, int indent)
+        : m_out{out},
+        m_indent{indent}
+    {
+    }
+
+    size_t mark() const { return m_out.size(); }
+    void rewind(size_t pos) { m_out.resize(pos); }
+
+    void null() { m_out += "null"; }
+    void boolean(bool value) { m_out += value ? "true" : "false"; }
+
+    void integer(int64_t value) {
+        char buf[32]{};
+        const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        m_out.append(buf, result.ptr);
+    }
+
+    void number(double value) {
+        // JSON has no representation for these, nlohmann wrote null too.
+        if (!std::isfinite(value)) {
+            null();
+            return;
+        }
+
+        char buf[64]{};
+        const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        const auto str = std::string_view{buf, (size_t)(result.ptr - buf)};
+
+        m_out += str;
+
+        // Keep floats distinguishable from integers when read back.
+        if (str.find_first_of(".eE") == std::string_view::npos) {
+            m_out += ".0";
+        }
+    }
+
+    void string(std::string_view str);
+
+    void begin_array() { m_out += '['; }
+    void end_array(int depth) { newline(depth); m_out += ']'; }
+    void begin_object() { m_out += '{'; }
+    void end_object(int depth) { newline(depth); m_out += '}'; }
+
+    void element(bool first, int depth) {
+        if (!first) {
+            m_out += ',';
+        }
+
+        newline(depth + 1);
+    }
+
+    void key(std::string_view str) {
+        string(str);
+        m_out += m_indent >= 0 ? ": " : ":";
+    }
+
+private:
+    void newline(int depth) {
+        if (m_indent < 0) {
+            return;
+        }
+
+        m_out += '\n';
+        m_out.append((size_t)depth * m_indent, ' ');
+    }
+
+    std::string& m_out;
+    int m_indent{-1};
+};
+
+void JsonWriter::string(std::string_view str) {
+    static constexpr char hex[] = "0123456789abcdef";
+
+    m_out.reserve(m_out.size() + str.size() + 2);
+    m_out += '"';
+
+    for (size_t i = 0; i < str.size();) {
+        const auto c = (uint8_t)str[i];
+
+        if (c < 0x80) {
+            switch (c) {
+            case '"': m_out += "\\\""; break;
+            case '\\': m_out += "\\\\"; break;
+            case '\b': m_out += "\\b"; break;
+            case '\f': m_out += "\\f"; break;
+            case '\n': m_out += "\\n"; break;
+            case '\r': m_out += "\\r"; break;
+            case '\t': m_out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    m_out += "\\u00";
+                    m_out += hex[c >> 4];
+                    m_out += hex[c & 0xF];
+                } else {
+                    m_out += (char)c;
+                }
+                break;
+            }
+
+            ++i;
+            continue;
+        }
+
+        // Lua strings are raw bytes. Pass valid UTF-8 through untouched and replace anything
+        // else with U+FFFD so the output can always be parsed again.
+        size_t len = 0;
+
+        if (c >= 0xC2 && c <= 0xDF) {
+            len = 2;
+        } else if ((c & 0xF0) == 0xE0) {
+            len = 3;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            len = 4;
+        }
+
+        bool valid = len != 0 && i + len <= str.size();
+
+        for (size_t j = 1; valid && j < len; ++j) {
+            valid = ((uint8_t)str[i + j] & 0xC0) == 0x80;
+        }
+
+        // The second byte is narrower for these leads, anything outside the range is an
+        // overlong encoding, a UTF-16 surrogate or past U+10FFFF.
+        if (valid) {
+            const auto c1 = (uint8_t)str[i + 1];
+
+            switch (c) {
+            case 0xE0: valid = c1 >= 0xA0; break;
+            case 0xED: valid = c1 <= 0x9F; break;
+            case 0xF0: valid = c1 >= 0x90; break;
+            case 0xF4: valid = c1 <= 0x8F; break;
+            default: break;
+            }
+        }
+
+        if (valid) {
+            m_out.append(str.data() + i, len);
+            i += len;
+        } else {
+            m_out += "\xEF\xBF\xBD";
+            ++i;
+        }
+    }
+
+    m_out += '"';
+}
+
+// Writes CBOR (RFC 8949). Containers use the indefinite-length encoding so tables can be
+// streamed without counting their keys first; nlohmann's reader understands it.
+class CborWriter {
+public:
+    CborWriter(std::string& out)
+        : m_out{out}
+    {
+    }
+
+    size_t mark() const { return m_out.size(); }
+    void rewind(size_t pos) { m_out.resize(pos); }
+
+    void null() { m_out += '\xF6'; }
+    void boolean(bool value) { m_out += value ? '\xF5' : '\xF4'; }
+
+    void integer(int64_t value) {
+        if (value >= 0) {
+            header(0, (uint64_t)value);
+        } else {
+            header(1, (uint64_t)(-(value + 1)));
+        }
+    }
+
+    void number(double value) {
+        uint64_t bits{};
+        memcpy(&bits, &value, sizeof(bits));
+
+        m_out += '\xFB';
+        put_be(bits, 8);
+    }
+
+    void string(std::string_view str) {
+        header(3, str.size());
+        m_out.append(str);
+    }
+
+    void begin_array() { m_out += '\x9F'; }
+    void end_array(int) { m_out += '\xFF'; }
+    void begin_object() { m_out += '\xBF'; }
+    void end_object(int) { m_out += '\xFF'; }
+    void element(bool, int) {}
+    void key(std::string_view str) { string(str); }
+
+private:
+    void header(uint8_t major, uint64_t value) {
+        major <<= 5;
+
+        if (value < 24) {
+            m_out += (char)(major | value);
+        } else if (value <= 0xFF) {
+            m_out += (char)(major | 24);
+            put_be(value, 1);
+        } else if (value <= 0xFFFF) {
+            m_out += (char)(major | 25);
+            put_be(value, 2);
+        } else if (value <= 0xFFFFFFFF) {
+            m_out += (char)(major | 26);
+            put_be(value, 4);
+        } else {
+            m_out += (char)(major | 27);
+            put_be(value, 8);
+        }
+    }
+
+    void put_be(uint64_t value, int bytes) {
+        for (auto i = bytes - 1; i >= 0; --i) {
+            m_out += (char)((value >> (i * 8)) & 0xFF);
+        }
+    }
+
+    std::string& m_out;
+};
+
+// Walks a Lua value directly on the Lua stack and feeds it to a writer,
+// without building an intermediate nlohmann::json DOM.
+template <typename Writer>
+class LuaEncoder {
+public:
+    LuaEncoder(lua_State* l, Writer& writer)
+        : m_l{l},
+        m_w{writer}
+    {
+    }
+
+    void encode(int idx, int depth = 0) {
+        switch (lua_type(m_l, idx)) {
+        case LUA_TBOOLEAN:
+            m_w.boolean(lua_toboolean(m_l, idx) != 0);
+            break;
+        case LUA_TNUMBER:
+            if (lua_isinteger(m_l, idx)) {
+                m_w.integer(lua_tointeger(m_l, idx));
+            } else {
+                m_w.number(lua_tonumber(m_l, idx));
+            }
+            break;
+        case LUA_TSTRING: {
+            size_t len{};
+            const auto str = lua_tolstring(m_l, idx, &len);
+            m_w.string({str, len});
+            break;
+        }
+        case LUA_TTABLE:
+            encode_table(idx, depth);
+            break;
+        default:
+            m_w.null();
+            break;
+        }
+    }
+
+private:
+    void encode_table(int idx, int depth) {
+        if (depth >= MAX_DEPTH) {
+            throw std::runtime_error{"table nesting is too deep (cyclic reference?)"};
+        }
+
+        if (!lua_checkstack(m_l, 4)) {
+            throw std::runtime_error{"out of Lua stack space"};
+        }
+
+        // Optimistically write the table as an array and fall back to an object at the first key
+        // that doesn't continue the 1..n sequence. Pure arrays only get walked once this way.
+        const auto start = m_w.mark();
+        lua_Integer expected = 1;
+
+        m_w.begin_array();
+        lua_pushnil(m_l);
+
+        while (lua_next(m_l, idx) != 0) {
+            if (!lua_isinteger(m_l, -2) || lua_tointeger(m_l, -2) != expected) {
+                lua_pop(m_l, 2);
+                m_w.rewind(start);
+                encode_object(idx, depth);
+                return;
+            }
+
+            m_w.element(expected == 1, depth);
+            encode(lua_gettop(m_l), depth + 1);
+            lua_pop(m_l, 1);
+            ++expected;
+        }
+
+        // Empty tables have always been written out as null.
+        if (expected == 1) {
+            m_w.rewind(start);
+            m_w.null();
+            return;
+        }
+
+        m_w.end_array(depth);
+    }
+
+    void encode_object(int idx, int depth) {
+        bool first = true;
+
+        m_w.begin_object();
+        lua_pushnil(m_l);
+
+        while (lua_next(m_l, idx) != 0) {
+            m_w.element(first, depth);
+            first = false;
+
+            // Convert a copy of the key, lua_tolstring on the original would confuse lua_next.
+            lua_pushvalue(m_l, -2);
+
+            size_t len{};
+            const auto key = lua_tolstring(m_l, -1, &len);
+
+            if (key == nullptr) {
+                throw std::runtime_error{std::string{"unsupported table key type: "} + luaL_typename(m_l, -1)};
+            }
+
+            m_w.key({key, len});
+            lua_pop(m_l, 1);
+
+            encode(lua_gettop(m_l), depth + 1);
+            lua_pop(m_l, 1);
+        }
+
+        m_w.end_object(depth);
+    }
+
+    lua_State* m_l;
+    Writer& m_w;
+};
+
+template <typename Writer>
+void encode_any(sol::object obj, Writer& writer) {
+    const auto l = obj.lua_state();
+
+    if (l == nullptr) {
+        writer.null();
+        return;
+    }
+
+    const auto top = lua_gettop(l);
+    ScopeGuard _{[l, top]() { lua_settop(l, top); }};
+
+    obj.push();
+    LuaEncoder<Writer>{l, writer}.encode(top + 1);
+}
+
+// Builds Lua values directly from nlohmann's SAX events. Containers live on the Lua stack
+// while they're being filled, so no DOM is ever materialized.
+class LuaSax : public nlohmann::json_sax<json> {
+public:
+    LuaSax(lua_State* l)
+        : m_l{l}
+    {
+    }
+
+    const std::string& error() const { return m_error; }
+
+    bool null() override {
+        lua_pushnil(m_l);
+        return commit();
+    }
+
+    bool boolean(bool val) override {
+        lua_pushboolean(m_l, val);
+        return commit();
+    }
+
+    bool number_integer(number_integer_t val) override {
+        lua_pushinteger(m_l, val);
+        return commit();
+    }
+
+    bool number_unsigned(number_unsigned_t val) override {
+        if (val <= (number_unsigned_t)std::numeric_limits<lua_Integer>::max()) {
+            lua_pushinteger(m_l, (lua_Integer)val);
+        } else {
+            lua_pushnumber(m_l, (lua_Number)val);
+        }
+
+        return commit();
+    }
+
+    bool number_float(number_float_t val, const string_t&) override {
+        lua_pushnumber(m_l, val);
+        return commit();
+    }
+
+    bool string(string_t& val) override {
+        lua_pushlstring(m_l, val.data(), val.size());
+        return commit();
+    }
+
+    bool binary(binary_t& val) override {
+        lua_pushlstring(m_l, (const char*)val.data(), val.size());
+        return commit();
+    }
+
+    bool start_object(std::size_t elements) override {
+        return open(false, elements);
+    }
+
+    bool key(string_t& val) override {
+        lua_pushlstring(m_l, val.data(), val.size());
+        return true;
+    }
+
+    bool end_object() override {
+        return close();
+    }
+
+    bool start_array(std::size_t elements) override {
+        return open(true, elements);
+    }
+
+    bool end_array() override {
+        return close();
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        m_error = ex.what();
+        return false;
+    }
+
+private:
+    struct Frame {
+        bool is_array{};
+        lua_Integer index{};
+    };
+
+    bool open(bool is_array, std::size_t elements) {
+        if (m_frames.size() >= MAX_DEPTH || !lua_checkstack(m_l, 3)) {
+            m_error = "nesting is too deep";
+            return false;
+        }
+
+        // Binary formats report their sizes up front, JSON reports -1.
+        const auto hint = elements != (std::size_t)-1 ? (int)std::min<std::size_t>(elements, 1 << 20) : 0;
+
+        lua_createtable(m_l, is_array ? hint : 0, is_array ? 0 : hint);
+        m_frames.push_back(Frame{is_array, 0});
+        return true;
+    }
+
+    bool close() {
+        m_frames.pop_back();
+        return commit();
+    }
+
+    // Moves the value on top of the stack into the container being built.
+    // The root value is simply left on the stack.
+    bool commit() {
+        if (m_frames.empty()) {
+            return true;
+        }
+
+        auto& frame = m_frames.back();
+
+        if (frame.is_array) {
+            lua_rawseti(m_l, -2, ++frame.index);
+        } else {
+            lua_rawset(m_l, -3);
+        }
+
+        return true;
+    }
+
+    lua_State* m_l;
+    std::vector<Frame> m_frames{};
+    std::string m_error{};
+};
+
+template <typename InputType>
+sol::object decode_any(sol::this_state s, InputType&& input, json::input_format_t format, std::string& error) {
+    lua_State* l = s;
+    const auto top = lua_gettop(l);
+    ScopeGuard _{[l, top]() { lua_settop(l, top); }};
+
+    LuaSax sax{l};
+
+    if (!json::sax_parse(std::forward<InputType>(input), &sax, format) || lua_gettop(l) != top + 1) {
+        error = !sax.error().empty() ? sax.error() : "unexpected end of input";
+        return sol::lua_nil;
+    }
+
+    return sol::object{l, -1};
+}
+} // namespace detail
+
+std::string encode_json(sol::object obj, int indent) {
+    std::string out{};
+    detail::JsonWriter writer{out, indent};
+    detail::encode_any(obj, writer);
+
+    return out;
+}
+
+std::string encode_cbor(sol::object obj) {
+    std::string out{};
+    detail::CborWriter writer{out};
+    detail::encode_any(obj, writer);
+
+    return out;
+}
+
+sol::object decode(sol::this_state s, const std::string& input, json::input_format_t format, std::string& error) {
+    return detail::decode_any(s, input, format, error);
+}
+
+sol::object decode(sol::this_state s, std::istream& input, json::input_format_t format, std::string& error) {
+    return detail::decode_any(s, input, format, error);
+}
+} // namespace api::json
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <istream>
+#include <string>
+
+#include <json.hpp>
+#include <sol/sol.hpp>
+
+// Lua <-> JSON/CBOR conversion used by the json bindings. Kept apart from Json.cpp so it
+// doesn't depend on the rest of the script runner.
+namespace api::json {
+// Throws std::runtime_error on tables that can't be represented (cycles, unsupported keys).
+// indent < 0 writes compact JSON.
+std::string encode_json(sol::object obj, int indent);
+std::string encode_cbor(sol::object obj);
+
+// Returns nil and fills in error on malformed input.
+sol::object decode(sol::this_state s, const std::string& input, nlohmann::json::input_format_t format, std::string& error);
+sol::object decode(sol::this_state s, std::istream& input, nlohmann::json::input_format_t format, std::string& error);
+}
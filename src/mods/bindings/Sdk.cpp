@@ -6,8 +6,10 @@
 #include "HookManager.hpp"
 #include "sdk/REContext.hpp"
 #include "sdk/REManagedObject.hpp"
+#include "sdk/REComponent.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneIndex.hpp"
 #include "sdk/ResourceManager.hpp"
 #include "sdk/MotionFsm2Layer.hpp"
 #include "sdk/TDBVer.hpp"
@@ -18,6 +20,7 @@
 #include <lgc.h>
 
 #include "Sdk.hpp"
+#include "VecBuf.hpp"
 
 namespace api {
 namespace sdk {
@@ -47,14 +50,14 @@ namespace detail {
 namespace api::re_managed_object {
 namespace detail {
 void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
-    auto sv = sol::state_view{l};
-    
     // we shouldn't really do this very much
     // so it shouldn't be too terrible on performance
     if (!utility::re_managed_object::is_managed_object(obj)) {
         throw sol::error{(std::stringstream{} << "sol_lua_push: " << (uintptr_t)obj << " is not a managed object").str()};
     }
 
+    auto& refs_table = ScriptState::get(l)->managed_object_refs();
+
     // Throwing automatic add_ref on the backburner; it doesn't seem to work
     // very well with lua's garbage collector.
     // addendum: maybe figured it out
@@ -64,60 +67,50 @@ void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
     // addendum: only do it when reference count is > 0, local objects seem buggy...
     if (force || (int32_t)obj->referenceCount > 0) {
         if (!force) {
-            utility::re_managed_object::add_ref(obj);
+            utility::re_managed_object::add_ref_deferred(obj);
         }
 
         // the reference counting is not necessary, but it will let us
         // catch bugs if an REManagedObject pointer is being created
         // without coming through our sol_lua_push function
-        sol::lua_table ref_counts = sv["_sol_lua_push_ref_counts"];
-        sol::lua_table ephemeral_counts = sv["_sol_lua_push_ephemeral_counts"];
-        std::optional<int> current_ref_count = ref_counts[(uintptr_t)obj];
+        auto& refs = refs_table[obj];
 
-        if (current_ref_count && *current_ref_count > 0) {
+        if (refs.ref_count > 0) {
             // don't unnecessarily increase the ref count
             // if the user is the one doing it
             if (force) {
                 return;
             }
 
-            ref_counts[(uintptr_t)obj] = *current_ref_count + 1;
+            ++refs.ref_count;
         } else {
             // only add the ref once when the user requests it
             // so they don't screw something up
             if (force) {
-                utility::re_managed_object::add_ref(obj);
+                utility::re_managed_object::add_ref_deferred(obj);
             }
 
-            ref_counts[(uintptr_t)obj] = 1;
+            refs.ref_count = 1;
         }
 
         // when the user adds a ref to an ephemeral object
-        if (force) {
-            std::optional<int> current_ephemeral_count = ephemeral_counts[(uintptr_t)obj];
-
-            if (current_ephemeral_count && *current_ephemeral_count > 0) {
-                ephemeral_counts[(uintptr_t)obj] = *current_ephemeral_count - 1;
-            } else {
-                ephemeral_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-            }
+        if (force && refs.ephemeral_count > 0) {
+            --refs.ephemeral_count;
         }
     } else {
-        // ephemeral counts is just a table
+        // ephemeral counts are just there
         // to help with tracking the local objects
         // so we don't spam the log with warnings when they get gc'd
-        sol::lua_table ephemeral_counts = sv["_sol_lua_push_ephemeral_counts"];
-        std::optional<int> current_ref_count = ephemeral_counts[(uintptr_t)obj];
-
-        if (current_ref_count) {
-            ephemeral_counts[(uintptr_t)obj] = *current_ref_count + 1;
-        } else {
-            ephemeral_counts[(uintptr_t)obj] = 1;
-        }
-
-        //ref_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
+        ++refs_table[obj].ephemeral_count;
     }
 }
+
+void uncache_object(lua_State* l, ::REManagedObject* obj) {
+    lua_rawgeti(l, LUA_REGISTRYINDEX, ScriptState::get(l)->managed_object_cache());
+    lua_pushnil(l);
+    lua_rawsetp(l, -2, obj);
+    lua_pop(l, 1);
+}
 }
 
 // used by metatable for REManagedObject
@@ -139,55 +132,43 @@ void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
 
 void release(sol::this_state s, ::REManagedObject* obj, bool force = false) {
     auto l = s.lua_state();
-    auto sv = sol::state_view(l);
-
-    sol::lua_table objects = sv["_sol_lua_push_objects"];
-    sol::lua_table ref_counts = sv["_sol_lua_push_ref_counts"];
-    sol::lua_table ephemeral_counts = sv["_sol_lua_push_ephemeral_counts"];
+    auto& refs_table = ScriptState::get(l)->managed_object_refs();
+    auto refs = refs_table.find(obj);
+    bool uncache = false;
 
-    if (std::optional<int> ref_count = ref_counts[(uintptr_t)obj]; ref_count && *ref_count > 0) {
+    if (refs != nullptr && refs->ref_count > 0) {
         // because of our internal refcount keeping, we shouldn't need to double check
         // whether it's an actual object or not. hopefully?
         //if (utility::re_managed_object::is_managed_object(obj)) {
-            utility::re_managed_object::release(obj);
+            utility::re_managed_object::release_deferred(obj);
         //}
 
-        int new_ref_count = *ref_count - 1;
-
-        if (new_ref_count == 0) {
-            if (sol::object object = ephemeral_counts[(uintptr_t)obj]; !object.valid()) {
-                objects[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-            }
-
-            ref_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-        } else {
-            ref_counts[(uintptr_t)obj] = new_ref_count;
-        }
-
-        //ephemeral_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-    } else if (std::optional<int> ephemeral_count = ephemeral_counts[(uintptr_t)obj]; ephemeral_count && *ephemeral_count > 0) {
+        uncache = --refs->ref_count == 0 && refs->ephemeral_count == 0;
+    } else if (refs != nullptr && refs->ephemeral_count > 0) {
         if (force && utility::re_managed_object::is_managed_object(obj)) {
-            utility::re_managed_object::release(obj);
+            utility::re_managed_object::release_deferred(obj);
         }
 
         // ephemeral counts don't actually release the object, they just decrement the count.
-        int new_ephemeral_count = *ephemeral_count - 1;
-
-        if (new_ephemeral_count == 0) {
-            objects[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-            ephemeral_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-        } else {
-            ephemeral_counts[(uintptr_t)obj] = new_ephemeral_count;
-        }
+        uncache = --refs->ephemeral_count == 0;
     } else {
         if (force) {
             if (utility::re_managed_object::is_managed_object(obj)) {
-                utility::re_managed_object::release(obj);
+                utility::re_managed_object::release_deferred(obj);
             }
         } else {
             spdlog::warn("REManagedObject:release attempted to release an object that was not managed by our Lua state");
         }
     }
+
+    if (refs != nullptr && refs->ref_count <= 0 && refs->ephemeral_count <= 0) {
+        refs_table.erase(obj);
+    }
+
+    // Done last, touching the Lua table can run finalizers that call back into here.
+    if (uncache) {
+        detail::uncache_object(l, obj);
+    }
 }
 }
 
@@ -196,13 +177,15 @@ void release(sol::this_state s, ::REManagedObject* obj, bool force = false) {
 template<detail::ManagedObjectBased T>
 int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
     if (obj != nullptr) {
-        auto sv = sol::state_view{l};
-        sol::lua_table objects = sv["_sol_lua_push_objects"];
+        const auto state = ScriptState::get(l);
+
+        lua_rawgeti(l, LUA_REGISTRYINDEX, state->managed_object_cache());
+
+        if (lua_rawgetp(l, -1, obj) != LUA_TNIL) {
+            lua_remove(l, -2);
 
-        if (sol::object lua_obj = objects[(uintptr_t)obj]; !lua_obj.is<sol::nil_t>()) {
             // renew the reference so it doesn't get collected
             // had to dig deep in the lua source to figure out this nonsense
-            lua_obj.push();
             auto g = G(l);
             auto tv = s2v(l->top - 1);
             auto& gc = tv->value_.gc;
@@ -210,6 +193,8 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
 
             return 1;
         } else {
+            lua_pop(l, 2);
+
             if ((uintptr_t)obj != detail::FAKE_OBJECT_ADDR) {
                 api::re_managed_object::detail::add_ref(l, (::REManagedObject*)obj, false);
             }
@@ -259,10 +244,11 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
                     backpedal = sol::stack::push<sol::detail::as_pointer_tag<std::remove_pointer_t<T>>>(l, obj);
                 }
 
-                auto ref = sol::stack::get<sol::object>(l, -backpedal);
-
                 // keep a weak reference to the object for caching
-                objects[(uintptr_t)obj] = ref;
+                lua_rawgeti(l, LUA_REGISTRYINDEX, state->managed_object_cache());
+                lua_pushvalue(l, -backpedal - 1);
+                lua_rawsetp(l, -2, obj);
+                lua_pop(l, 1);
 
                 return backpedal;
             } else {
@@ -1179,6 +1165,98 @@ sol::object get_primary_camera(sol::this_state s) {
     return sol::make_object(s, (::REManagedObject*)::sdk::get_primary_camera());
 }
 
+namespace detail {
+Vector3f get_query_position(sol::object position) {
+    if (position.is<Vector3f>()) {
+        return position.as<Vector3f>();
+    }
+
+    if (position.is<Vector4f>()) {
+        return Vector3f{position.as<Vector4f>()};
+    }
+
+    throw sol::error("expected a Vector3f or Vector4f position");
+}
+
+uint64_t get_query_tags(sol::object type_name) {
+    if (!type_name.is<std::string>()) {
+        return 0;
+    }
+
+    const auto tag = ::sdk::scene_index::get_tag(type_name.as<std::string>());
+
+    if (tag == 0) {
+        throw sol::error("type not found or too many types in use: " + type_name.as<std::string>());
+    }
+
+    return tag;
+}
+
+sol::table to_game_objects(sol::this_state s, const std::vector<::sdk::scene_index::Object>& objects) {
+    auto result = sol::state_view{s}.create_table((int)objects.size(), 0);
+
+    for (size_t i = 0; i < objects.size(); ++i) {
+        result[i + 1] = (::REManagedObject*)objects[i].owner;
+    }
+
+    return result;
+}
+}
+
+// Served from the scene index, which is rebuilt at BeginRendering while it's being used.
+// type_name optionally limits results to game objects with a component of that type.
+sol::table find_objects_near(sol::this_state s, sol::object position, float radius, sol::object type_name) {
+    const auto center = detail::get_query_position(position);
+    const auto tags = detail::get_query_tags(type_name);
+
+    return detail::to_game_objects(s, ::sdk::scene_index::find_near(center, radius, tags));
+}
+
+sol::table find_nearest_objects(sol::this_state s, sol::object position, uint32_t count, sol::object max_radius, sol::object type_name) {
+    const auto center = detail::get_query_position(position);
+    const auto tags = detail::get_query_tags(type_name);
+    const auto radius = max_radius.is<float>() ? max_radius.as<float>() : FLT_MAX;
+
+    return detail::to_game_objects(s, ::sdk::scene_index::find_nearest(center, count, radius, tags));
+}
+
+namespace detail {
+::REType* get_component_type(const std::string& type_name) {
+    auto t = utility::re_component::get_type_by_name(type_name);
+
+    if (t == nullptr) {
+        throw sol::error("type not found: " + type_name);
+    }
+
+    return t;
+}
+}
+
+// Cached replacement for game_object:call("getComponent(System.Type)", ...) loops.
+sol::object find_component(sol::this_state s, ::REManagedObject* game_object, const std::string& type_name) {
+    static auto game_object_t = ::sdk::find_type_definition("via.GameObject")->get_type();
+
+    if (game_object == nullptr || !utility::re_managed_object::is_a(game_object, game_object_t)) {
+        throw sol::error("sdk.find_component expected a via.GameObject");
+    }
+
+    const auto t = detail::get_component_type(type_name);
+
+    return sol::make_object(s, (::REManagedObject*)utility::re_component::find_cached((::REGameObject*)game_object, t));
+}
+
+// Every component of the given type in the current scene, one per GameObject.
+sol::table find_components(sol::this_state s, const std::string& type_name) {
+    const auto components = utility::re_component::find_all(detail::get_component_type(type_name));
+    auto result = sol::state_view{s}.create_table((int)components.size(), 0);
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        result[i + 1] = (::REManagedObject*)components[i];
+    }
+
+    return result;
+}
+
 bool is_managed_object(sol::object obj) {
     auto real_obj = get_real_obj(obj);
 
@@ -1348,15 +1426,121 @@ T read_memory(::REManagedObject* obj, int32_t offset) {
 }
 } 
 
+namespace api::re_transform {
+namespace detail {
+// Positions can be vec3 or vec4 buffers (both are 16 bytes per element), rotations must be quats.
+api::vecbuf::VecBuf* get_pose_buffer(sol::object obj, bool rotation) {
+    if (!obj.valid() || obj.is<sol::lua_nil_t>()) {
+        return nullptr;
+    }
+
+    if (!obj.is<api::vecbuf::VecBuf&>()) {
+        throw sol::error("RETransform pose buffers must be vecbufs or nil");
+    }
+
+    auto& buf = obj.as<api::vecbuf::VecBuf&>();
+
+    if (rotation && buf.type != api::vecbuf::Type::QUAT) {
+        throw sol::error("RETransform pose rotation buffers must be QUAT vecbufs");
+    }
+
+    if (!rotation && buf.type != api::vecbuf::Type::VEC3 && buf.type != api::vecbuf::Type::VEC4) {
+        throw sol::error("RETransform pose position buffers must be VEC3 or VEC4 vecbufs");
+    }
+
+    return &buf;
+}
+
+utility::re_transform::JointPoseBuffers get_pose_buffers(sol::object local_positions, sol::object local_rotations, sol::object world_positions, sol::object world_rotations, size_t resize_to) {
+    utility::re_transform::JointPoseBuffers out{};
+
+    const auto prepare = [resize_to](api::vecbuf::VecBuf* buf) {
+        if (buf != nullptr && resize_to > 0 && buf->count != resize_to) {
+            buf->resize(resize_to);
+        }
+
+        return buf;
+    };
+
+    if (auto buf = prepare(get_pose_buffer(local_positions, false)); buf != nullptr) {
+        out.local_positions = buf->vec4s();
+    }
+
+    if (auto buf = prepare(get_pose_buffer(local_rotations, true)); buf != nullptr) {
+        out.local_rotations = buf->quats();
+    }
+
+    if (auto buf = prepare(get_pose_buffer(world_positions, false)); buf != nullptr) {
+        out.world_positions = buf->vec4s();
+    }
+
+    if (auto buf = prepare(get_pose_buffer(world_rotations, true)); buf != nullptr) {
+        out.world_rotations = buf->quats();
+    }
+
+    return out;
+}
+}
+
+// Buffers are resized to the joint count.
+uint32_t read_pose(::RETransform* t, sol::object local_positions, sol::object local_rotations, sol::object world_positions, sol::object world_rotations) {
+    if (t == nullptr) {
+        return 0;
+    }
+
+    const auto count = utility::re_transform::get_joint_count(*t);
+    const auto buffers = detail::get_pose_buffers(local_positions, local_rotations, world_positions, world_rotations, count);
+
+    return utility::re_transform::read_pose(*t, buffers);
+}
+
+uint32_t write_pose(::RETransform* t, sol::object local_positions, sol::object local_rotations, sol::object world_positions, sol::object world_rotations, sol::object mask_obj) {
+    if (t == nullptr) {
+        return 0;
+    }
+
+    const auto buffers = detail::get_pose_buffers(local_positions, local_rotations, world_positions, world_rotations, 0);
+
+    // Optional table of joint indices (0 based) to write.
+    std::vector<uint8_t> mask{};
+
+    if (mask_obj.is<sol::table>()) {
+        mask.resize(utility::re_transform::get_joint_count(*t), 0);
+
+        for (auto& [k, v] : mask_obj.as<sol::table>()) {
+            if (v.is<uint32_t>() && v.as<uint32_t>() < mask.size()) {
+                mask[v.as<uint32_t>()] = 1;
+            }
+        }
+
+        if (mask.empty()) {
+            return 0;
+        }
+    }
+
+    return utility::re_transform::write_pose(*t, buffers, mask);
+}
+}
+
+namespace api::native_array {
+// emplace for the Lua bindings, fix_pointers is only taken by the arrays without a capacity.
+template <typename T>
+T* emplace(sdk::NativeArray<T>& arr, sol::object) {
+    return arr.emplace();
+}
+
+template <typename T>
+T* emplace(sdk::NativeArrayNoCapacity<T>& arr, sol::object fix_pointers) {
+    return arr.emplace(fix_pointers.is<bool>() && fix_pointers.as<bool>());
+}
+}
+
 void bindings::open_sdk(ScriptState* s) {
     auto& lua = s->lua();
 
-    //lua["_sol_lua_push_objects"] = std::unordered_map<::REManagedObject*, sol::object>();
+    // Managed object bookkeeping lives natively in ScriptState, see managed_object_refs.
     lua.do_string(R"(
-        _sol_lua_push_objects = setmetatable({}, { __mode = "v" })
         _sol_lua_push_usertypes = {}
-        _sol_lua_push_ref_counts = {}
-        _sol_lua_push_ephemeral_counts = {}
     )");
 
     auto sdk = lua.create_table();
@@ -1387,6 +1571,10 @@ void bindings::open_sdk(ScriptState* s) {
     sdk["get_native_field"] = api::sdk::get_native_field;
     sdk["set_native_field"] = api::sdk::set_native_field;
     sdk["get_primary_camera"] = api::sdk::get_primary_camera;
+    sdk["find_objects_near"] = api::sdk::find_objects_near;
+    sdk["find_nearest_objects"] = api::sdk::find_nearest_objects;
+    sdk["find_component"] = api::sdk::find_component;
+    sdk["find_components"] = api::sdk::find_components;
     sdk["hook"] = api::sdk::hook;
     sdk["hook_vtable"] = api::sdk::hook_vtable;
     sdk.new_enum("PreHookResult", "CALL_ORIGINAL", HookManager::PreHookResult::CALL_ORIGINAL, "SKIP_ORIGINAL", HookManager::PreHookResult::SKIP_ORIGINAL);
@@ -1734,6 +1922,77 @@ void bindings::open_sdk(ScriptState* s) {
 
             utility::re_transform::apply_joints_tpose(*t, joints_vec, additional_parents);
         },
+        "find_joint", [](RETransform* t, sol::object name_or_hash) -> ::REManagedObject* {
+            if (t == nullptr) {
+                return nullptr;
+            }
+
+            if (name_or_hash.is<std::string>()) {
+                return (::REManagedObject*)utility::re_transform::find_joint(*t, utility::widen(name_or_hash.as<std::string>()));
+            }
+
+            if (name_or_hash.is<uint32_t>()) {
+                return (::REManagedObject*)utility::re_transform::find_joint_by_hash(*t, name_or_hash.as<uint32_t>());
+            }
+
+            throw sol::error("RETransform:find_joint expected a joint name or hash");
+        },
+        "resolve_joints", [](sol::this_state s, RETransform* t, sol::table names_or_hashes) -> sol::object {
+            if (t == nullptr) {
+                return sol::make_object(s, sol::lua_nil);
+            }
+
+            const auto count = names_or_hashes.size();
+
+            std::vector<std::wstring> names{};
+            std::vector<std::wstring_view> name_views{};
+            std::vector<uint32_t> hashes{};
+            std::vector<::REJoint*> joints(count);
+
+            names.reserve(count);
+            name_views.reserve(count);
+            hashes.reserve(count);
+
+            // Either all names or all hashes, decided by the first element.
+            const auto by_name = count > 0 && names_or_hashes.get<sol::object>(1).is<std::string>();
+
+            for (size_t i = 1; i <= count; ++i) {
+                const auto element = names_or_hashes.get<sol::object>(i);
+
+                if (by_name) {
+                    if (!element.is<std::string>()) {
+                        throw sol::error("RETransform:resolve_joints expected a table of joint names or a table of hashes");
+                    }
+
+                    name_views.emplace_back(names.emplace_back(utility::widen(element.as<std::string>())));
+                } else {
+                    if (!element.is<uint32_t>()) {
+                        throw sol::error("RETransform:resolve_joints expected a table of joint names or a table of hashes");
+                    }
+
+                    hashes.push_back(element.as<uint32_t>());
+                }
+            }
+
+            if (by_name) {
+                utility::re_transform::resolve_joints(*t, name_views, joints);
+            } else {
+                utility::re_transform::resolve_joints(*t, hashes, joints);
+            }
+
+            auto out = sol::state_view{s}.create_table((int)count, 0);
+
+            for (size_t i = 0; i < count; ++i) {
+                if (joints[i] != nullptr) {
+                    out[i + 1] = (::REManagedObject*)joints[i];
+                }
+            }
+
+            return out;
+        },
+        "get_joint_count", [](RETransform* t) { return t != nullptr ? utility::re_transform::get_joint_count(*t) : 0u; },
+        "read_pose", &api::re_transform::read_pose,
+        "write_pose", &api::re_transform::write_pose,
         "set_position", &sdk::set_transform_position,
         "set_rotation", &sdk::set_transform_rotation,
         "get_position", &sdk::get_transform_position,
@@ -1747,6 +2006,10 @@ void bindings::open_sdk(ScriptState* s) {
         "get_size", &sdk::SystemArray::get_size,
         "get_element", &sdk::SystemArray::get_element,
         "get_elements", &sdk::SystemArray::get_elements,
+        "get_num_elements", &sdk::SystemArray::get_num_elements,
+        "get_element_stride", &sdk::SystemArray::get_element_stride,
+        "get_contained_type", &sdk::SystemArray::get_contained_type,
+        "get_data", [](sdk::SystemArray* arr) { return (uintptr_t)arr->get_data(); },
         sol::meta_function::index, [](sol::this_state s, sdk::SystemArray* arr, sol::variadic_args args) {
             auto index = args[0];
             if (index.is<int32_t>()) {
@@ -1766,7 +2029,7 @@ void bindings::open_sdk(ScriptState* s) {
             auto next = [](sol::this_state s, sdk::SystemArray* arr, sol::object k) -> sol::variadic_results {
                 uint32_t i = k.is<sol::nil_t>() ? 0 : k.as<uint32_t>()+1;
                 sol::variadic_results results{};
-                if (i >= arr->size()) {
+                if (i >= arr->get_num_elements()) {
                     results.push_back(sol::make_object(s, sol::nil));\
                     results.push_back(sol::make_object(s, sol::nil));
                     return results;
@@ -1849,12 +2112,17 @@ void bindings::open_sdk(ScriptState* s) {
             return api::sdk::MemoryView((uint8_t*)&data, sizeof(C < T >));\
         },\
         "empty", & C < T >::empty, \
-        "emplace", & C < T >::emplace, \
-        "push_back", [](C < T >& arr, T value) { arr.push_back(value); },\
+        "emplace", [](sol::this_state s, C < T >& arr, sol::object fix_pointers) -> sol::object {\
+            const auto element = api::native_array::emplace(arr, fix_pointers);\
+            return element != nullptr ? sol::make_object(s, *element) : sol::make_object(s, sol::nil);\
+        },\
+        "push_back", [](C < T >& arr, T value) { return arr.push_back(value); },\
+        "append_range", [](C < T >& arr, std::vector<T> values) { arr.append_range(values); },\
         "pop_back", & C < T >::pop_back,\
         "size", & C < T >::size,\
         "get_size", & C < T >::size,\
         "erase", & C < T >::erase,\
+        "erase_range", & C < T >::erase_range,\
         "clear", & C < T >::clear,\
         sol::meta_function::index, [](sol::this_state s, C < T >& arr, uint32_t i) -> sol::object {\
             if (i >= arr.size()) { \
@@ -1896,12 +2164,16 @@ void bindings::open_sdk(ScriptState* s) {
             return api::sdk::MemoryView((uint8_t*)&data, sizeof(C < T >));\
         },\
         "empty", & C < T >::empty, \
-        "emplace", & C < T >::emplace, \
-        "push_back", [](C < T >& arr, T* value) { arr.push_back(*value); },\
+        "emplace", [](sol::this_state s, C < T >& arr, sol::object fix_pointers) -> sol::object {\
+            const auto element = api::native_array::emplace(arr, fix_pointers);\
+            return element != nullptr ? sol::make_object(s, element) : sol::make_object(s, sol::nil);\
+        },\
+        "push_back", [](C < T >& arr, T* value) { return arr.push_back(*value); },\
         "pop_back", & C < T >::pop_back,\
         "size", & C < T >::size,\
         "get_size", & C < T >::size,\
         "erase", & C < T >::erase,\
+        "erase_range", & C < T >::erase_range,\
         "clear", & C < T >::clear,\
         sol::meta_function::index, [](sol::this_state s, C < T >& arr, uint32_t i) -> sol::object {\
             if (i >= arr.size()) { \
@@ -1925,12 +2197,17 @@ void bindings::open_sdk(ScriptState* s) {
             return api::sdk::MemoryView((uint8_t*)&data, sizeof(C < T >));\
         },\
         "empty", & C < T >::empty, \
-        "emplace", & C < T >::emplace, \
-        "push_back", [](C < T >& arr, T value) { arr.push_back(value); },\
+        "emplace", [](sol::this_state s, C < T >& arr, sol::object fix_pointers) -> sol::object {\
+            const auto element = api::native_array::emplace(arr, fix_pointers);\
+            return element != nullptr ? sol::make_object(s, *element) : sol::make_object(s, sol::nil);\
+        },\
+        "push_back", [](C < T >& arr, T value) { return arr.push_back(value); },\
+        "append_range", [](C < T >& arr, std::vector<T> values) { arr.append_range(values); },\
         "pop_back", & C < T >::pop_back,\
         "size", & C < T >::size,\
         "get_size", & C < T >::size,\
         "erase", & C < T >::erase,\
+        "erase_range", & C < T >::erase_range,\
         "clear", & C < T >::clear,\
         sol::meta_function::index, [](sol::this_state s, C < T >& arr, uint32_t i) -> sol::object {\
             if (i >= arr.size()) { \
@@ -0,0 +1,242 @@
+#include <sstream>
+
+#include <sdk/MathBatch.hpp>
+
+#include "../ScriptRunner.hpp"
+
+#include "VecBuf.hpp"
+
+namespace api::vecbuf {
+namespace detail {
+void expect_type(const VecBuf& buf, std::initializer_list<Type> types, const char* fn) {
+    for (auto t : types) {
+        if (buf.type == t) {
+            return;
+        }
+    }
+
+    throw sol::error{(std::stringstream{} << "vecbuf." << fn << ": buffer has the wrong element type").str()};
+}
+
+void check_index(const VecBuf& buf, int64_t index) {
+    if (index < 1 || (size_t)index > buf.count) {
+        throw sol::error{(std::stringstream{} << "vecbuf: index " << index << " out of range [1, " << buf.count << "]").str()};
+    }
+}
+
+// Returns the output buffer passed in by the script, or a new one if it passed nil.
+// The output is resized to match the input.
+VecBuf& get_output(sol::this_state s, sol::object out_obj, Type type, size_t count, sol::object& holder) {
+    if (out_obj.is<VecBuf*>()) {
+        holder = out_obj;
+    } else {
+        holder = sol::make_object(s, VecBuf{type, count});
+    }
+
+    auto& out = *holder.as<VecBuf*>();
+
+    if (out.type != type) {
+        throw sol::error{"vecbuf: output buffer has the wrong element type"};
+    }
+
+    out.resize(count);
+    return out;
+}
+}
+
+VecBuf create(Type type, int64_t count) {
+    if (count < 0) {
+        throw sol::error{"vecbuf.new: count must not be negative"};
+    }
+
+    return VecBuf{type, (size_t)count};
+}
+
+sol::object get(sol::this_state s, VecBuf& buf, int64_t index) {
+    detail::check_index(buf, index);
+
+    const auto i = (size_t)index - 1;
+
+    switch (buf.type) {
+    case Type::FLOAT:
+        return sol::make_object(s, buf.floats()[i]);
+    case Type::VEC3:
+        return sol::make_object(s, Vector3f{buf.vec4s()[i]});
+    case Type::VEC4:
+        return sol::make_object(s, buf.vec4s()[i]);
+    case Type::QUAT:
+        return sol::make_object(s, buf.quats()[i]);
+    case Type::MAT4:
+        return sol::make_object(s, buf.mat4s()[i]);
+    default:
+        return sol::make_object(s, sol::lua_nil);
+    }
+}
+
+void set(VecBuf& buf, int64_t index, sol::object value) {
+    detail::check_index(buf, index);
+
+    const auto i = (size_t)index - 1;
+
+    switch (buf.type) {
+    case Type::FLOAT:
+        buf.floats()[i] = value.as<float>();
+        break;
+    case Type::VEC3:
+        if (value.is<Vector4f>()) {
+            buf.vec4s()[i] = Vector4f{Vector3f{value.as<Vector4f>()}, 0.0f};
+        } else {
+            buf.vec4s()[i] = Vector4f{value.as<Vector3f>(), 0.0f};
+        }
+        break;
+    case Type::VEC4:
+        buf.vec4s()[i] = value.as<Vector4f>();
+        break;
+    case Type::QUAT:
+        buf.quats()[i] = value.as<glm::quat>();
+        break;
+    case Type::MAT4:
+        buf.mat4s()[i] = value.as<Matrix4x4f>();
+        break;
+    default:
+        break;
+    }
+}
+
+VecBuf from_table(Type type, sol::table tbl) {
+    VecBuf buf{type, tbl.size()};
+
+    for (size_t i = 1; i <= buf.count; ++i) {
+        set(buf, (int64_t)i, tbl[i]);
+    }
+
+    return buf;
+}
+
+sol::table to_table(sol::this_state s, VecBuf& buf) {
+    auto tbl = sol::state_view{s}.create_table(buf.count, 0);
+
+    for (size_t i = 1; i <= buf.count; ++i) {
+        tbl[i] = get(s, buf, (int64_t)i);
+    }
+
+    return tbl;
+}
+
+sol::object transform_points(sol::this_state s, VecBuf& buf, const Matrix4x4f& m, sol::object out_obj) {
+    detail::expect_type(buf, {Type::VEC3, Type::VEC4}, "transform_points");
+
+    sol::object holder{};
+    auto& out = detail::get_output(s, out_obj, buf.type, buf.count, holder);
+
+    utility::math::batch::transform_points(buf.vec4s(), m, out.vec4s());
+    return holder;
+}
+
+sol::object transform_vectors(sol::this_state s, VecBuf& buf, const Matrix4x4f& m, sol::object out_obj) {
+    detail::expect_type(buf, {Type::VEC3, Type::VEC4}, "transform_vectors");
+
+    sol::object holder{};
+    auto& out = detail::get_output(s, out_obj, buf.type, buf.count, holder);
+
+    utility::math::batch::transform_vectors(buf.vec4s(), m, out.vec4s());
+    return holder;
+}
+
+sol::object transform_matrices(sol::this_state s, VecBuf& buf, const Matrix4x4f& m, sol::object out_obj) {
+    detail::expect_type(buf, {Type::MAT4}, "transform_matrices");
+
+    sol::object holder{};
+    auto& out = detail::get_output(s, out_obj, Type::MAT4, buf.count, holder);
+
+    utility::math::batch::transform_matrices(buf.mat4s(), m, out.mat4s());
+    return holder;
+}
+
+sol::object distances_to(sol::this_state s, VecBuf& buf, const Vector3f& point, sol::object out_obj) {
+    detail::expect_type(buf, {Type::VEC3, Type::VEC4}, "distances_to");
+
+    sol::object holder{};
+    auto& out = detail::get_output(s, out_obj, Type::FLOAT, buf.count, holder);
+
+    utility::math::batch::distances(buf.vec4s(), point, out.floats());
+    return holder;
+}
+
+std::tuple<size_t, sol::object> frustum_cull(sol::this_state s, VecBuf& buf, const Matrix4x4f& view_proj, sol::object radius_obj, sol::object out_obj) {
+    detail::expect_type(buf, {Type::VEC3, Type::VEC4}, "frustum_cull");
+
+    const auto radius = radius_obj.is<float>() ? radius_obj.as<float>() : 0.0f;
+
+    sol::object holder{};
+    auto& out = detail::get_output(s, out_obj, Type::FLOAT, buf.count, holder);
+
+    thread_local std::vector<uint8_t> visible{};
+    visible.resize(buf.count);
+
+    const auto count = utility::math::batch::frustum_cull(buf.vec4s(), view_proj, radius, visible);
+    auto out_floats = out.floats();
+
+    for (size_t i = 0; i < buf.count; ++i) {
+        out_floats[i] = (float)visible[i];
+    }
+
+    return std::make_tuple(count, holder);
+}
+
+void normalize(VecBuf& buf) {
+    detail::expect_type(buf, {Type::VEC3, Type::VEC4, Type::QUAT}, "normalize");
+
+    if (buf.type == Type::VEC3) {
+        utility::math::batch::normalize3(buf.vec4s());
+    } else {
+        utility::math::batch::normalize4(buf.vec4s());
+    }
+}
+
+sol::object slerp(sol::this_state s, VecBuf& a, VecBuf& b, float t, sol::object out_obj) {
+    detail::expect_type(a, {Type::QUAT}, "slerp");
+    detail::expect_type(b, {Type::QUAT}, "slerp");
+
+    sol::object holder{};
+    auto& out = detail::get_output(s, out_obj, Type::QUAT, std::min(a.count, b.count), holder);
+
+    utility::math::batch::slerp(a.quats(), b.quats(), t, out.quats());
+    return holder;
+}
+}
+
+void bindings::open_vecbuf(ScriptState* s) {
+    auto& lua = s->lua();
+    auto vecbuf = lua.create_table();
+
+    vecbuf.new_enum("Type",
+                    "FLOAT", api::vecbuf::Type::FLOAT,
+                    "VEC3", api::vecbuf::Type::VEC3,
+                    "VEC4", api::vecbuf::Type::VEC4,
+                    "QUAT", api::vecbuf::Type::QUAT,
+                    "MAT4", api::vecbuf::Type::MAT4);
+
+    vecbuf.new_usertype<api::vecbuf::VecBuf>("VecBuf",
+        sol::no_constructor,
+        sol::meta_function::length, [](api::vecbuf::VecBuf& buf) { return buf.count; },
+        "size", [](api::vecbuf::VecBuf& buf) { return buf.count; },
+        "get_type", [](api::vecbuf::VecBuf& buf) { return buf.type; },
+        "resize", [](api::vecbuf::VecBuf& buf, size_t count) { buf.resize(count); },
+        "get", api::vecbuf::get,
+        "set", api::vecbuf::set,
+        "to_table", api::vecbuf::to_table,
+        "transform_points", api::vecbuf::transform_points,
+        "transform_vectors", api::vecbuf::transform_vectors,
+        "transform_matrices", api::vecbuf::transform_matrices,
+        "distances_to", api::vecbuf::distances_to,
+        "frustum_cull", api::vecbuf::frustum_cull,
+        "normalize", api::vecbuf::normalize,
+        "slerp", api::vecbuf::slerp
+    );
+
+    vecbuf["new"] = api::vecbuf::create;
+    vecbuf["from_table"] = api::vecbuf::from_table;
+    vecbuf["slerp"] = api::vecbuf::slerp;
+    lua["vecbuf"] = vecbuf;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <sdk/Math.hpp>
+
+class ScriptState;
+
+namespace bindings {
+void open_vecbuf(ScriptState* s);
+}
+
+namespace api::vecbuf {
+enum class Type : uint32_t {
+    FLOAT,
+    VEC3,
+    VEC4,
+    QUAT,
+    MAT4,
+};
+
+// A typed, contiguous array that lives outside of the Lua heap so scripts can run
+// batch math over thousands of elements in a single call.
+// vec3 elements are padded to 16 bytes so the batch kernels can load them directly.
+struct VecBuf {
+    Type type{Type::VEC3};
+    size_t count{0};
+    std::vector<float> data{};
+
+    VecBuf(Type t, size_t n)
+        : type{t}
+    {
+        resize(n);
+    }
+
+    static size_t stride(Type t) {
+        switch (t) {
+        case Type::FLOAT:
+            return 1;
+        case Type::MAT4:
+            return 16;
+        default:
+            return 4;
+        }
+    }
+
+    void resize(size_t n) {
+        count = n;
+        data.resize(n * stride(type));
+    }
+
+    std::span<float> floats() { return {data.data(), count}; }
+    std::span<Vector4f> vec4s() { return {(Vector4f*)data.data(), count}; }
+    std::span<glm::quat> quats() { return {(glm::quat*)data.data(), count}; }
+    std::span<Matrix4x4f> mat4s() { return {(Matrix4x4f*)data.data(), count}; }
+};
+}
@@ -2,6 +2,7 @@
 #include "sdk/SceneManager.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/REManagedObject.hpp"
+#include "sdk/SceneIndex.hpp"
 
 #include "GameObjectsDisplay.hpp"
 
@@ -47,6 +48,9 @@ void GameObjectsDisplay::on_draw_dev_ui() {
     if (m_enabled->draw("Enabled") && !m_enabled->value()) {
         // todo
     }
+
+    m_max_distance->draw("Max Distance (0 = unlimited)");
+    ImGui::Text("Indexed objects: %zu", sdk::scene_index::size());
 }
 
 void GameObjectsDisplay::on_frame() {
@@ -54,93 +58,45 @@ void GameObjectsDisplay::on_frame() {
         return;
     }
 
-    auto scene = sdk::get_current_scene();
+    const auto camera = sdk::renderer::get_camera_snapshot();
 
-    if (scene == nullptr) {
+    if (!camera.valid) {
         return;
     }
 
-    auto context = sdk::get_thread_context();
+    // The scene index already did the walk over the transform list this frame,
+    // only the objects that can end up on screen are looked at here.
+    const auto max_distance = m_max_distance->value();
+    const auto objects = max_distance > 0.0f ? sdk::scene_index::find_near(Vector3f{camera.origin}, max_distance) 
+                                             : sdk::scene_index::find_in_frustum(camera.view_proj);
 
-    static auto scene_def = sdk::find_type_definition("via.Scene");
-    auto first_transform = sdk::call_native_func_easy<RETransform*>(scene, scene_def, "get_FirstTransform");
+    m_positions.clear();
 
-    if (first_transform == nullptr) {
-        return;
+    for (const auto& object : objects) {
+        m_positions.push_back(Vector4f{object.position, 1.0f});
     }
 
-    static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
-    static auto next_transform_method = transform_def->get_method("get_Next");
-    static auto get_gameobject_method = transform_def->get_method("get_GameObject");
-    static auto get_position_method = transform_def->get_method("get_Position");
-    static auto get_axisz_method = transform_def->get_method("get_AxisZ");
-
-    auto math = sdk::get_native_singleton("via.math");
-    auto math_t = sdk::find_type_definition("via.math");
+    m_screen_positions.resize(m_positions.size());
+    m_visible.resize(m_positions.size());
 
-    auto camera = sdk::get_primary_camera();
-
-    if (camera == nullptr) {
+    if (sdk::renderer::world_to_screen(m_positions, m_screen_positions, m_visible) == 0) {
         return;
     }
 
-    auto main_view = sdk::get_main_view();
-
-    if (main_view == nullptr) {
-        return;
-    }
-
-    auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
-    auto camera_transform = camera_gameobject->transform;
-
-    Vector4f camera_origin{};
-    get_position_method->call<void*>(&camera_origin, context, camera_transform);
-
-    Vector4f camera_forward{};
-    get_axisz_method->call<void*>(&camera_forward, context, camera_transform);
-
-    // Translate 2d position to 3d position (screen to world)
-    Matrix4x4f proj{}, view{};
-    float screen_size[2]{};
-    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
-    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
-    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
-
-    static auto world_to_screen = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)");
-
-    Vector4f pos{};
-    Vector4f screen_pos{};
-
     auto draw_list = ImGui::GetBackgroundDrawList();
+    const auto color = ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
 
-    for (auto transform = first_transform; 
-        transform != nullptr; 
-        transform = next_transform_method->call<RETransform*>(context, transform)) 
-    {
-        auto owner = get_gameobject_method->call<REGameObject*>(context, transform);
-
-        if (owner == nullptr) {
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (m_visible[i] == 0) {
             continue;
         }
 
-        auto owner_name = utility::re_string::get_string(owner->name);
+        const auto owner_name = utility::re_string::get_string(objects[i].owner->name);
 
         if (owner_name.empty()) {
             continue;
         }
 
-        get_position_method->call<void*>(&pos, context, transform);
-        pos.w = 1.0f;
-
-        const auto delta = pos - camera_origin;
-
-        // behind camera
-        if (glm::dot(delta, -camera_forward) <= 0.0f) {
-            continue;
-        }
-
-        world_to_screen->call<void*>(&screen_pos, context, &pos, &view, &proj, &screen_size);
-        draw_list->AddText(ImVec2(screen_pos.x, screen_pos.y), ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 1.0f)), owner_name.c_str());
+        draw_list->AddText(ImVec2(m_screen_positions[i].x, m_screen_positions[i].y), color, owner_name.c_str());
     }
 }
-
@@ -17,8 +17,15 @@ public:
 
 private:
     const ModToggle::Ptr m_enabled{ ModToggle::create(generate_name("Enabled")) };
+    const ModSlider::Ptr m_max_distance{ ModSlider::create(generate_name("MaxDistance"), 0.0f, 1000.0f, 0.0f) };
 
     ValueList m_options{
         *m_enabled,
+        *m_max_distance,
     };
+
+    // Reused every frame.
+    std::vector<Vector4f> m_positions{};
+    std::vector<Vector2f> m_screen_positions{};
+    std::vector<uint8_t> m_visible{};
 };
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "FrameTelemetry.hpp"
+
+namespace vrmod {
+namespace detail {
+float to_ms(FrameTelemetry::Clock::duration d) {
+    return std::chrono::duration<float, std::milli>(d).count();
+}
+
+// Nearest rank percentiles, values gets sorted.
+FrameTelemetry::Percentiles compute_percentiles(std::vector<float>& values) {
+    FrameTelemetry::Percentiles out{};
+
+    if (values.empty()) {
+        return out;
+    }
+
+    std::sort(values.begin(), values.end());
+
+    const auto at = [&](float p) {
+        const auto rank = (size_t)std::ceil(p * (float)values.size());
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    };
+
+    out.p50 = at(0.50f);
+    out.p90 = at(0.90f);
+    out.p99 = at(0.99f);
+    out.max = values.back();
+
+    return out;
+}
+}
+
+const char* FrameTelemetry::get_stage_name(Stage stage) {
+    switch (stage) {
+    case Stage::WAIT:
+        return "Wait";
+    case Stage::SYNC:
+        return "Sync";
+    case Stage::POSES:
+        return "Poses";
+    case Stage::RENDER:
+        return "Render";
+    case Stage::SUBMIT:
+        return "Submit";
+    default:
+        return "Unknown";
+    }
+}
+
+void FrameTelemetry::begin(Stage stage, Clock::time_point t) {
+    if (!this->enabled || stage >= Stage::COUNT) {
+        return;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    if (stage == Stage::WAIT) {
+        // Waiting again without a submit in between, the previous frame was dropped.
+        if (m_in_frame && m_stage_seen[(size_t)Stage::WAIT]) {
+            push_frame(false);
+        }
+
+        if (!m_in_frame) {
+            m_current = Frame{};
+            m_current.index = m_next_index++;
+            m_current.start = t;
+            m_current.interval_ms = m_last_start != Clock::time_point{} ? detail::to_ms(t - m_last_start) : 0.0f;
+            m_stage_seen = {};
+            m_last_start = t;
+            m_in_frame = true;
+        }
+    }
+
+    // Stages outside of a frame (before the first wait) aren't recorded.
+    if (!m_in_frame) {
+        return;
+    }
+
+    if (stage == Stage::SUBMIT && m_stage_seen[(size_t)Stage::POSES] && !m_stage_seen[(size_t)Stage::RENDER]) {
+        m_current.stage_ms[(size_t)Stage::RENDER] = detail::to_ms(t - m_poses_time);
+        m_stage_seen[(size_t)Stage::RENDER] = true;
+    }
+
+    m_stage_start[(size_t)stage] = t;
+}
+
+void FrameTelemetry::end(Stage stage, Clock::time_point t) {
+    if (!this->enabled || stage >= Stage::COUNT) {
+        return;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    if (!m_in_frame) {
+        return;
+    }
+
+    // Stages can run more than once per frame (one submit per eye), their times add up.
+    m_current.stage_ms[(size_t)stage] += detail::to_ms(t - m_stage_start[(size_t)stage]);
+    m_stage_seen[(size_t)stage] = true;
+
+    if (stage == Stage::POSES) {
+        m_poses_time = t;
+    }
+}
+
+void FrameTelemetry::end_frame(Clock::time_point t) {
+    if (!this->enabled) {
+        return;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    if (!m_in_frame) {
+        return;
+    }
+
+    if (m_stage_seen[(size_t)Stage::POSES]) {
+        m_current.pose_to_submit_ms = detail::to_ms(t - m_poses_time);
+    }
+
+    push_frame(true);
+}
+
+void FrameTelemetry::push_frame(bool submitted) {
+    m_current.submitted = submitted;
+    m_current.missed = !submitted;
+
+    if (submitted && m_current.interval_ms > 0.0f) {
+        if (m_num_intervals > 0) {
+            const auto n = std::min(m_num_intervals, INTERVAL_WINDOW);
+            std::array<float, INTERVAL_WINDOW> sorted{};
+            std::copy_n(m_intervals.begin(), n, sorted.begin());
+            std::nth_element(sorted.begin(), sorted.begin() + n / 2, sorted.begin() + n);
+
+            m_current.missed = m_current.interval_ms > sorted[n / 2] * MISSED_INTERVAL_FACTOR;
+        }
+
+        m_intervals[m_num_intervals % INTERVAL_WINDOW] = m_current.interval_ms;
+        ++m_num_intervals;
+    }
+
+    if (m_frames.size() < CAPACITY) {
+        m_frames.push_back(m_current);
+    } else {
+        m_frames[m_head] = m_current;
+    }
+
+    m_head = (m_head + 1) % CAPACITY;
+    m_in_frame = false;
+}
+
+void FrameTelemetry::clear() {
+    std::scoped_lock _{m_mtx};
+
+    m_frames.clear();
+    m_head = 0;
+    m_in_frame = false;
+    m_last_start = {};
+    m_num_intervals = 0;
+}
+
+std::vector<FrameTelemetry::Frame> FrameTelemetry::get_frames() const {
+    std::scoped_lock _{m_mtx};
+
+    if (m_frames.size() < CAPACITY) {
+        return m_frames;
+    }
+
+    std::vector<Frame> out{};
+    out.reserve(m_frames.size());
+    out.insert(out.end(), m_frames.begin() + m_head, m_frames.end());
+    out.insert(out.end(), m_frames.begin(), m_frames.begin() + m_head);
+
+    return out;
+}
+
+std::optional<FrameTelemetry::Frame> FrameTelemetry::get_latest_frame() const {
+    std::scoped_lock _{m_mtx};
+
+    if (m_frames.empty()) {
+        return std::nullopt;
+    }
+
+    return m_frames[(m_head + CAPACITY - 1) % CAPACITY];
+}
+
+FrameTelemetry::Summary FrameTelemetry::get_summary() const {
+    const auto frames = get_frames();
+
+    Summary out{};
+    out.frames = frames.size();
+
+    std::vector<float> values{};
+    values.reserve(frames.size());
+
+    for (size_t s = 0; s < NUM_STAGES; ++s) {
+        values.clear();
+
+        for (const auto& frame : frames) {
+            values.push_back(frame.stage_ms[s]);
+        }
+
+        out.stages[s] = detail::compute_percentiles(values);
+    }
+
+    values.clear();
+
+    for (const auto& frame : frames) {
+        out.missed += frame.missed ? 1 : 0;
+
+        if (frame.interval_ms > 0.0f) {
+            values.push_back(frame.interval_ms);
+        }
+    }
+
+    out.interval = detail::compute_percentiles(values);
+    values.clear();
+
+    for (const auto& frame : frames) {
+        if (frame.submitted) {
+            values.push_back(frame.pose_to_submit_ms);
+        }
+    }
+
+    out.pose_to_submit = detail::compute_percentiles(values);
+
+    return out;
+}
+
+bool FrameTelemetry::export_csv(const std::filesystem::path& path) const {
+    const auto frames = get_frames();
+
+    std::ofstream f{path};
+
+    if (!f) {
+        return false;
+    }
+
+    f << "frame,start_ms,interval_ms";
+
+    for (size_t s = 0; s < NUM_STAGES; ++s) {
+        f << "," << get_stage_name((Stage)s) << "_ms";
+    }
+
+    f << ",pose_to_submit_ms,submitted,missed\n";
+
+    const auto origin = frames.empty() ? Clock::time_point{} : frames.front().start;
+
+    for (const auto& frame : frames) {
+        f << frame.index << "," << detail::to_ms(frame.start - origin) << "," << frame.interval_ms;
+
+        for (const auto ms : frame.stage_ms) {
+            f << "," << ms;
+        }
+
+        f << "," << frame.pose_to_submit_ms << "," << (int)frame.submitted << "," << (int)frame.missed << "\n";
+    }
+
+    return f.good();
+}
+}
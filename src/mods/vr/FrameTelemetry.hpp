@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace vrmod {
+// Per-frame timings of the VR runtimes' frame loop, kept in a ring buffer.
+// A frame starts when the runtime begins waiting on the compositor and ends once it has been submitted.
+// Only depends on the standard library so it can be driven with made up timestamps, the UI lives in VR.cpp.
+class FrameTelemetry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage : uint8_t {
+        WAIT,   // WaitGetPoses / xrWaitFrame
+        SYNC,   // xrBeginFrame
+        POSES,  // update_poses
+        RENDER, // end of the pose fetch to the start of the submit
+        SUBMIT, // Submit / xrEndFrame
+        COUNT,
+    };
+
+    static constexpr size_t NUM_STAGES = (size_t)Stage::COUNT;
+    static constexpr size_t CAPACITY = 2048;
+
+    struct Frame {
+        uint64_t index{0};
+        Clock::time_point start{};
+        std::array<float, NUM_STAGES> stage_ms{};
+        float interval_ms{0.0f};        // start of the previous frame to the start of this one
+        float pose_to_submit_ms{0.0f};  // age of the poses when the frame was submitted
+        bool submitted{false};
+        bool missed{false};             // never submitted, or took much longer than the frames around it
+    };
+
+    struct Percentiles {
+        float p50{0.0f};
+        float p90{0.0f};
+        float p99{0.0f};
+        float max{0.0f};
+    };
+
+    struct Summary {
+        size_t frames{0};
+        size_t missed{0};
+        std::array<Percentiles, NUM_STAGES> stages{};
+        Percentiles interval{};
+        Percentiles pose_to_submit{};
+    };
+
+    static const char* get_stage_name(Stage stage);
+
+    // Time points default to now, they're only passed explicitly to replay recorded timings.
+    void begin(Stage stage, Clock::time_point t = Clock::now());
+    void end(Stage stage, Clock::time_point t = Clock::now());
+
+    // Closes the current frame as submitted. SUBMIT must have ended already.
+    void end_frame(Clock::time_point t = Clock::now());
+
+    void clear();
+
+    // Oldest first.
+    std::vector<Frame> get_frames() const;
+    // The most recently closed frame, without copying the whole buffer.
+    std::optional<Frame> get_latest_frame() const;
+    Summary get_summary() const;
+
+    bool export_csv(const std::filesystem::path& path) const;
+
+    // Toggled from the UI thread while the runtimes record.
+    std::atomic<bool> enabled{true};
+
+private:
+    void push_frame(bool submitted);
+
+    static constexpr size_t INTERVAL_WINDOW = 64;
+    static constexpr float MISSED_INTERVAL_FACTOR = 1.5f;
+
+    mutable std::mutex m_mtx{};
+
+    std::vector<Frame> m_frames{};
+    size_t m_head{0}; // next slot to write
+    uint64_t m_next_index{0};
+
+    Frame m_current{};
+    std::array<Clock::time_point, NUM_STAGES> m_stage_start{};
+    std::array<bool, NUM_STAGES> m_stage_seen{};
+    bool m_in_frame{false};
+    Clock::time_point m_last_start{};
+    Clock::time_point m_poses_time{};
+    Clock::time_point m_render_start{};
+
+    // Recent intervals of submitted frames, for spotting the ones that took too long.
+    std::array<float, INTERVAL_WINDOW> m_intervals{};
+    size_t m_num_intervals{0};
+};
+}
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include "SessionRecording.hpp"
+
+namespace vrmod {
+namespace detail {
+// Guards against allocating garbage sizes from a corrupted file.
+constexpr uint32_t MAX_ACTIONS = 64;
+constexpr uint32_t MAX_NAME_LENGTH = 256;
+constexpr uint32_t MAX_FRAMES = 1 << 24;
+
+template <typename T>
+void write(std::ofstream& f, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    f.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+bool read(std::ifstream& f, T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return (bool)f.read((char*)&value, sizeof(T));
+}
+
+void write_frame(std::ofstream& f, const SessionRecording::Frame& frame) {
+    write(f, frame.time_ns);
+    write(f, frame.flags);
+    write(f, (uint32_t)frame.devices.size());
+
+    for (const auto& device : frame.devices) {
+        write(f, device.index);
+        write(f, device.pose.transform);
+        write(f, device.pose.velocity);
+        write(f, device.pose.angular_velocity);
+    }
+
+    write(f, frame.eyes);
+    write(f, frame.projections);
+    write(f, frame.raw_projections);
+    write(f, frame.sticks);
+    write(f, frame.actions);
+}
+
+bool read_frame(std::ifstream& f, SessionRecording::Frame& frame) {
+    uint32_t num_devices{0};
+
+    if (!read(f, frame.time_ns) || !read(f, frame.flags) || !read(f, num_devices)) {
+        return false;
+    }
+
+    if (num_devices > VRRuntime::PoseSnapshot::MAX_DEVICES) {
+        return false;
+    }
+
+    frame.devices.resize(num_devices);
+
+    for (auto& device : frame.devices) {
+        if (!read(f, device.index) || !read(f, device.pose.transform) || !read(f, device.pose.velocity) || !read(f, device.pose.angular_velocity)) {
+            return false;
+        }
+
+        if (device.index >= VRRuntime::PoseSnapshot::MAX_DEVICES) {
+            return false;
+        }
+
+        device.pose.valid = true;
+    }
+
+    return read(f, frame.eyes) && read(f, frame.projections) && read(f, frame.raw_projections) && read(f, frame.sticks) && read(f, frame.actions);
+}
+}
+
+std::optional<std::string> SessionRecording::save(const std::filesystem::path& path) const {
+    std::ofstream f{path, std::ios::binary};
+
+    if (!f) {
+        return "Could not open " + path.string();
+    }
+
+    f.write(MAGIC, sizeof(MAGIC));
+    detail::write(f, VERSION);
+    detail::write(f, this->width);
+    detail::write(f, this->height);
+    detail::write(f, this->controllers);
+    detail::write(f, (uint32_t)std::min<size_t>(this->actions.size(), detail::MAX_ACTIONS));
+
+    for (size_t i = 0; i < this->actions.size() && i < detail::MAX_ACTIONS; ++i) {
+        const auto& name = this->actions[i];
+        const auto length = (uint32_t)std::min<size_t>(name.size(), detail::MAX_NAME_LENGTH);
+
+        detail::write(f, length);
+        f.write(name.data(), length);
+    }
+
+    detail::write(f, (uint32_t)this->frames.size());
+
+    for (const auto& frame : this->frames) {
+        detail::write_frame(f, frame);
+    }
+
+    if (!f) {
+        return "Failed to write " + path.string();
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> SessionRecording::load(const std::filesystem::path& path, SessionRecording& out) {
+    std::ifstream f{path, std::ios::binary};
+
+    if (!f) {
+        return "Could not open " + path.string();
+    }
+
+    char magic[4]{};
+    uint32_t version{0};
+
+    if (!f.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return path.string() + " is not a session recording";
+    }
+
+    if (!detail::read(f, version) || version != VERSION) {
+        return "Unsupported session recording version " + std::to_string(version);
+    }
+
+    SessionRecording result{};
+    uint32_t num_actions{0};
+
+    if (!detail::read(f, result.width) || !detail::read(f, result.height) || !detail::read(f, result.controllers)
+        || !detail::read(f, num_actions) || num_actions > detail::MAX_ACTIONS)
+    {
+        return "Corrupted session recording header";
+    }
+
+    for (const auto index : result.controllers) {
+        if (index >= VRRuntime::PoseSnapshot::MAX_DEVICES) {
+            return "Corrupted session recording header";
+        }
+    }
+
+    for (uint32_t i = 0; i < num_actions; ++i) {
+        uint32_t length{0};
+
+        if (!detail::read(f, length) || length > detail::MAX_NAME_LENGTH) {
+            return "Corrupted session recording action list";
+        }
+
+        std::string name(length, '\0');
+
+        if (!f.read(name.data(), length)) {
+            return "Corrupted session recording action list";
+        }
+
+        result.actions.push_back(std::move(name));
+    }
+
+    uint32_t num_frames{0};
+
+    if (!detail::read(f, num_frames) || num_frames > detail::MAX_FRAMES) {
+        return "Corrupted session recording frame count";
+    }
+
+    result.frames.resize(num_frames);
+
+    for (uint32_t i = 0; i < num_frames; ++i) {
+        if (!detail::read_frame(f, result.frames[i])) {
+            return "Corrupted session recording frame " + std::to_string(i);
+        }
+    }
+
+    out = std::move(result);
+    return std::nullopt;
+}
+
+int32_t SessionRecording::find_action(std::string_view name) const {
+    for (size_t i = 0; i < this->actions.size(); ++i) {
+        if (this->actions[i] == name) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+void SessionRecorder::start(uint32_t width, uint32_t height, const std::array<uint32_t, 2>& controllers, std::vector<std::string> actions) {
+    std::scoped_lock _{m_mtx};
+
+    if (actions.size() > 64) {
+        actions.resize(64);
+    }
+
+    m_session = SessionRecording{};
+    m_session.width = width;
+    m_session.height = height;
+    m_session.controllers = controllers;
+    m_session.actions = std::move(actions);
+    m_start = std::chrono::steady_clock::now();
+    m_recording = true;
+}
+
+SessionRecording SessionRecorder::stop() {
+    std::scoped_lock _{m_mtx};
+
+    m_recording = false;
+    return std::move(m_session);
+}
+
+void SessionRecorder::capture(const VRRuntime::PoseSnapshot& snapshot, const std::array<Vector2f, 2>& sticks, const std::array<uint64_t, 2>& actions) {
+    if (!m_recording) {
+        return;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    if (!m_recording || m_session.frames.size() >= MAX_FRAMES) {
+        return;
+    }
+
+    auto& frame = m_session.frames.emplace_back();
+
+    frame.time_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+
+    for (uint32_t i = 0; i < snapshot.num_devices && i < VRRuntime::PoseSnapshot::MAX_DEVICES; ++i) {
+        if (snapshot.devices[i].valid) {
+            frame.devices.push_back(SessionRecording::Device{i, snapshot.devices[i]});
+        }
+    }
+
+    frame.eyes = snapshot.eyes;
+    frame.projections = snapshot.projections;
+    frame.raw_projections = snapshot.raw_projections;
+    frame.sticks = sticks;
+    frame.actions = actions;
+}
+
+void SessionRecorder::flag_last_frame(uint32_t flags) {
+    std::scoped_lock _{m_mtx};
+
+    if (m_recording && !m_session.frames.empty()) {
+        m_session.frames.back().flags |= flags;
+    }
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "runtimes/VRRuntime.hpp"
+
+namespace vrmod {
+// Poses, eye matrices and controller input of a VR session, one entry per runtime frame.
+// Written by SessionRecorder and played back by runtimes::MockRuntime.
+struct SessionRecording {
+    static constexpr char MAGIC[4]{'R', 'F', 'V', 'R'};
+    static constexpr uint32_t VERSION = 2;
+
+    // Filled in from the runtime's FrameTelemetry once the frame has ended, see SessionRecorder::flag_last_frame.
+    enum FrameFlags : uint32_t {
+        DROPPED = 1 << 0,    // never submitted, the mock waits for it and throws it away
+        LATE_POSES = 1 << 1, // submitted well past its interval, the mock hands out the previous frame's poses
+    };
+
+    struct Device {
+        uint32_t index{0};
+        VRRuntime::PoseSnapshot::Device pose{};
+    };
+
+    struct Frame {
+        uint64_t time_ns{0}; // since the recording started
+        uint32_t flags{0};
+
+        std::vector<Device> devices{}; // only the valid ones
+        std::array<Matrix4x4f, 2> eyes{};
+        std::array<Matrix4x4f, 2> projections{};
+        std::array<Vector4f, 2> raw_projections{};
+
+        std::array<Vector2f, 2> sticks{};   // indexed by VRRuntime::Hand
+        std::array<uint64_t, 2> actions{};  // bit i is actions[i], indexed by VRRuntime::Hand
+    };
+
+    uint32_t width{0};
+    uint32_t height{0};
+    std::array<uint32_t, 2> controllers{1, 2}; // device indices, indexed by VRRuntime::Hand
+    std::vector<std::string> actions{}; // at most 64
+    std::vector<Frame> frames{};
+
+    // Returns an error message on failure.
+    std::optional<std::string> save(const std::filesystem::path& path) const;
+    static std::optional<std::string> load(const std::filesystem::path& path, SessionRecording& out);
+
+    // -1 if the action wasn't recorded.
+    int32_t find_action(std::string_view name) const;
+};
+
+// Captures what the runtime hands out every frame, so judder and input bugs can be replayed without a headset.
+class SessionRecorder {
+public:
+    void start(uint32_t width, uint32_t height, const std::array<uint32_t, 2>& controllers, std::vector<std::string> actions);
+    // Returns the recording made since start.
+    SessionRecording stop();
+
+    bool is_recording() const {
+        return m_recording;
+    }
+
+    size_t size() const {
+        std::scoped_lock _{m_mtx};
+        return m_session.frames.size();
+    }
+
+    // sticks and actions are laid out like in SessionRecording::Frame.
+    void capture(const VRRuntime::PoseSnapshot& snapshot, const std::array<Vector2f, 2>& sticks, const std::array<uint64_t, 2>& actions);
+
+    // Adds FrameFlags to the last captured frame, its fate is only known after the next one started.
+    void flag_last_frame(uint32_t flags);
+
+private:
+    // Keeps a forgotten recording from eating all the memory, ~20 minutes at 90hz.
+    static constexpr size_t MAX_FRAMES = 90 * 60 * 20;
+
+    mutable std::mutex m_mtx{};
+    SessionRecording m_session{};
+    std::chrono::steady_clock::time_point m_start{};
+    std::atomic<bool> m_recording{false};
+};
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <thread>
+
+#include "MockRuntime.hpp"
+
+namespace runtimes {
+std::optional<std::string> MockRuntime::load(const std::filesystem::path& path) {
+    vrmod::SessionRecording recording{};
+
+    if (auto err = vrmod::SessionRecording::load(path, recording)) {
+        this->error = err;
+        return err;
+    }
+
+    this->load(std::move(recording));
+    return std::nullopt;
+}
+
+void MockRuntime::load(vrmod::SessionRecording recording) {
+    this->recording = std::move(recording);
+    this->frame_index = 0;
+    this->last_posed_index = 0;
+    this->previous_actions = {};
+    this->loop_offset_ns = 0;
+    this->replay_start = {};
+    this->frames_played = 0;
+    this->frames_dropped = 0;
+    this->late_poses = 0;
+
+    this->loaded = !this->recording.frames.empty();
+    this->error = this->loaded ? std::nullopt : std::optional<std::string>{"Session recording has no frames"};
+    this->got_first_sync = false;
+    this->got_first_poses = false;
+    this->frame_synced = false;
+    this->needs_pose_update = true;
+
+    this->telemetry.clear();
+}
+
+bool MockRuntime::is_dropped(size_t index) const {
+    const auto& frame = this->recording.frames[index];
+    const auto every = this->simulation.drop_every;
+
+    return (frame.flags & vrmod::SessionRecording::DROPPED) != 0 || (every > 0 && (index + 1) % every == 0);
+}
+
+bool MockRuntime::has_late_poses(size_t index) const {
+    const auto& frame = this->recording.frames[index];
+    const auto every = this->simulation.late_poses_every;
+
+    return (frame.flags & vrmod::SessionRecording::LATE_POSES) != 0 || (every > 0 && (index + 1) % every == 0);
+}
+
+void MockRuntime::advance() {
+    ++this->frame_index;
+
+    if (this->simulation.loop && this->frame_index >= this->recording.frames.size()) {
+        const auto& frames = this->recording.frames;
+        const auto last = frames.back().time_ns;
+        const auto period = frames.size() > 1 ? last - frames[frames.size() - 2].time_ns : 0;
+
+        // Keep the timeline going forward, the first frame plays one period after the last one.
+        this->loop_offset_ns += last - frames.front().time_ns + period;
+        this->frame_index = 0;
+    }
+}
+
+VRRuntime::Error MockRuntime::synchronize_frame() {
+    if (!this->loaded || this->finished()) {
+        return VRRuntime::Error::UNSPECIFIED;
+    }
+
+    if (this->frame_synced) {
+        return VRRuntime::Error::SUCCESS;
+    }
+
+    const auto wait = [this]() {
+        this->telemetry.begin(vrmod::FrameTelemetry::Stage::WAIT);
+
+        if (this->simulation.pace_in_real_time) {
+            const auto time = std::chrono::nanoseconds{this->loop_offset_ns + this->recording.frames[this->frame_index].time_ns};
+
+            if (this->replay_start == std::chrono::steady_clock::time_point{}) {
+                this->replay_start = std::chrono::steady_clock::now() - time;
+            }
+
+            std::this_thread::sleep_until(this->replay_start + time);
+        }
+
+        this->telemetry.end(vrmod::FrameTelemetry::Stage::WAIT);
+    };
+
+    // Dropped frames are waited for like any other, then thrown away without a submit.
+    // Bounded so a recording with every frame dropped doesn't spin forever.
+    for (size_t i = 0; i < this->recording.frames.size() && this->is_dropped(this->frame_index); ++i) {
+        wait();
+        ++this->frames_dropped;
+        this->advance();
+
+        if (this->finished()) {
+            return VRRuntime::Error::UNSPECIFIED;
+        }
+    }
+
+    wait();
+
+    this->got_first_sync = true;
+    this->frame_synced = true;
+
+    return VRRuntime::Error::SUCCESS;
+}
+
+VRRuntime::Error MockRuntime::update_poses() {
+    if (!this->loaded || this->finished()) {
+        return VRRuntime::Error::SUCCESS;
+    }
+
+    std::unique_lock _{ this->pose_mtx };
+
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::POSES);
+
+    // Late poses are the ones the previous frame got.
+    if (this->got_first_poses && this->has_late_poses(this->frame_index)) {
+        ++this->late_poses;
+    } else {
+        this->last_posed_index = this->frame_index;
+    }
+
+    const auto& frame = this->recording.frames[this->last_posed_index];
+
+    this->update_pose_snapshot([&frame](PoseSnapshot& snapshot) {
+        snapshot.num_devices = 0;
+
+        for (auto& device : snapshot.devices) {
+            device = PoseSnapshot::Device{};
+        }
+
+        for (const auto& device : frame.devices) {
+            snapshot.devices[device.index] = device.pose;
+            snapshot.num_devices = std::max(snapshot.num_devices, device.index + 1);
+        }
+    });
+
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::POSES);
+
+    this->needs_pose_update = false;
+    this->got_first_poses = true;
+    return VRRuntime::Error::SUCCESS;
+}
+
+VRRuntime::Error MockRuntime::update_matrices(float nearz, float farz) {
+    if (!this->loaded) {
+        return VRRuntime::Error::SUCCESS;
+    }
+
+    std::unique_lock _{ this->eyes_mtx };
+
+    // The recorded projections keep the clip planes they were recorded with.
+    const auto& frame = this->recording.frames[this->last_posed_index];
+
+    this->eyes = frame.eyes;
+    this->projections = frame.projections;
+    this->raw_projections[0] = frame.raw_projections[0];
+    this->raw_projections[1] = frame.raw_projections[1];
+
+    this->update_eye_snapshot();
+
+    return VRRuntime::Error::SUCCESS;
+}
+
+VRRuntime::Error MockRuntime::submit() {
+    if (!this->loaded || !this->frame_synced) {
+        return VRRuntime::Error::UNSPECIFIED;
+    }
+
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::SUBMIT);
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::SUBMIT);
+    this->telemetry.end_frame();
+
+    ++this->frames_played;
+    this->previous_actions = this->get_input_frame().actions;
+    this->frame_synced = false;
+    this->needs_pose_update = true;
+    this->advance();
+
+    return VRRuntime::Error::SUCCESS;
+}
+
+const vrmod::SessionRecording::Frame& MockRuntime::get_input_frame() const {
+    return this->recording.frames[std::min(this->frame_index, this->recording.frames.size() - 1)];
+}
+
+bool MockRuntime::get_action_bit(const std::array<uint64_t, 2>& actions, int32_t action, VRRuntime::Hand hand) const {
+    if (action < 0 || (size_t)action >= std::min<size_t>(this->recording.actions.size(), 64) || hand > VRRuntime::Hand::RIGHT) {
+        return false;
+    }
+
+    return (actions[hand] & (1ull << action)) != 0;
+}
+
+bool MockRuntime::is_action_active(int32_t action, VRRuntime::Hand hand) const {
+    if (!this->loaded) {
+        return false;
+    }
+
+    return this->get_action_bit(this->get_input_frame().actions, action, hand);
+}
+
+bool MockRuntime::is_action_pressed(int32_t action, VRRuntime::Hand hand) const {
+    return this->is_action_active(action, hand) && !this->get_action_bit(this->previous_actions, action, hand);
+}
+
+bool MockRuntime::is_action_released(int32_t action, VRRuntime::Hand hand) const {
+    return this->loaded && !this->is_action_active(action, hand) && this->get_action_bit(this->previous_actions, action, hand);
+}
+
+Vector2f MockRuntime::get_stick_axis(VRRuntime::Hand hand) const {
+    if (!this->loaded || hand > VRRuntime::Hand::RIGHT) {
+        return Vector2f{};
+    }
+
+    return this->get_input_frame().sticks[hand];
+}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+
+#include "../SessionRecording.hpp"
+#include "VRRuntime.hpp"
+
+namespace runtimes {
+// Plays back a vrmod::SessionRecording as if it came from a headset, one recorded frame per
+// synchronize_frame/submit pair. Doesn't depend on any runtime or graphics API.
+struct MockRuntime final : public VRRuntime {
+    struct Simulation {
+        bool pace_in_real_time{false}; // sleep in synchronize_frame until the recorded frame time
+        bool loop{true};
+        uint32_t drop_every{0};        // also drop every nth frame, on top of the recorded flags
+        uint32_t late_poses_every{0};  // also hand out stale poses every nth frame
+    };
+
+    MockRuntime() {
+        this->custom_stage = SynchronizeStage::EARLY;
+    }
+
+    MockRuntime(vrmod::SessionRecording recording, const Simulation& simulation)
+        : MockRuntime{}
+    {
+        this->simulation = simulation;
+        this->load(std::move(recording));
+    }
+
+    std::string_view name() const override {
+        return "Mock";
+    }
+
+    VRRuntime::Type type() const override {
+        return VRRuntime::Type::MOCK;
+    }
+
+    bool ready() const override {
+        return VRRuntime::ready() && this->got_first_poses;
+    }
+
+    std::optional<std::string> load(const std::filesystem::path& path);
+    void load(vrmod::SessionRecording recording);
+
+    VRRuntime::Error synchronize_frame() override;
+    VRRuntime::Error update_poses() override;
+    VRRuntime::Error update_matrices(float nearz, float farz) override;
+
+    uint32_t get_width() const override {
+        return this->recording.width;
+    }
+
+    uint32_t get_height() const override {
+        return this->recording.height;
+    }
+
+    // Stands in for the compositor submit, ends the current frame.
+    VRRuntime::Error submit();
+
+    // action is an index into recording.actions, see SessionRecording::find_action.
+    // Pressed and released compare against the last submitted frame.
+    bool is_action_active(int32_t action, VRRuntime::Hand hand) const;
+    bool is_action_pressed(int32_t action, VRRuntime::Hand hand) const;
+    bool is_action_released(int32_t action, VRRuntime::Hand hand) const;
+    Vector2f get_stick_axis(VRRuntime::Hand hand) const;
+
+    // Replay position, wraps around when looping.
+    size_t get_frame_index() const {
+        return this->frame_index;
+    }
+
+    // Every recorded frame has been played and looping is off.
+    bool finished() const {
+        return this->recording.frames.empty() || (!this->simulation.loop && this->frame_index >= this->recording.frames.size());
+    }
+
+    void destroy() override {
+        this->loaded = false;
+    }
+
+    Simulation simulation{};
+    vrmod::SessionRecording recording{};
+
+    // Read by the UI while the render thread replays.
+    std::atomic<size_t> frames_played{0};
+    std::atomic<size_t> frames_dropped{0};
+    std::atomic<size_t> late_poses{0};
+
+private:
+    bool is_dropped(size_t index) const;
+    bool has_late_poses(size_t index) const;
+    void advance();
+    const vrmod::SessionRecording::Frame& get_input_frame() const;
+    bool get_action_bit(const std::array<uint64_t, 2>& actions, int32_t action, VRRuntime::Hand hand) const;
+
+    size_t frame_index{0};
+    size_t last_posed_index{0};
+    std::array<uint64_t, 2> previous_actions{};
+    std::chrono::steady_clock::time_point replay_start{};
+    uint64_t loop_offset_ns{0};
+};
+}
@@ -13,7 +13,10 @@ VRRuntime::Error OpenVR::synchronize_frame() {
     }
 
     vr::VRCompositor()->SetTrackingSpace(vr::TrackingUniverseStanding);
+
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::WAIT);
     auto ret = vr::VRCompositor()->WaitGetPoses(this->real_render_poses.data(), vr::k_unMaxTrackedDeviceCount, this->real_game_poses.data(), vr::k_unMaxTrackedDeviceCount);
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::WAIT);
 
     if (ret == vr::VRCompositorError_None) {
         this->got_first_sync = true;
@@ -30,7 +33,28 @@ VRRuntime::Error OpenVR::update_poses() {
 
     std::unique_lock _{ this->pose_mtx };
 
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::POSES);
+
     memcpy(this->render_poses.data(), this->real_render_poses.data(), sizeof(this->render_poses));
+
+    this->update_pose_snapshot([this](PoseSnapshot& snapshot) {
+        static_assert(PoseSnapshot::MAX_DEVICES == vr::k_unMaxTrackedDeviceCount);
+
+        snapshot.num_devices = vr::k_unMaxTrackedDeviceCount;
+
+        for (uint32_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i) {
+            const auto& pose = this->render_poses[i];
+            auto& device = snapshot.devices[i];
+
+            device.transform = glm::rowMajor4(Matrix4x4f{ *(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking });
+            device.velocity = Vector4f{ pose.vVelocity.v[0], pose.vVelocity.v[1], pose.vVelocity.v[2], 0.0f };
+            device.angular_velocity = Vector4f{ pose.vAngularVelocity.v[0], pose.vAngularVelocity.v[1], pose.vAngularVelocity.v[2], 0.0f };
+            device.valid = true;
+        }
+    });
+
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::POSES);
+
     this->needs_pose_update = false;
     return VRRuntime::Error::SUCCESS;
 }
@@ -101,6 +125,8 @@ VRRuntime::Error OpenVR::update_matrices(float nearz, float farz){
     this->hmd->GetProjectionRaw(vr::Eye_Left, &this->raw_projections[vr::Eye_Left][0], &this->raw_projections[vr::Eye_Left][1], &this->raw_projections[vr::Eye_Left][2], &this->raw_projections[vr::Eye_Left][3]);
     this->hmd->GetProjectionRaw(vr::Eye_Right, &this->raw_projections[vr::Eye_Right][0], &this->raw_projections[vr::Eye_Right][1], &this->raw_projections[vr::Eye_Right][2], &this->raw_projections[vr::Eye_Right][3]);
 
+    this->update_eye_snapshot();
+
     return VRRuntime::Error::SUCCESS;
 }
 
@@ -4,6 +4,7 @@
 
 #include <json.hpp>
 #include <utility/String.hpp>
+#include <utility/ScopeGuard.hpp>
 #include <imgui.h>
 
 #include "REFramework.hpp"
@@ -26,11 +27,13 @@ VRRuntime::Error OpenXR::synchronize_frame() {
     }
 
     this->begin_profile();
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::WAIT);
 
     XrFrameWaitInfo frame_wait_info{XR_TYPE_FRAME_WAIT_INFO};
     this->frame_state = {XR_TYPE_FRAME_STATE};
     auto result = xrWaitFrame(this->session, &frame_wait_info, &this->frame_state);
 
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::WAIT);
     this->end_profile("xrWaitFrame");
 
     if (result != XR_SUCCESS) {
@@ -67,6 +70,11 @@ VRRuntime::Error OpenXR::update_poses() {
         return VRRuntime::Error::SUCCESS;
     }
 
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::POSES);
+
+    // Ends the stage on the error returns too.
+    ScopeGuard ___{[this]() { this->telemetry.end(vrmod::FrameTelemetry::Stage::POSES); }};
+
     XrViewLocateInfo view_locate_info{XR_TYPE_VIEW_LOCATE_INFO};
     view_locate_info.viewConfigurationType = this->view_config;
     view_locate_info.displayTime = display_time;
@@ -108,6 +116,26 @@ VRRuntime::Error OpenXR::update_poses() {
         }
     }
 
+    this->update_pose_snapshot([this](PoseSnapshot& snapshot) {
+        snapshot.num_devices = 3;
+
+        auto& hmd = snapshot.devices[0];
+        hmd.transform = Matrix4x4f{*(glm::quat*)&this->view_space_location.pose.orientation};
+        hmd.transform[3] = Vector4f{*(Vector3f*)&this->view_space_location.pose.position, 1.0f};
+        hmd.valid = !this->stage_views.empty();
+
+        for (auto i = 0; i < 2; ++i) {
+            const auto& hand = this->hands[i];
+            auto& device = snapshot.devices[i + 1];
+
+            device.transform = Matrix4x4f{*(glm::quat*)&hand.location.pose.orientation};
+            device.transform[3] = Vector4f{*(Vector3f*)&hand.location.pose.position, 1.0f};
+            device.velocity = Vector4f{*(Vector3f*)&hand.velocity.linearVelocity, 0.0f};
+            device.angular_velocity = Vector4f{*(Vector3f*)&hand.velocity.angularVelocity, 0.0f};
+            device.valid = true;
+        }
+    });
+
     this->needs_pose_update = false;
     this->got_first_poses = true;
     return VRRuntime::Error::SUCCESS;
@@ -241,6 +269,8 @@ VRRuntime::Error OpenXR::update_matrices(float nearz, float farz) {
         this->eyes[i][3] = Vector4f{*(Vector3f*)&pose.position, 1.0f};
     }
 
+    this->update_eye_snapshot();
+
     return VRRuntime::Error::SUCCESS;
 }
 
@@ -263,9 +293,14 @@ VRRuntime::Error OpenXR::update_input() {
     }
 
     const auto current_interaction_profile = this->get_current_interaction_profile();
+    const auto prev_states = this->action_states.get();
+    const auto& actions = this->action_set.actions;
+
+    ActionStates states{};
 
     for (auto i = 0; i < 2; ++i) {
         auto& hand = this->hands[i];
+        auto& hand_states = states.hands[i];
         hand.forced_actions.clear();
 
         // Update controller pose state
@@ -285,24 +320,88 @@ VRRuntime::Error OpenXR::update_input() {
 
         hand.active = pose_state.isActive;
 
+        // Read every input action once, all of the queries until the next sync go through the cached states.
+        for (size_t j = 0; j < actions.size() && j < ActionStates::MAX_ACTIONS; ++j) {
+            const auto action = actions[j];
+            auto& state = hand_states[j];
+
+            get_info.action = action;
+
+            if (this->action_set.bool_actions.contains(action)) {
+                XrActionStateBoolean active{XR_TYPE_ACTION_STATE_BOOLEAN};
+                result = xrGetActionStateBoolean(this->session, &get_info, &active);
+
+                state.active = result == XR_SUCCESS && active.isActive == XR_TRUE && active.currentState == XR_TRUE;
+            } else if (this->action_set.float_actions.contains(action)) {
+                XrActionStateFloat active{XR_TYPE_ACTION_STATE_FLOAT};
+                result = xrGetActionStateFloat(this->session, &get_info, &active);
+
+                if (result == XR_SUCCESS) {
+                    state.axis.x = active.currentState;
+                    state.active = active.isActive == XR_TRUE && active.currentState > 0.0f;
+                }
+            } else if (this->action_set.vector2_actions.contains(action)) {
+                XrActionStateVector2f axis{XR_TYPE_ACTION_STATE_VECTOR2F};
+                result = xrGetActionStateVector2f(this->session, &get_info, &axis);
+
+                if (result == XR_SUCCESS) {
+                    state.axis = *(Vector2f*)&axis.currentState;
+                }
+            } else {
+                continue;
+            }
+
+            if (result != XR_SUCCESS) {
+                spdlog::error("[VR] Failed to get action state for {}: {}", this->action_set.action_names[action], this->get_result_string(result));
+            }
+        }
+
+        const auto find_state = [&](XrAction action) -> ActionStates::State* {
+            const auto it = this->action_set.action_indices.find(action);
+
+            if (it == this->action_set.action_indices.end() || it->second >= ActionStates::MAX_ACTIONS) {
+                return nullptr;
+            }
+
+            return &hand_states[it->second];
+        };
+
         // Handle vector activator stuff
         for (auto& it : hand.profiles[current_interaction_profile].vector_activators) {
             const auto activator = it.first;
             const auto modifier = hand.profiles[current_interaction_profile].action_vector_associations[activator];
+            const auto activator_state = find_state(activator);
+            const auto modifier_state = find_state(modifier);
 
-            if (this->is_action_active(activator, (VRRuntime::Hand)i)) {
-                const auto axis = this->get_action_axis(modifier, (VRRuntime::Hand)i);
+            if (activator_state != nullptr && activator_state->active) {
+                const auto axis = modifier_state != nullptr ? modifier_state->axis : Vector2f{};
                 
                 for (const auto& output : it.second) {
                     const auto distance = glm::length(output.value - axis);
 
                     if (distance < 0.7f) {
                         hand.forced_actions[output.action] = true;
+
+                        if (auto output_state = find_state(output.action); output_state != nullptr) {
+                            output_state->active = true;
+                        }
                     }
                 }
             }
         }
 
+        for (size_t j = 0; j < ActionStates::MAX_ACTIONS; ++j) {
+            auto& state = hand_states[j];
+            const auto was_active = prev_states.hands[i][j].active;
+
+            state.pressed = state.active && !was_active;
+            state.released = !state.active && was_active;
+        }
+    }
+
+    this->action_states.publish(states);
+
+    for (auto i = 0; i < 2; ++i) {
         if (this->is_action_active_once("systembutton", (VRRuntime::Hand)i)) {
             this->handle_pause = true;
         }
@@ -553,6 +652,11 @@ std::optional<std::string> OpenXR::initialize_actions(const std::string& json_st
 
         spdlog::info("[VR] Created action {} with handle {:x}", action_name, (uintptr_t)xr_action);
 
+        if (this->action_set.actions.size() >= ActionStates::MAX_ACTIONS) {
+            spdlog::warn("[VR] Action {} doesn't fit in the action state cache, it will always read as inactive", action_name);
+        }
+
+        this->action_set.action_indices[xr_action] = this->action_set.actions.size();
         this->action_set.actions.push_back(xr_action);
         this->action_set.action_map[action_name] = xr_action;
         this->action_set.action_names[xr_action] = action_name;
@@ -743,116 +847,56 @@ std::optional<std::string> OpenXR::initialize_actions(const std::string& json_st
     return std::nullopt;
 }
 
-bool OpenXR::is_action_active(XrAction action, VRRuntime::Hand hand) const {
+OpenXR::ActionStates::State OpenXR::get_action_state(XrAction action, VRRuntime::Hand hand) const {
     if (hand > VRRuntime::Hand::RIGHT) {
-        return false;
-    }
-
-    if (auto it = this->hands[hand].forced_actions.find(action); it != this->hands[hand].forced_actions.end()) {
-        if (it->second) {
-            return true;
-        }
+        return {};
     }
 
-    XrActionStateGetInfo get_info{XR_TYPE_ACTION_STATE_GET_INFO};
-    get_info.action = action;
-    get_info.subactionPath = this->hands[hand].path;
-    
-    if (this->action_set.bool_actions.contains(action)) {
-        XrActionStateBoolean active{XR_TYPE_ACTION_STATE_BOOLEAN};
-        auto result = xrGetActionStateBoolean(this->session, &get_info, &active);
-
-        if (result != XR_SUCCESS) {
-            spdlog::error("[VR] Failed to get action state: {}", this->get_result_string(result));
-            return false;
-        }
-
-        return active.isActive == XR_TRUE && active.currentState == XR_TRUE;
-    } else if (this->action_set.float_actions.contains(action)) {
-        XrActionStateFloat active{XR_TYPE_ACTION_STATE_FLOAT};
-        auto result = xrGetActionStateFloat(this->session, &get_info, &active);
+    const auto it = this->action_set.action_indices.find(action);
 
-        if (result != XR_SUCCESS) {
-            spdlog::error("[VR] Failed to get action state: {}", this->get_result_string(result));
-            return false;
-        }
+    if (it == this->action_set.action_indices.end() || it->second >= ActionStates::MAX_ACTIONS) {
+        return {};
+    }
 
-        return active.isActive == XR_TRUE && active.currentState > 0.0f;
-    } // idk?
+    const auto index = it->second;
 
-    return false;
+    return this->action_states.read([&](const ActionStates& states) {
+        return states.hands[hand][index];
+    });
 }
 
-bool OpenXR::is_action_active(std::string_view action_name, VRRuntime::Hand hand) const {
-    if (!this->action_set.action_map.contains(action_name.data()) || hand > VRRuntime::Hand::RIGHT) {
-        return false;
-    }
-
-    auto action = this->action_set.action_map.find(action_name.data())->second;
+OpenXR::ActionStates::State OpenXR::get_action_state(std::string_view action_name, VRRuntime::Hand hand) const {
+    const auto it = this->action_set.action_map.find(action_name.data());
 
-    if (auto it = this->hands[hand].forced_actions.find(action); it != this->hands[hand].forced_actions.end()) {
-        if (it->second) {
-            return true;
-        }
+    if (it == this->action_set.action_map.end()) {
+        return {};
     }
 
-    XrActionStateGetInfo get_info{XR_TYPE_ACTION_STATE_GET_INFO};
-    get_info.action = action;
-    get_info.subactionPath = this->hands[hand].path;
-    
-    XrActionStateBoolean active{XR_TYPE_ACTION_STATE_BOOLEAN};
-    auto result = xrGetActionStateBoolean(this->session, &get_info, &active);
+    return this->get_action_state(it->second, hand);
+}
 
-    if (result != XR_SUCCESS) {
-        spdlog::error("[VR] Failed to get action state for {}: {}", action_name, this->get_result_string(result));
-        return false;
-    }
+bool OpenXR::is_action_active(XrAction action, VRRuntime::Hand hand) const {
+    return this->get_action_state(action, hand).active;
+}
 
-    return active.isActive == XR_TRUE && active.currentState == XR_TRUE;
+bool OpenXR::is_action_active(std::string_view action_name, VRRuntime::Hand hand) const {
+    return this->get_action_state(action_name, hand).active;
 }
 
 bool OpenXR::is_action_active_once(std::string_view action_name, VRRuntime::Hand hand) const {
-    if (!this->action_set.action_map.contains(action_name.data()) || hand > VRRuntime::Hand::RIGHT) {
-        return false;
-    }
-
-    auto action = this->action_set.action_map.find(action_name.data())->second;
-
-    if (auto it = this->hands[hand].forced_actions.find(action); it != this->hands[hand].forced_actions.end()) {
-        if (it->second) {
-            return true;
-        }
-    }
-
-    XrActionStateGetInfo get_info{XR_TYPE_ACTION_STATE_GET_INFO};
-    get_info.action = action;
-    get_info.subactionPath = this->hands[hand].path;
-    
-    XrActionStateBoolean active{XR_TYPE_ACTION_STATE_BOOLEAN};
-    auto result = xrGetActionStateBoolean(this->session, &get_info, &active);
+    return this->get_action_state(action_name, hand).pressed;
+}
 
-    if (result != XR_SUCCESS) {
-        spdlog::error("[VR] Failed to get action state for {}: {}", action_name, this->get_result_string(result));
-        return false;
-    }
+bool OpenXR::is_action_pressed(XrAction action, VRRuntime::Hand hand) const {
+    return this->get_action_state(action, hand).pressed;
+}
 
-    return active.isActive == XR_TRUE && active.currentState == XR_TRUE && active.changedSinceLastSync == XR_TRUE;
+bool OpenXR::is_action_released(XrAction action, VRRuntime::Hand hand) const {
+    return this->get_action_state(action, hand).released;
 }
 
 Vector2f OpenXR::get_action_axis(XrAction action, VRRuntime::Hand hand) const {
-    XrActionStateGetInfo get_info{XR_TYPE_ACTION_STATE_GET_INFO};
-    get_info.action = action;
-    get_info.subactionPath = this->hands[hand].path;
-
-    XrActionStateVector2f axis{XR_TYPE_ACTION_STATE_VECTOR2F};
-    auto result = xrGetActionStateVector2f(this->session, &get_info, &axis);
-
-    if (result != XR_SUCCESS) {
-        spdlog::error("[VR] Failed to get stick action state: {}", this->get_result_string(result));
-        return Vector2f{};
-    }
-
-    return *(Vector2f*)&axis.currentState;
+    return this->get_action_state(action, hand).axis;
 }
 
 std::string OpenXR::translate_openvr_action_name(std::string action_name) const {
@@ -887,19 +931,7 @@ Vector2f OpenXR::get_left_stick_axis() const {
 
     auto action = hand_profile.path_map.contains("joystick") ? joystick_action : touchpad_action;
 
-    XrActionStateGetInfo get_info{XR_TYPE_ACTION_STATE_GET_INFO};
-    get_info.action = action;
-    get_info.subactionPath = hand.path;
-
-    XrActionStateVector2f axis{XR_TYPE_ACTION_STATE_VECTOR2F};
-    auto result = xrGetActionStateVector2f(this->session, &get_info, &axis);
-
-    if (result != XR_SUCCESS) {
-        spdlog::error("[VR] Failed to get stick action state: {}", this->get_result_string(result));
-        return Vector2f{};
-    }
-
-    return *(Vector2f*)&axis.currentState;
+    return this->get_action_axis(action, VRRuntime::Hand::LEFT);
 }
 
 Vector2f OpenXR::get_right_stick_axis() const {
@@ -921,19 +953,7 @@ Vector2f OpenXR::get_right_stick_axis() const {
 
     auto action = hand_profile.path_map.contains("joystick") ? joystick_action : touchpad_action;
 
-    XrActionStateGetInfo get_info{XR_TYPE_ACTION_STATE_GET_INFO};
-    get_info.action = action;
-    get_info.subactionPath = hand.path;
-
-    XrActionStateVector2f axis{XR_TYPE_ACTION_STATE_VECTOR2F};
-    auto result = xrGetActionStateVector2f(this->session, &get_info, &axis);
-
-    if (result != XR_SUCCESS) {
-        spdlog::error("[VR] Failed to get stick action state: {}", this->get_result_string(result));
-        return Vector2f{};
-    }
-
-    return *(Vector2f*)&axis.currentState;
+    return this->get_action_axis(action, VRRuntime::Hand::RIGHT);
 }
 
 void OpenXR::trigger_haptic_vibration(float duration, float frequency, float amplitude, VRRuntime::Hand source) const {
@@ -1247,10 +1267,12 @@ XrResult OpenXR::begin_frame() {
     }
 
     this->begin_profile();
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::SYNC);
 
     XrFrameBeginInfo frame_begin_info{XR_TYPE_FRAME_BEGIN_INFO};
     auto result = xrBeginFrame(this->session, &frame_begin_info);
 
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::SYNC);
     this->end_profile("xrBeginFrame");
 
     if (result != XR_SUCCESS) {
@@ -1315,11 +1337,15 @@ XrResult OpenXR::end_frame() {
     //spdlog::info("[VR] Ending frame, layer ptr: {:x}", (uintptr_t)frame_end_info.layers);
 
     this->begin_profile();
+    this->telemetry.begin(vrmod::FrameTelemetry::Stage::SUBMIT);
     auto result = xrEndFrame(this->session, &frame_end_info);
+    this->telemetry.end(vrmod::FrameTelemetry::Stage::SUBMIT);
     this->end_profile("xrEndFrame");
     
     if (result != XR_SUCCESS) {
         spdlog::error("[VR] xrEndFrame failed: {}", this->get_result_string(result));
+    } else {
+        this->telemetry.end_frame();
     }
     
     this->frame_began = false;
@@ -101,9 +101,29 @@ public:
         spdlog::info("{} took {} ms", name, dur);
     }
 
+    // Every input action's state for both hands, read from the runtime once per xrSyncActions in update_input.
+    // The queries below only look at the latest published table and never call into the runtime.
+    struct ActionStates {
+        static constexpr size_t MAX_ACTIONS = 64;
+
+        struct State {
+            Vector2f axis{}; // float actions only fill in x
+            bool active{false};
+            bool pressed{false};  // became active this sync
+            bool released{false}; // stopped being active this sync
+        };
+
+        std::array<std::array<State, MAX_ACTIONS>, 2> hands{};
+    };
+
+    ActionStates::State get_action_state(XrAction action, VRRuntime::Hand hand) const;
+    ActionStates::State get_action_state(std::string_view action_name, VRRuntime::Hand hand) const;
+
     bool is_action_active(XrAction action, VRRuntime::Hand hand) const;
     bool is_action_active(std::string_view action_name, VRRuntime::Hand hand) const;
     bool is_action_active_once(std::string_view action_name, VRRuntime::Hand hand) const;
+    bool is_action_pressed(XrAction action, VRRuntime::Hand hand) const;
+    bool is_action_released(XrAction action, VRRuntime::Hand hand) const;
     Vector2f get_action_axis(XrAction action, VRRuntime::Hand hand) const;
     std::string translate_openvr_action_name(std::string action_name) const;
 
@@ -157,6 +177,7 @@ public:
         std::vector<XrAction> actions{};
         std::unordered_map<std::string, XrAction> action_map{}; // XrActions are handles so it's okay.
         std::unordered_map<XrAction, std::string> action_names{};
+        std::unordered_map<XrAction, size_t> action_indices{}; // into ActionStates::hands, same order as actions
 
         std::unordered_set<XrAction> float_actions{};
         std::unordered_set<XrAction> vector2_actions{};
@@ -208,6 +229,9 @@ public:
 
     std::array<HandData, 2> hands{};
 
+    // Written by update_input only.
+    utility::SnapshotBuffer<ActionStates> action_states{};
+
 public:
     struct InteractionBinding {
         std::string interaction_path_name{};
@@ -10,6 +10,9 @@
 
 #include <spdlog/spdlog.h>
 #include <sdk/Math.hpp>
+#include <utility/SnapshotBuffer.hpp>
+
+#include "../FrameTelemetry.hpp"
 
 struct VRRuntime {
     enum class Error : int64_t {
@@ -22,6 +25,7 @@ struct VRRuntime {
         NONE,
         OPENXR,
         OPENVR,
+        MOCK,
     };
 
     enum class Eye : uint8_t {
@@ -40,6 +44,29 @@ struct VRRuntime {
         RIGHT,
     };
 
+    // Everything the game threads read about the current frame's poses, published once per update
+    // so readers don't have to lock pose_mtx/eyes_mtx.
+    struct PoseSnapshot {
+        static constexpr uint32_t MAX_DEVICES = 64; // vr::k_unMaxTrackedDeviceCount
+
+        struct Device {
+            Matrix4x4f transform{};
+            Vector4f velocity{};
+            Vector4f angular_velocity{};
+            bool valid{false};
+        };
+
+        std::array<Device, MAX_DEVICES> devices{};
+        uint32_t num_devices{0};
+
+        std::array<Matrix4x4f, 2> eyes{};
+        std::array<Matrix4x4f, 2> projections{};
+        std::array<Vector4f, 2> raw_projections{};
+
+        // Incremented on every publish.
+        uint64_t version{0};
+    };
+
     virtual ~VRRuntime() {};
 
     virtual std::string_view name() const {
@@ -110,6 +137,42 @@ struct VRRuntime {
         return this->type() == Type::OPENVR;
     }
 
+    bool is_mock() const {
+        return this->type() == Type::MOCK;
+    }
+
+    // Lock free, may be called from any thread.
+    PoseSnapshot get_pose_snapshot() const {
+        return this->pose_snapshots.get();
+    }
+
+    // Calls f with the latest snapshot, cheaper than get_pose_snapshot when only part of it is needed.
+    // f may be called more than once and must only copy things out of the snapshot.
+    template <typename F>
+    auto read_pose_snapshot(F&& f) const {
+        return this->pose_snapshots.read(std::forward<F>(f));
+    }
+
+    // Lets the runtime update its part of the snapshot (devices or eyes) and publishes the result.
+    template <typename F>
+    void update_pose_snapshot(F&& update) {
+        std::scoped_lock _{ this->pending_snapshot_mtx };
+
+        update(this->pending_snapshot);
+        ++this->pending_snapshot.version;
+
+        this->pose_snapshots.publish(this->pending_snapshot);
+    }
+
+    // Copies the eye and projection matrices into the snapshot, call with eyes_mtx held.
+    void update_eye_snapshot() {
+        this->update_pose_snapshot([this](PoseSnapshot& snapshot) {
+            snapshot.eyes = this->eyes;
+            snapshot.projections = this->projections;
+            snapshot.raw_projections = { this->raw_projections[0], this->raw_projections[1] };
+        });
+    }
+
     bool loaded{false};
     bool wants_reinitialize{false};
     bool dll_missing{false};
@@ -135,5 +198,13 @@ struct VRRuntime {
 
     Vector4f raw_projections[2]{};
 
+    // Writer side of pose_snapshots, only touched with pending_snapshot_mtx held.
+    PoseSnapshot pending_snapshot{};
+    std::mutex pending_snapshot_mtx{};
+    utility::SnapshotBuffer<PoseSnapshot> pose_snapshots{};
+
+    // Timings of the frame loop, recorded by the runtimes as they wait, fetch poses and submit.
+    vrmod::FrameTelemetry telemetry{};
+
     SynchronizeStage custom_stage{SynchronizeStage::EARLY};
 };
\ No newline at end of file
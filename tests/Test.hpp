@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Just enough of a harness for the headless tests. A test is an executable that
+// returns non-zero when any CHECK failed.
+namespace test {
+inline int g_failures{0};
+
+inline int result() {
+    if (g_failures > 0) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+
+    std::printf("all checks passed\n");
+    return 0;
+}
+
+// Runs f iterations times and returns the average in milliseconds.
+template <typename F>
+double time_ms(size_t iterations, F&& f) {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        f();
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / (double)iterations;
+}
+}
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++test::g_failures; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(a, b, eps) \
+    do { \
+        const auto _a = (a); \
+        const auto _b = (b); \
+        if (!(_a - _b <= (eps) && _b - _a <= (eps))) { \
+            std::printf("%s:%d: CHECK_NEAR(%s, %s) failed: %f vs %f\n", __FILE__, __LINE__, #a, #b, (double)_a, (double)_b); \
+            ++test::g_failures; \
+        } \
+    } while (0)
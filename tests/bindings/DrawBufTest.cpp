@@ -0,0 +1,283 @@
+#include <cmath>
+#include <memory>
+#include <string_view>
+
+#include <Test.hpp>
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <sdk/renderer/CameraSnapshot.hpp>
+
+#include "DrawBuf.hpp"
+
+using namespace api::drawbuf;
+
+namespace {
+constexpr float EPSILON = 0.01f;
+constexpr uint32_t RED = 0xFF0000FF;
+constexpr uint32_t GREEN = 0xFF00FF00;
+
+// A draw list that isn't owned by any window, the same kind submit() writes into.
+std::unique_ptr<ImDrawList> make_draw_list(ImDrawListFlags flags = ImDrawListFlags_None) {
+    auto list = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+
+    list->_ResetForNewFrame();
+    list->Flags = flags;
+    list->PushClipRectFullScreen();
+    list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+    return list;
+}
+
+sdk::renderer::CameraSnapshot make_camera() {
+    sdk::renderer::CameraSnapshot camera{};
+
+    camera.screen_size = Vector2f{1920.0f, 1080.0f};
+    camera.view = glm::lookAtRH(Vector3f{0.0f, 0.0f, 0.0f}, Vector3f{0.0f, 0.0f, -1.0f}, Vector3f{0.0f, 1.0f, 0.0f});
+    camera.proj = glm::perspectiveRH_ZO(glm::radians(90.0f), camera.screen_size.x / camera.screen_size.y, 0.1f, 1000.0f);
+    camera.view_proj = camera.proj * camera.view;
+    camera.valid = true;
+
+    return camera;
+}
+
+ImVec2 to_screen(const sdk::renderer::CameraSnapshot& camera, const Vector3f& p) {
+    const auto viewport = Vector4f{0.0f, 0.0f, camera.screen_size.x, camera.screen_size.y};
+    const auto projected = glm::project(p, Matrix4x4f{1.0f}, camera.view_proj, viewport);
+
+    return ImVec2{projected.x, camera.screen_size.y - projected.y};
+}
+
+void add(DrawBuf& buf, Primitive type, std::initializer_list<Vector4f> points, uint32_t color, float size, uint8_t flags, uint16_t segments = 0) {
+    Command cmd{};
+    cmd.type = type;
+    cmd.flags = flags;
+    cmd.color = color;
+    cmd.size = size;
+    cmd.segments = segments;
+    cmd.first_point = (uint32_t)buf.points.size();
+
+    buf.points.insert(buf.points.end(), points);
+    buf.commands.push_back(cmd);
+}
+
+void add_text(DrawBuf& buf, const Vector2f& pos, std::string_view str, uint32_t color) {
+    add(buf, Primitive::TEXT, {Vector4f{pos.x, pos.y, 0.0f, 1.0f}}, color, 1.0f, 0);
+
+    auto& cmd = buf.commands.back();
+    cmd.text_offset = (uint32_t)buf.text.size();
+    cmd.text_length = (uint32_t)str.size();
+    buf.text += str;
+}
+
+bool near(const ImVec2& a, const ImVec2& b, float eps = EPSILON) {
+    return std::abs(a.x - b.x) <= eps && std::abs(a.y - b.y) <= eps;
+}
+
+// Same vertices, uvs, colors and indices.
+void check_same_output(const ImDrawList& out, const ImDrawList& expected, float eps = EPSILON) {
+    CHECK(out.VtxBuffer.Size == expected.VtxBuffer.Size);
+    CHECK(out.IdxBuffer.Size == expected.IdxBuffer.Size);
+
+    if (out.VtxBuffer.Size != expected.VtxBuffer.Size || out.IdxBuffer.Size != expected.IdxBuffer.Size) {
+        return;
+    }
+
+    size_t mismatches{0};
+
+    for (int i = 0; i < out.VtxBuffer.Size; ++i) {
+        const auto& a = out.VtxBuffer[i];
+        const auto& b = expected.VtxBuffer[i];
+
+        mismatches += !near(a.pos, b.pos, eps) || !near(a.uv, b.uv, 1e-6f) || a.col != b.col;
+    }
+
+    for (int i = 0; i < out.IdxBuffer.Size; ++i) {
+        mismatches += out.IdxBuffer[i] != expected.IdxBuffer[i];
+    }
+
+    CHECK(mismatches == 0);
+}
+
+// A line is one quad, thickness wide, with indices (0, 1, 2) (0, 2, 3) and no AA fringe.
+void check_line_quad(const ImDrawList& out, int first_vtx, int first_idx, const ImVec2& a, const ImVec2& b, float thickness, ImU32 color) {
+    CHECK(out.VtxBuffer.Size >= first_vtx + 4);
+    CHECK(out.IdxBuffer.Size >= first_idx + 6);
+
+    if (out.VtxBuffer.Size < first_vtx + 4 || out.IdxBuffer.Size < first_idx + 6) {
+        return;
+    }
+
+    const auto d = b - a;
+    const auto scale = 0.5f * thickness / std::sqrt(ImLengthSqr(d));
+    const auto n = ImVec2{-d.y * scale, d.x * scale};
+    const ImVec2 corners[4]{a + n, b + n, b - n, a - n};
+    const auto uv = ImGui::GetFontTexUvWhitePixel();
+
+    for (int i = 0; i < 4; ++i) {
+        const auto& v = out.VtxBuffer[first_vtx + i];
+
+        CHECK(near(v.pos, corners[i]));
+        CHECK(near(v.uv, uv, 1e-6f));
+        CHECK(v.col == color);
+    }
+
+    const ImDrawIdx indices[6]{0, 1, 2, 0, 2, 3};
+
+    for (int i = 0; i < 6; ++i) {
+        CHECK(out.IdxBuffer[first_idx + i] == (ImDrawIdx)(first_vtx + indices[i]));
+    }
+}
+
+// Screen space commands have to come out exactly like the ImDrawList calls they stand for.
+void test_screen_space_matches_draw_list() {
+    const auto camera = make_camera();
+
+    const ImDrawListFlags all_flags[]{ImDrawListFlags_None, ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill};
+
+    for (const auto flags : all_flags) {
+        DrawBuf buf{};
+        add(buf, Primitive::RECT, {{100.0f, 50.0f, 0.0f, 1.0f}, {20.0f, 300.0f, 0.0f, 1.0f}}, RED, 1.0f, Flags::FILLED);
+        add(buf, Primitive::CIRCLE, {{500.0f, 500.0f, 0.0f, 1.0f}}, GREEN, 40.0f, Flags::FILLED, 24);
+        add(buf, Primitive::CIRCLE, {{800.0f, 200.0f, 0.0f, 1.0f}}, RED, 25.0f, 0, 16);
+        add_text(buf, Vector2f{10.0f, 10.0f}, "DrawBuf 123", GREEN);
+
+        auto out = make_draw_list(flags);
+        CHECK(submit(buf, out.get(), camera) == 4);
+
+        auto expected = make_draw_list(flags);
+        expected->AddRectFilled(ImVec2{20.0f, 50.0f}, ImVec2{100.0f, 300.0f}, RED);
+        expected->AddCircleFilled(ImVec2{500.0f, 500.0f}, 40.0f, GREEN, 24);
+        expected->AddCircle(ImVec2{800.0f, 200.0f}, 25.0f, RED, 16);
+        expected->AddText(ImVec2{10.0f, 10.0f}, GREEN, "DrawBuf 123");
+
+        check_same_output(*out, *expected);
+    }
+
+    // Filled quads match a convex fill without AA.
+    {
+        DrawBuf buf{};
+        add(buf, Primitive::QUAD, {{10.0f, 10.0f, 0.0f, 1.0f}, {90.0f, 20.0f, 0.0f, 1.0f}, {80.0f, 70.0f, 0.0f, 1.0f}, {15.0f, 60.0f, 0.0f, 1.0f}}, RED, 1.0f, Flags::FILLED);
+
+        auto out = make_draw_list();
+        CHECK(submit(buf, out.get(), camera) == 1);
+
+        auto expected = make_draw_list();
+        expected->AddQuadFilled(ImVec2{10.0f, 10.0f}, ImVec2{90.0f, 20.0f}, ImVec2{80.0f, 70.0f}, ImVec2{15.0f, 60.0f}, RED);
+
+        check_same_output(*out, *expected);
+    }
+}
+
+void test_screen_space_lines() {
+    const auto camera = make_camera();
+
+    DrawBuf buf{};
+    add(buf, Primitive::LINE, {{10.0f, 20.0f, 0.0f, 1.0f}, {300.0f, 140.0f, 0.0f, 1.0f}}, RED, 3.0f, 0);
+    add(buf, Primitive::LINE, {{5.0f, 5.0f, 0.0f, 1.0f}, {5.0f, 5.0f, 0.0f, 1.0f}}, RED, 3.0f, 0); // zero length, no vertices
+    add(buf, Primitive::RECT, {{100.0f, 100.0f, 0.0f, 1.0f}, {200.0f, 150.0f, 0.0f, 1.0f}}, GREEN, 2.0f, 0);
+
+    auto out = make_draw_list();
+    CHECK(submit(buf, out.get(), camera) == 3);
+
+    // One quad for the line, four for the rect outline.
+    CHECK(out->VtxBuffer.Size == 4 * 5);
+    CHECK(out->IdxBuffer.Size == 6 * 5);
+
+    check_line_quad(*out, 0, 0, ImVec2{10.0f, 20.0f}, ImVec2{300.0f, 140.0f}, 3.0f, RED);
+
+    const ImVec2 corners[4]{{100.0f, 100.0f}, {200.0f, 100.0f}, {200.0f, 150.0f}, {100.0f, 150.0f}};
+
+    for (int i = 0; i < 4; ++i) {
+        check_line_quad(*out, 4 + i * 4, 6 + i * 6, corners[i], corners[(i + 1) % 4], 2.0f, GREEN);
+    }
+}
+
+void test_world_space() {
+    const auto camera = make_camera();
+
+    const Vector3f a{-2.0f, 1.0f, -10.0f};
+    const Vector3f b{3.0f, -1.0f, -20.0f};
+    const Vector3f center{1.0f, 0.5f, -8.0f};
+    const Vector3f behind{0.0f, 0.0f, 5.0f};
+
+    DrawBuf buf{};
+    add(buf, Primitive::LINE, {Vector4f{a, 1.0f}, Vector4f{b, 1.0f}}, RED, 2.0f, Flags::WORLD);
+    add(buf, Primitive::LINE, {Vector4f{a, 1.0f}, Vector4f{behind, 1.0f}}, RED, 2.0f, Flags::WORLD); // skipped
+    add(buf, Primitive::CIRCLE, {Vector4f{center, 1.0f}}, GREEN, 0.5f, Flags::WORLD | Flags::FILLED, 20);
+    add(buf, Primitive::CIRCLE, {Vector4f{behind, 1.0f}}, GREEN, 0.5f, Flags::WORLD, 20); // skipped
+
+    auto out = make_draw_list();
+    CHECK(submit(buf, out.get(), camera) == 2);
+
+    check_line_quad(*out, 0, 0, to_screen(camera, a), to_screen(camera, b), 2.0f, RED);
+
+    // The world radius is measured along the camera's right axis.
+    const auto screen_center = to_screen(camera, center);
+    const auto screen_radius = std::sqrt(ImLengthSqr(to_screen(camera, center + Vector3f{0.5f, 0.0f, 0.0f}) - screen_center));
+
+    auto expected = make_draw_list();
+    expected->PrimReserve(6, 4); // stands in for the line quad so the indices line up
+    expected->PrimRect(ImVec2{}, ImVec2{}, RED);
+    expected->AddCircleFilled(screen_center, screen_radius, GREEN, 20);
+
+    CHECK(out->VtxBuffer.Size == expected->VtxBuffer.Size);
+
+    if (out->VtxBuffer.Size == expected->VtxBuffer.Size) {
+        for (int i = 4; i < out->VtxBuffer.Size; ++i) {
+            CHECK(near(out->VtxBuffer[i].pos, expected->VtxBuffer[i].pos, 0.05f));
+        }
+    }
+}
+
+void test_invalid_camera() {
+    auto camera = make_camera();
+    camera.valid = false;
+
+    DrawBuf buf{};
+    add(buf, Primitive::LINE, {{-2.0f, 1.0f, -10.0f, 1.0f}, {3.0f, -1.0f, -20.0f, 1.0f}}, RED, 2.0f, Flags::WORLD);
+    add(buf, Primitive::LINE, {{10.0f, 20.0f, 0.0f, 1.0f}, {300.0f, 140.0f, 0.0f, 1.0f}}, RED, 3.0f, 0);
+
+    auto out = make_draw_list();
+
+    // World space needs a camera, screen space doesn't.
+    CHECK(submit(buf, out.get(), camera) == 1);
+    CHECK(out->VtxBuffer.Size == 4);
+
+    check_line_quad(*out, 0, 0, ImVec2{10.0f, 20.0f}, ImVec2{300.0f, 140.0f}, 3.0f, RED);
+
+    // Nothing to do for an empty buffer or without a draw list.
+    CHECK(submit(DrawBuf{}, out.get(), camera) == 0);
+    CHECK(submit(buf, nullptr, camera) == 0);
+}
+}
+
+int main() {
+    ImGui::CreateContext();
+
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2{1920.0f, 1080.0f};
+    io.IniFilename = nullptr;
+
+    unsigned char* pixels{};
+    int width{}, height{};
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // Sets up the shared draw list data (font, white pixel uv) the draw lists use.
+    ImGui::NewFrame();
+
+    test_screen_space_matches_draw_list();
+    test_screen_space_lines();
+    test_world_space();
+    test_invalid_camera();
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+
+    return test::result();
+}
@@ -0,0 +1,94 @@
+#include <string>
+
+#include <Test.hpp>
+
+#include "JsonCodec.hpp"
+
+using nlohmann::json;
+
+namespace {
+// What json.dump_string used to do: build the whole DOM first, then dump it.
+json to_dom(const sol::object& obj) {
+    switch (obj.get_type()) {
+    case sol::type::boolean:
+        return obj.as<bool>();
+    case sol::type::number:
+        return obj.is<int64_t>() ? json(obj.as<int64_t>()) : json(obj.as<double>());
+    case sol::type::string:
+        return obj.as<std::string>();
+    case sol::type::table: {
+        const auto t = obj.as<sol::table>();
+        const auto n = t.size();
+
+        if (n > 0) {
+            auto out = json::array();
+
+            for (size_t i = 1; i <= n; ++i) {
+                out.push_back(to_dom(t[i]));
+            }
+
+            return out;
+        }
+
+        auto out = json::object();
+
+        for (const auto& [k, v] : t) {
+            out[k.as<std::string>()] = to_dom(v);
+        }
+
+        return out;
+    }
+    default:
+        return nullptr;
+    }
+}
+}
+
+// Encodes and decodes a ~10MB table of typical script save data.
+int main() {
+    sol::state lua{};
+    lua.open_libraries(sol::lib::base, sol::lib::math, sol::lib::string, sol::lib::table);
+
+    const sol::table data = lua.script(R"(
+        local items = {}
+
+        for i = 1, 40000 do
+            items[i] = {
+                id = i,
+                name = "item_" .. i,
+                description = string.rep("lorem ipsum ", 8),
+                position = {x = i * 0.5, y = -i * 0.25, z = i / 3},
+                tags = {"weapon", "rare", "stackable"},
+                count = i % 99,
+                enabled = i % 2 == 0,
+            }
+        end
+
+        return {version = 3, items = items}
+    )");
+
+    std::string json_text{};
+    std::string cbor{};
+
+    const auto encode_ms = test::time_ms(5, [&]() { json_text = api::json::encode_json(data, -1); });
+    const auto dom_encode_ms = test::time_ms(5, [&]() { to_dom(data).dump(); });
+    const auto cbor_encode_ms = test::time_ms(5, [&]() { cbor = api::json::encode_cbor(data); });
+
+    std::string error{};
+    json dom{};
+
+    const auto decode_ms = test::time_ms(5, [&]() { api::json::decode(lua.lua_state(), json_text, json::input_format_t::json, error); });
+    const auto dom_decode_ms = test::time_ms(5, [&]() { dom = json::parse(json_text); });
+    const auto cbor_decode_ms = test::time_ms(5, [&]() { api::json::decode(lua.lua_state(), cbor, json::input_format_t::cbor, error); });
+
+    CHECK(error.empty());
+    CHECK(json::parse(json_text) == json::from_cbor(cbor));
+
+    std::printf("json: %.1f MB, cbor: %.1f MB\n", json_text.size() / 1e6, cbor.size() / 1e6);
+    std::printf("encode json     %8.2f ms (dom + dump %8.2f ms)\n", encode_ms, dom_encode_ms);
+    std::printf("encode cbor     %8.2f ms\n", cbor_encode_ms);
+    std::printf("decode json     %8.2f ms (parse to dom %8.2f ms)\n", decode_ms, dom_decode_ms);
+    std::printf("decode cbor     %8.2f ms\n", cbor_decode_ms);
+
+    return test::result();
+}
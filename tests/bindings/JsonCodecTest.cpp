@@ -0,0 +1,136 @@
+#include <string>
+
+#include <Test.hpp>
+
+#include "JsonCodec.hpp"
+
+using nlohmann::json;
+
+namespace {
+std::string encode_string(sol::state& lua, const std::string& raw) {
+    return api::json::encode_json(sol::make_object(lua, raw), -1);
+}
+
+// The sanitizer must let valid UTF-8 through untouched and turn everything else into U+FFFD,
+// so whatever it writes can be parsed again.
+void test_utf8(sol::state& lua) {
+    const std::string replacement = "\xEF\xBF\xBD";
+
+    const char* valid[] = {
+        "\xC2\x80",         // U+0080
+        "\xDF\xBF",         // U+07FF
+        "\xE0\xA0\x80",     // U+0800, the smallest 3 byte sequence
+        "\xED\x9F\xBF",     // U+D7FF, just below the surrogates
+        "\xEE\x80\x80",     // U+E000, just above them
+        "\xEF\xBF\xBF",     // U+FFFF
+        "\xF0\x90\x80\x80", // U+10000, the smallest 4 byte sequence
+        "\xF4\x8F\xBF\xBF", // U+10FFFF
+    };
+
+    for (const auto str : valid) {
+        const auto out = encode_string(lua, str);
+
+        CHECK(out == "\"" + std::string{str} + "\"");
+        CHECK(json::parse(out).get<std::string>() == str);
+    }
+
+    const char* invalid[] = {
+        "\xC0\xAF",         // overlong '/'
+        "\xC1\xBF",
+        "\xE0\x80\x80",     // overlong 3 byte
+        "\xE0\x9F\xBF",
+        "\xED\xA0\x80",     // U+D800, high surrogate
+        "\xED\xBF\xBF",     // U+DFFF, low surrogate
+        "\xF0\x80\x80\x80", // overlong 4 byte
+        "\xF0\x8F\xBF\xBF",
+        "\xF4\x90\x80\x80", // U+110000
+        "\xF5\x80\x80\x80",
+        "\xE2\x82",         // truncated
+        "\x80",             // stray continuation byte
+    };
+
+    for (const auto str : invalid) {
+        const auto out = encode_string(lua, str);
+
+        CHECK(out.find(replacement) != std::string::npos);
+        CHECK(out.find(str) == std::string::npos);
+
+        // nlohmann rejects invalid UTF-8.
+        CHECK(json::accept(out));
+    }
+
+    CHECK(encode_string(lua, "a\xE0\x80\x80z") == "\"a" + replacement + replacement + replacement + "z\"");
+}
+
+void test_layout(sol::state& lua) {
+    CHECK(api::json::encode_json(lua.script("return {1, 2, 3}"), -1) == "[1,2,3]");
+    CHECK(api::json::encode_json(lua.script("return {}"), -1) == "null");
+    CHECK(api::json::encode_json(lua.script("return 1.0"), -1) == "1.0");
+    CHECK(api::json::encode_json(lua.script("return {a = 1}"), -1) == "{\"a\":1}");
+    CHECK(api::json::encode_json(lua.script("return {a = {true}}"), 4) == "{\n    \"a\": [\n        true\n    ]\n}");
+
+    // Holes turn the table into an object.
+    CHECK(json::parse(api::json::encode_json(lua.script("return {[1] = 1, [3] = 3}"), -1)) == json::parse("{\"1\":1,\"3\":3}"));
+
+    bool threw = false;
+
+    try {
+        api::json::encode_json(lua.script("local t = {} t.self = t return t"), -1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+
+    CHECK(threw);
+}
+
+void test_round_trip(sol::state& lua) {
+    sol::table value = lua.script(R"(
+        return {
+            name = "test",
+            count = 42,
+            ratio = 0.25,
+            enabled = false,
+            list = {1, "two", 3.5, {nested = true}},
+            big = 9007199254740993,
+        }
+    )");
+
+    for (const auto format : {json::input_format_t::json, json::input_format_t::cbor}) {
+        const auto encoded = format == json::input_format_t::json ? api::json::encode_json(value, -1) : api::json::encode_cbor(value);
+
+        std::string error{};
+        const auto decoded = api::json::decode(lua.lua_state(), encoded, format, error);
+
+        CHECK(error.empty());
+        CHECK(decoded.get_type() == sol::type::table);
+
+        lua["decoded"] = decoded;
+
+        const bool same = lua.script(R"(
+            local d = decoded
+            return d.name == "test" and math.type(d.count) == "integer" and d.count == 42 and d.ratio == 0.25
+                and d.enabled == false and #d.list == 4 and d.list[2] == "two" and d.list[3] == 3.5
+                and d.list[4].nested == true and d.big == 9007199254740993
+        )");
+
+        CHECK(same);
+    }
+
+    std::string error{};
+    const auto bad = api::json::decode(lua.lua_state(), std::string{"{\"a\": [1, 2"}, json::input_format_t::json, error);
+
+    CHECK(!bad.valid());
+    CHECK(!error.empty());
+}
+}
+
+int main() {
+    sol::state lua{};
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+
+    test_utf8(lua);
+    test_layout(lua);
+    test_round_trip(lua);
+
+    return test::result();
+}
@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <sdk/IK.hpp>
+
+using namespace utility::math::ik;
+
+namespace {
+// Roughly a crowd of characters with both arms and legs solved every frame.
+constexpr size_t NUM_CHAINS = 10000;
+constexpr size_t NUM_FRAMES = 100;
+constexpr size_t FABRIK_JOINTS = 5;
+
+Vector4f random_point(std::mt19937& rng, float scale) {
+    std::uniform_real_distribution<float> dist{-scale, scale};
+    return Vector4f{dist(rng), dist(rng), dist(rng), 1.0f};
+}
+}
+
+int main() {
+    std::mt19937 rng{5};
+
+    std::vector<Vector4f> root{};
+    std::vector<Vector4f> mid{};
+    std::vector<Vector4f> end{};
+    std::vector<Vector4f> target{};
+    std::vector<Vector4f> pole{};
+
+    for (size_t i = 0; i < NUM_CHAINS; ++i) {
+        const auto r = random_point(rng, 10.0f);
+
+        root.push_back(r);
+        mid.push_back(r + Vector4f{0.3f, 0.0f, 0.0f, 0.0f});
+        end.push_back(r + Vector4f{0.3f, -0.25f, 0.0f, 0.0f});
+        target.push_back(r + Vector4f{Vector3f{random_point(rng, 0.4f)}, 0.0f});
+        pole.push_back(r + Vector4f{0.0f, 0.0f, 1.0f, 0.0f});
+    }
+
+    std::vector<Vector4f> out_mid(NUM_CHAINS);
+    std::vector<Vector4f> out_end(NUM_CHAINS);
+    size_t num_reached{0};
+
+    const auto batch_ms = test::time_ms(NUM_FRAMES, [&]() {
+        num_reached = solve_two_bone(root, mid, end, target, pole, {}, out_mid, out_end);
+    });
+
+    // The same chains solved one call each, the way a single arm gets solved.
+    const auto single_ms = test::time_ms(NUM_FRAMES, [&]() {
+        for (size_t i = 0; i < NUM_CHAINS; ++i) {
+            solve_two_bone({&root[i], 1}, {&mid[i], 1}, {&end[i], 1}, {&target[i], 1}, {&pole[i], 1}, {},
+                {&out_mid[i], 1}, {&out_end[i], 1});
+        }
+    });
+
+    std::vector<Vector4f> chains{};
+    std::vector<Vector4f> fabrik_targets{};
+
+    for (size_t i = 0; i < NUM_CHAINS; ++i) {
+        for (size_t j = 0; j < FABRIK_JOINTS; ++j) {
+            chains.push_back(root[i] + Vector4f{0.0f, 0.2f * j, 0.0f, 0.0f});
+        }
+
+        fabrik_targets.push_back(root[i] + Vector4f{Vector3f{random_point(rng, 0.6f)}, 0.0f});
+    }
+
+    const auto original = chains;
+    size_t fabrik_reached{0};
+
+    const auto fabrik_ms = test::time_ms(NUM_FRAMES, [&]() {
+        chains = original;
+        fabrik_reached = fabrik(chains, FABRIK_JOINTS, fabrik_targets, pole, {});
+    });
+
+    std::printf("%zu chains\n", NUM_CHAINS);
+    std::printf("two bone (batch):  %8.4f ms/frame, %zu reached\n", batch_ms, num_reached);
+    std::printf("two bone (single): %8.4f ms/frame\n", single_ms);
+    std::printf("fabrik (%zu joints): %8.4f ms/frame, %zu reached\n", FABRIK_JOINTS, fabrik_ms, fabrik_reached);
+
+    return 0;
+}
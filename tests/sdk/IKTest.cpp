@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <sdk/IK.hpp>
+
+namespace {
+using namespace utility::math::ik;
+
+constexpr float EPSILON = 1e-6f;
+
+// Position tolerance for chains about a unit long.
+constexpr float TOLERANCE = 1e-4f;
+
+// The elbow's distance from the root -> target line is a square root that gets ill conditioned
+// as the arm straightens, so it only matches the reference to about sqrt(float epsilon).
+constexpr float MID_TOLERANCE = 1e-3f;
+
+struct Chain {
+    Vector4f root{};
+    Vector4f mid{};
+    Vector4f end{};
+};
+
+float distance(const Vector4f& a, const Vector4f& b) {
+    return glm::length(Vector3f{a} - Vector3f{b});
+}
+
+bool same_bits(const Vector4f& a, const Vector4f& b) {
+    return std::memcmp(&a, &b, sizeof(Vector4f)) == 0;
+}
+
+Vector3f direction(const Vector3f& v, const Vector3f& fallback) {
+    const auto len = glm::length(v);
+    return len > EPSILON ? v * (1.0f / len) : fallback;
+}
+
+Vector3f reject(const Vector3f& v, const Vector3f& n) {
+    return v - n * glm::dot(v, n);
+}
+
+// Plain scalar version of the two-bone solve, one chain at a time, written straight from the math.
+// The SSE solver has to agree with it.
+Chain reference_two_bone(const Chain& chain, const Vector4f& target, const Vector4f* pole, const TwoBoneLimits& limits, bool& reached) {
+    const Vector3f r{chain.root};
+    const Vector3f m{chain.mid};
+    const Vector3f e{chain.end};
+    const Vector3f t{target};
+
+    const auto l0 = glm::length(m - r);
+    const auto l1 = glm::length(e - m);
+    const auto min_bend = std::clamp(limits.min_bend, 0.0f, glm::pi<float>());
+    const auto max_bend = std::clamp(limits.max_bend, min_bend, glm::pi<float>());
+    const auto d_min = std::sqrt(std::max(l0 * l0 + l1 * l1 - 2.0f * l0 * l1 * std::cos(min_bend), 0.0f));
+    const auto d_max = std::sqrt(std::max(l0 * l0 + l1 * l1 - 2.0f * l0 * l1 * std::cos(max_bend), 0.0f));
+
+    const auto d_raw = glm::length(t - r);
+    const auto d = std::clamp(d_raw, d_min, d_max);
+    reached = d_raw >= d_min - EPSILON && d_raw <= d_max + EPSILON;
+
+    const auto n = direction(t - r, direction(e - r, Vector3f{0.0f, 1.0f, 0.0f}));
+    const auto axis = std::abs(n.y) < 0.9f ? Vector3f{0.0f, 1.0f, 0.0f} : Vector3f{1.0f, 0.0f, 0.0f};
+    auto bend = direction(reject(m - r, n), glm::normalize(glm::cross(n, axis)));
+
+    if (pole != nullptr) {
+        bend = direction(reject(Vector3f{*pole} - r, n), bend);
+    }
+
+    const auto a = d > EPSILON ? (l0 * l0 - l1 * l1 + d * d) / (2.0f * d) : 0.0f;
+    const auto h = std::sqrt(std::max(l0 * l0 - a * a, 0.0f));
+
+    return {chain.root, Vector4f{r + n * a + bend * h, 1.0f}, Vector4f{r + n * d, 1.0f}};
+}
+
+struct Batch {
+    std::vector<Vector4f> root{};
+    std::vector<Vector4f> mid{};
+    std::vector<Vector4f> end{};
+    std::vector<Vector4f> target{};
+    std::vector<Vector4f> pole{};
+};
+
+// Arms of random proportions in random poses, with targets spread from folded to out of reach.
+Batch make_batch(size_t count, uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> pos{-1.0f, 1.0f};
+    std::uniform_real_distribution<float> bone{0.1f, 0.6f};
+
+    auto random_dir = [&]() {
+        return direction(Vector3f{pos(rng), pos(rng), pos(rng)}, Vector3f{1.0f, 0.0f, 0.0f});
+    };
+
+    Batch batch{};
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3f r{pos(rng), pos(rng), pos(rng)};
+        const auto m = r + random_dir() * bone(rng);
+        const auto e = m + random_dir() * bone(rng);
+        const auto t = r + random_dir() * (std::abs(pos(rng)) * 1.5f);
+
+        batch.root.emplace_back(r, 1.0f);
+        batch.mid.emplace_back(m, 1.0f);
+        batch.end.emplace_back(e, 1.0f);
+        batch.target.emplace_back(t, 1.0f);
+        batch.pole.emplace_back(r + random_dir(), 1.0f);
+    }
+
+    return batch;
+}
+
+// Hand worked chains, both bones 1 long lying along +x.
+void test_golden() {
+    const Vector4f root{0.0f, 0.0f, 0.0f, 1.0f};
+    const Vector4f mid{1.0f, 0.0f, 0.0f, 1.0f};
+    const Vector4f end{2.0f, 0.0f, 0.0f, 1.0f};
+    const Vector4f pole{0.0f, 0.0f, 1.0f, 1.0f};
+    Vector4f out_mid{};
+    Vector4f out_end{};
+    uint8_t reached{0xFF};
+
+    // Out of reach, the arm is stretched straight at the target.
+    Vector4f target{5.0f, 0.0f, 0.0f, 1.0f};
+    CHECK(solve_two_bone({&root, 1}, {&mid, 1}, {&end, 1}, {&target, 1}, {}, {}, {&out_mid, 1}, {&out_end, 1}, {&reached, 1}) == 0);
+    CHECK(reached == 0);
+    CHECK_NEAR(distance(out_mid, Vector4f{1.0f, 0.0f, 0.0f, 1.0f}), 0.0f, TOLERANCE);
+    CHECK_NEAR(distance(out_end, Vector4f{2.0f, 0.0f, 0.0f, 1.0f}), 0.0f, TOLERANCE);
+    CHECK(out_mid.w == 1.0f && out_end.w == 1.0f);
+
+    // Reachable at sqrt(2), the elbow sits at a right angle pushed out towards the pole.
+    target = Vector4f{1.0f, 1.0f, 0.0f, 1.0f};
+    CHECK(solve_two_bone({&root, 1}, {&mid, 1}, {&end, 1}, {&target, 1}, {&pole, 1}, {}, {&out_mid, 1}, {&out_end, 1}, {&reached, 1}) == 1);
+    CHECK(reached == 1);
+    CHECK_NEAR(distance(out_mid, Vector4f{0.5f, 0.5f, std::sqrt(0.5f), 1.0f}), 0.0f, TOLERANCE);
+    CHECK_NEAR(distance(out_end, target), 0.0f, TOLERANCE);
+
+    // Same target with a 120 degree minimum bend, the arm can't fold that far.
+    const TwoBoneLimits limits{glm::radians(120.0f), glm::pi<float>()};
+    CHECK(solve_two_bone({&root, 1}, {&mid, 1}, {&end, 1}, {&target, 1}, {&pole, 1}, limits, {&out_mid, 1}, {&out_end, 1}, {&reached, 1}) == 0);
+    CHECK(reached == 0);
+    CHECK_NEAR(distance(root, out_end), std::sqrt(3.0f), TOLERANCE);
+    CHECK_NEAR(distance(root, out_mid), 1.0f, TOLERANCE);
+    CHECK_NEAR(distance(out_mid, out_end), 1.0f, TOLERANCE);
+}
+
+// The SSE solver against the scalar reference, at a count that leaves a partial group at the end.
+void test_matches_reference() {
+    constexpr size_t COUNT = 1003;
+    const auto batch = make_batch(COUNT, 1234);
+    const TwoBoneLimits limit_sets[]{{}, {glm::radians(30.0f), glm::radians(160.0f)}};
+
+    for (const auto& limits : limit_sets) {
+        for (const auto with_pole : {false, true}) {
+            std::vector<Vector4f> out_mid(COUNT);
+            std::vector<Vector4f> out_end(COUNT);
+            std::vector<uint8_t> reached(COUNT);
+
+            const auto num_reached = solve_two_bone(batch.root, batch.mid, batch.end, batch.target,
+                with_pole ? std::span<const Vector4f>{batch.pole} : std::span<const Vector4f>{}, limits, out_mid, out_end, reached);
+
+            size_t expected_reached{0};
+
+            for (size_t i = 0; i < COUNT; ++i) {
+                const Chain chain{batch.root[i], batch.mid[i], batch.end[i]};
+                bool expected{};
+                const auto solved = reference_two_bone(chain, batch.target[i], with_pole ? &batch.pole[i] : nullptr, limits, expected);
+
+                expected_reached += expected;
+
+                CHECK((bool)reached[i] == expected);
+                CHECK_NEAR(distance(out_mid[i], solved.mid), 0.0f, MID_TOLERANCE);
+                CHECK_NEAR(distance(out_end[i], solved.end), 0.0f, TOLERANCE);
+
+                // Bone lengths are kept whatever the target.
+                CHECK_NEAR(distance(batch.root[i], out_mid[i]), distance(batch.root[i], batch.mid[i]), TOLERANCE);
+                CHECK_NEAR(distance(out_mid[i], out_end[i]), distance(batch.mid[i], batch.end[i]), TOLERANCE);
+
+                if (reached[i]) {
+                    CHECK_NEAR(distance(out_end[i], batch.target[i]), 0.0f, TOLERANCE);
+                }
+            }
+
+            CHECK(num_reached == expected_reached);
+
+            // The batch has to exercise both outcomes.
+            CHECK(num_reached > 0 && num_reached < COUNT);
+        }
+    }
+}
+
+// Every chain solved on its own has to come out bit for bit the same as in the batch.
+void test_batch_parity() {
+    constexpr size_t COUNT = 11;
+    const auto batch = make_batch(COUNT, 42);
+    std::vector<Vector4f> out_mid(COUNT);
+    std::vector<Vector4f> out_end(COUNT);
+
+    solve_two_bone(batch.root, batch.mid, batch.end, batch.target, batch.pole, {}, out_mid, out_end);
+
+    for (size_t i = 0; i < COUNT; ++i) {
+        Vector4f mid{};
+        Vector4f end{};
+
+        solve_two_bone({&batch.root[i], 1}, {&batch.mid[i], 1}, {&batch.end[i], 1}, {&batch.target[i], 1}, {&batch.pole[i], 1}, {},
+            {&mid, 1}, {&end, 1});
+
+        CHECK(same_bits(mid, out_mid[i]));
+        CHECK(same_bits(end, out_end[i]));
+    }
+}
+
+bool is_finite(const Vector4f& v) {
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z) && std::isfinite(v.w);
+}
+
+// Collapsed bones, targets on the root and poles on the root -> target line must not produce NaNs.
+void test_degenerate() {
+    const Vector4f origin{0.0f, 0.0f, 0.0f, 1.0f};
+    const Vector4f up{0.0f, 1.0f, 0.0f, 1.0f};
+    const Vector4f right{1.0f, 0.0f, 0.0f, 1.0f};
+    const Vector4f far_right{2.0f, 0.0f, 0.0f, 1.0f};
+
+    const std::vector<Chain> chains{
+        {origin, origin, up},        // elbow on the shoulder
+        {origin, up, up},            // wrist on the elbow
+        {origin, origin, origin},    // everything collapsed
+        {origin, up, origin},        // fully folded
+        {origin, right, far_right},  // straight
+    };
+
+    const std::vector<Vector4f> targets{origin, {0.0f, 0.5f, 0.0f, 1.0f}, {0.0f, 3.0f, 0.0f, 1.0f}};
+
+    for (const auto& chain : chains) {
+        for (const auto& target : targets) {
+            for (const auto& pole : {origin, target}) {
+                Vector4f mid{};
+                Vector4f end{};
+
+                solve_two_bone({&chain.root, 1}, {&chain.mid, 1}, {&chain.end, 1}, {&target, 1}, {&pole, 1}, {}, {&mid, 1}, {&end, 1});
+
+                CHECK(is_finite(mid));
+                CHECK(is_finite(end));
+                CHECK_NEAR(distance(chain.root, mid), distance(chain.root, chain.mid), TOLERANCE);
+                CHECK_NEAR(distance(mid, end), distance(chain.mid, chain.end), TOLERANCE);
+            }
+        }
+    }
+}
+
+void test_fabrik() {
+    constexpr size_t JOINTS = 5;
+    constexpr size_t COUNT = 7;
+    constexpr float BONE = 0.2f;
+
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<float> pos{-0.4f, 0.4f}; // always within the 0.8 reach
+    std::vector<Vector4f> chains(JOINTS * COUNT);
+    std::vector<Vector4f> targets{};
+    std::vector<Vector4f> poles(COUNT, Vector4f{1.0f, 0.4f, 0.0f, 1.0f});
+
+    for (size_t c = 0; c < COUNT; ++c) {
+        for (size_t j = 0; j < JOINTS; ++j) {
+            chains[c * JOINTS + j] = Vector4f{0.0f, BONE * j, 0.0f, 1.0f};
+        }
+
+        targets.emplace_back(pos(rng), pos(rng), pos(rng), 1.0f);
+    }
+
+    // One target out of reach.
+    targets[3] = Vector4f{0.0f, 0.0f, 2.0f, 1.0f};
+
+    const auto original = chains;
+    const FabrikSettings settings{20, 1e-4f};
+    std::vector<uint8_t> reached(COUNT);
+
+    const auto num_reached = fabrik(chains, JOINTS, targets, poles, settings, reached);
+
+    size_t expected_reached{0};
+
+    for (size_t c = 0; c < COUNT; ++c) {
+        const auto* joints = &chains[c * JOINTS];
+
+        CHECK(same_bits(joints[0], original[c * JOINTS]));
+
+        for (size_t j = 0; j + 1 < JOINTS; ++j) {
+            CHECK_NEAR(distance(joints[j], joints[j + 1]), BONE, TOLERANCE);
+        }
+
+        const auto error = distance(joints[JOINTS - 1], targets[c]);
+        CHECK((bool)reached[c] == (error <= settings.tolerance));
+        expected_reached += reached[c];
+
+        // Solved on its own the chain comes out the same.
+        std::vector<Vector4f> single(original.begin() + c * JOINTS, original.begin() + (c + 1) * JOINTS);
+        fabrik(single, JOINTS, {&targets[c], 1}, {&poles[c], 1}, settings);
+
+        for (size_t j = 0; j < JOINTS; ++j) {
+            CHECK(same_bits(single[j], joints[j]));
+        }
+    }
+
+    CHECK(num_reached == expected_reached);
+    CHECK(reached[3] == 0);
+    CHECK(num_reached >= COUNT - 1);
+
+    // The unreachable chain points straight at its target.
+    CHECK_NEAR(distance(chains[3 * JOINTS + JOINTS - 1], Vector4f{0.0f, 0.0f, BONE * (JOINTS - 1), 1.0f}), 0.0f, TOLERANCE);
+}
+}
+
+int main() {
+    test_golden();
+    test_matches_reference();
+    test_batch_parity();
+    test_degenerate();
+    test_fabrik();
+
+    return test::result();
+}
@@ -0,0 +1,192 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <sdk/MathBatch.hpp>
+
+namespace {
+using namespace utility::math::batch;
+
+const Vector2f SCREEN_SIZE{1920.0f, 1080.0f};
+
+// Pixel tolerance, the batched path multiplies by 1/w instead of dividing.
+constexpr float EPSILON = 0.01f;
+
+Matrix4x4f make_view_proj() {
+    const auto proj = glm::perspectiveRH_ZO(glm::radians(90.0f), SCREEN_SIZE.x / SCREEN_SIZE.y, 0.1f, 1000.0f);
+    const auto view = glm::lookAtRH(Vector3f{1.0f, 2.0f, 3.0f}, Vector3f{1.0f, 2.0f, -7.0f}, Vector3f{0.0f, 1.0f, 0.0f});
+
+    return proj * view;
+}
+
+// glm::project has its origin at the bottom left, project_to_screen at the top left.
+Vector2f reference_project(const Vector4f& point, const Matrix4x4f& view_proj) {
+    const auto projected = glm::project(Vector3f{point}, Matrix4x4f{1.0f}, view_proj, Vector4f{0.0f, 0.0f, SCREEN_SIZE.x, SCREEN_SIZE.y});
+
+    return Vector2f{projected.x, SCREEN_SIZE.y - projected.y};
+}
+
+float clip_w(const Vector4f& point, const Matrix4x4f& view_proj) {
+    return (view_proj * Vector4f{Vector3f{point}, 1.0f}).w;
+}
+
+// Compares every visible output against glm::project. Runs a count that isn't a multiple
+// of 4 so both the SSE loop and the scalar tail get covered.
+void test_matches_glm_project() {
+    const auto view_proj = make_view_proj();
+
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> dist{-50.0f, 50.0f};
+    std::vector<Vector4f> points{};
+
+    for (size_t i = 0; i < 1003; ++i) {
+        points.emplace_back(dist(rng), dist(rng), dist(rng), dist(rng)); // w is ignored
+    }
+
+    std::vector<Vector2f> out(points.size());
+    std::vector<uint8_t> visible(points.size());
+
+    const auto num_visible = project_to_screen(points, view_proj, SCREEN_SIZE, false, out, visible);
+
+    size_t expected_visible{0};
+    size_t num_offscreen{0};
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto in_front = clip_w(points[i], view_proj) > 1e-5f;
+
+        CHECK((bool)visible[i] == in_front);
+
+        if (!in_front || !visible[i]) {
+            continue;
+        }
+
+        ++expected_visible;
+
+        // Closer than the near plane a tiny w amplifies rounding differences too much to compare.
+        if (clip_w(points[i], view_proj) < 0.1f) {
+            continue;
+        }
+
+        const auto expected = reference_project(points[i], view_proj);
+
+        CHECK_NEAR(out[i].x, expected.x, EPSILON * std::max(1.0f, std::abs(expected.x) / SCREEN_SIZE.x));
+        CHECK_NEAR(out[i].y, expected.y, EPSILON * std::max(1.0f, std::abs(expected.y) / SCREEN_SIZE.y));
+
+        if (expected.x < 0.0f || expected.x > SCREEN_SIZE.x || expected.y < 0.0f || expected.y > SCREEN_SIZE.y) {
+            ++num_offscreen;
+        }
+    }
+
+    CHECK(num_visible == expected_visible);
+
+    // The scene has to actually exercise both sides of the camera and off-screen points.
+    CHECK(expected_visible > 0 && expected_visible < points.size());
+    CHECK(num_offscreen > 0);
+}
+
+void test_behind_camera() {
+    const auto view_proj = make_view_proj();
+    const Vector2f sentinel{-12345.0f, -12345.0f};
+
+    // Camera at (1, 2, 3) looking down -z.
+    const std::vector<Vector4f> points{
+        {1.0f, 2.0f, 10.0f, 1.0f},  // straight behind
+        {1.0f, 2.0f, 3.0f, 1.0f},   // on the camera, w == 0
+        {5.0f, -3.0f, 3.0f, 1.0f},  // on the camera plane, w == 0
+        {1.0f, 2.0f, 3.001f, 1.0f}, // just behind
+        {40.0f, 2.0f, 4.0f, 1.0f},  // behind and far to the side
+    };
+
+    for (const auto cull_offscreen : {false, true}) {
+        for (size_t n = 1; n <= points.size(); ++n) {
+            // Run it at every length so the points land in both the SSE loop and the tail.
+            std::vector<Vector2f> out(n, sentinel);
+            std::vector<uint8_t> visible(n, 0xFF);
+
+            const auto num_visible = project_to_screen(std::span{points.data(), n}, view_proj, SCREEN_SIZE, cull_offscreen, out, visible);
+
+            CHECK(num_visible == 0);
+
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(clip_w(points[i], view_proj) <= 1e-5f);
+                CHECK(visible[i] == 0);
+
+                // Only written for visible points.
+                CHECK(out[i].x == sentinel.x && out[i].y == sentinel.y);
+            }
+        }
+    }
+}
+
+void test_offscreen() {
+    const auto view_proj = make_view_proj();
+
+    // All in front of the camera, 10 units down -z.
+    const std::vector<Vector4f> points{
+        {1.0f, 2.0f, -7.0f, 1.0f},    // center of the screen
+        {100.0f, 2.0f, -7.0f, 1.0f},  // off the right
+        {-100.0f, 2.0f, -7.0f, 1.0f}, // off the left
+        {1.0f, 100.0f, -7.0f, 1.0f},  // off the top
+        {1.0f, -100.0f, -7.0f, 1.0f}, // off the bottom
+        {1.0f, 2.0f, -2000.0f, 1.0f}, // past the far plane
+        {3.0f, 3.0f, -7.0f, 1.0f},    // on screen
+    };
+
+    std::vector<Vector2f> out(points.size());
+    std::vector<uint8_t> visible(points.size());
+
+    // Without culling everything in front gets projected, even outside the screen.
+    CHECK(project_to_screen(points, view_proj, SCREEN_SIZE, false, out, visible) == points.size());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto expected = reference_project(points[i], view_proj);
+
+        CHECK(visible[i] == 1);
+        CHECK_NEAR(out[i].x, expected.x, EPSILON * std::max(1.0f, std::abs(expected.x) / SCREEN_SIZE.x));
+        CHECK_NEAR(out[i].y, expected.y, EPSILON * std::max(1.0f, std::abs(expected.y) / SCREEN_SIZE.y));
+    }
+
+    CHECK_NEAR(out[0].x, SCREEN_SIZE.x * 0.5f, EPSILON);
+    CHECK_NEAR(out[0].y, SCREEN_SIZE.y * 0.5f, EPSILON);
+    CHECK(out[1].x > SCREEN_SIZE.x);
+    CHECK(out[2].x < 0.0f);
+    CHECK(out[3].y < 0.0f); // y goes down
+    CHECK(out[4].y > SCREEN_SIZE.y);
+
+    // With culling only the two on-screen points survive.
+    const std::vector<uint8_t> expected_visible{1, 0, 0, 0, 0, 0, 1};
+
+    CHECK(project_to_screen(points, view_proj, SCREEN_SIZE, true, out, visible) == 2);
+    CHECK(visible == expected_visible);
+}
+
+void test_output_sizes() {
+    const auto view_proj = make_view_proj();
+    const std::vector<Vector4f> points(9, Vector4f{1.0f, 2.0f, -7.0f, 1.0f});
+    const Vector2f sentinel{-1.0f, -1.0f};
+
+    std::vector<Vector2f> out(6, sentinel);
+    std::vector<uint8_t> visible(points.size(), 0xFF);
+
+    // Only min(points, out, visible) elements are processed.
+    CHECK(project_to_screen(points, view_proj, SCREEN_SIZE, true, out, visible) == 6);
+
+    for (size_t i = 6; i < visible.size(); ++i) {
+        CHECK(visible[i] == 0xFF);
+    }
+}
+}
+
+int main() {
+    test_matches_glm_project();
+    test_behind_camera();
+    test_offscreen();
+    test_output_sizes();
+
+    return test::result();
+}
@@ -0,0 +1,235 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <sdk/MurmurHash.hpp>
+
+using namespace sdk::murmur_hash;
+using namespace sdk::murmur_hash::literals;
+
+namespace {
+// Straight port of the reference MurmurHash3_x86_32 from SMHasher, byte oriented and with any seed.
+uint32_t reference(const void* key, size_t len, uint32_t seed) {
+    const auto data = (const uint8_t*)key;
+    const auto num_blocks = len / 4;
+
+    auto h1 = seed;
+    constexpr uint32_t c1 = 0xcc9e2d51;
+    constexpr uint32_t c2 = 0x1b873593;
+
+    const auto rotl = [](uint32_t x, int r) { return (x << r) | (x >> (32 - r)); };
+
+    for (size_t i = 0; i < num_blocks; ++i) {
+        auto k1 = (uint32_t)data[i * 4] | ((uint32_t)data[i * 4 + 1] << 8) | ((uint32_t)data[i * 4 + 2] << 16) | ((uint32_t)data[i * 4 + 3] << 24);
+
+        k1 *= c1;
+        k1 = rotl(k1, 15);
+        k1 *= c2;
+
+        h1 ^= k1;
+        h1 = rotl(h1, 13);
+        h1 = h1 * 5 + 0xe6546b64;
+    }
+
+    const auto tail = data + num_blocks * 4;
+    uint32_t k1 = 0;
+
+    switch (len & 3) {
+    case 3: k1 ^= (uint32_t)tail[2] << 16; [[fallthrough]];
+    case 2: k1 ^= (uint32_t)tail[1] << 8; [[fallthrough]];
+    case 1:
+        k1 ^= tail[0];
+        k1 *= c1;
+        k1 = rotl(k1, 15);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= (uint32_t)len;
+
+    h1 ^= h1 >> 16;
+    h1 *= 0x85ebca6b;
+    h1 ^= h1 >> 13;
+    h1 *= 0xc2b2ae35;
+    h1 ^= h1 >> 16;
+
+    return h1;
+}
+
+uint32_t reference(std::string_view str, uint32_t seed) {
+    return reference(str.data(), str.size(), seed);
+}
+
+// What the engine hashes: the UTF-16LE bytes of the string with the fixed seed.
+uint32_t reference_engine(std::u16string_view str) {
+    std::vector<uint8_t> bytes{};
+
+    for (const auto c : str) {
+        bytes.push_back((uint8_t)(c & 0xFF));
+        bytes.push_back((uint8_t)(c >> 8));
+    }
+
+    return reference(bytes.data(), bytes.size(), SEED);
+}
+
+// Published MurmurHash3_x86_32 test vectors, they make sure the reference above is right.
+void test_reference_vectors() {
+    using namespace std::string_view_literals;
+
+    CHECK(reference(""sv, 0) == 0);
+    CHECK(reference(""sv, 1) == 0x514E28B7);
+    CHECK(reference(""sv, 0xffffffff) == 0x81F16F39);
+    CHECK(reference("\0\0\0\0"sv, 0) == 0x2362F9DE);
+    CHECK(reference("\xff\xff\xff\xff"sv, 0) == 0x76293B50);
+    CHECK(reference("\x21\x43\x65\x87"sv, 0) == 0xF55B516B);
+    CHECK(reference("\x21\x43\x65\x87"sv, 0x5082EDEE) == 0x2362F9DE);
+    CHECK(reference("\x21\x43\x65"sv, 0) == 0x7E4A8634);
+    CHECK(reference("\x21\x43"sv, 0) == 0xA0F7B07A);
+    CHECK(reference("\x21"sv, 0) == 0x72661CF4);
+    CHECK(reference("\0\0\0"sv, 0) == 0x85F0B427);
+    CHECK(reference("\0\0"sv, 0) == 0x30F4C306);
+    CHECK(reference("\0"sv, 0) == 0x514E28B7);
+    CHECK(reference("aaaa"sv, 0x9747b28c) == 0x5A97808A);
+    CHECK(reference("abcd"sv, 0x9747b28c) == 0xF0478627);
+    CHECK(reference("Hello, world!"sv, 0x9747b28c) == 0x24884CBA);
+    CHECK(reference("The quick brown fox jumps over the lazy dog"sv, 0x9747b28c) == 0x2FA826CD);
+}
+
+// Names the mods look joints up by. There is no dump of engine hashes to compare against outside
+// of the game, these come from the reference over the engine's input (UTF-16LE, seed 0xFFFFFFFF).
+// In game, calc32 also checks itself against via.murmur_hash.calc32 before it's trusted.
+struct NamedHash {
+    std::u16string_view name;
+    uint32_t hash;
+};
+
+constexpr NamedHash JOINT_NAMES[]{
+    {u"Head", 0x37bf5346},
+    {u"Neck", 0x67e9c859},
+    {u"Neck_0", 0xc352c22b},
+    {u"Neck_1", 0xeb3b6844},
+    {u"Chest", 0xcef22c7b},
+    {u"root", 0xaba7de3c},
+    {u"COG", 0xcc3297ea},
+    {u"head", 0x2bf882e3},
+    {u"l_arm_wrist", 0xeb6aaf75},
+    {u"r_arm_wrist", 0x73ba45f2},
+    {u"vfx_muzzle1", 0xaccc466a},
+    {u"vfx_muzzle2", 0x317667ef},
+};
+
+static_assert("Head"_murmur == 0x37bf5346);
+static_assert(u"r_arm_wrist"_murmur == 0x73ba45f2);
+static_assert(L"vfx_muzzle1"_murmur == 0xaccc466a);
+
+void test_names() {
+    for (const auto& [name, hash] : JOINT_NAMES) {
+        const std::string narrow(name.begin(), name.end());
+        const std::wstring wide(name.begin(), name.end());
+
+        CHECK(reference_engine(name) == hash);
+        CHECK(calc32_native(name) == hash);
+        CHECK(calc32_native(std::string_view{narrow}) == hash);
+        CHECK(calc32_native(std::wstring_view{wide}) == hash);
+    }
+
+    CHECK(calc32_native(std::u16string_view{}) == reference_engine(u""));
+    CHECK(calc32_native(std::string_view{}) == 0x81F16F39); // the published vector for an empty key and this seed
+}
+
+// Every length up to a few blocks, so each tail size goes through the native version.
+void test_lengths() {
+    std::u16string str{};
+
+    for (size_t i = 0; i < 40; ++i) {
+        CHECK(calc32_native(str) == reference_engine(str));
+        str += (char16_t)(u'a' + i % 26);
+    }
+}
+
+void test_utf8() {
+    using namespace std::string_view_literals;
+
+    // Two, three and four byte sequences, the last one as a surrogate pair.
+    CHECK(calc32_native("\xC3\x81"sv) == calc32_native(u"\u00C1"));
+    CHECK(calc32_native("\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E"sv) == 0x45d41e4e);
+    CHECK(calc32_native("\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E"sv) == reference_engine(u"\u65E5\u672C\u8A9E"));
+    CHECK(calc32_native("\xF0\x9F\x98\x80"sv) == 0x473b082c);
+    CHECK(calc32_native("\xF0\x9F\x98\x80"sv) == reference_engine(u"\xD83D\xDE00"));
+    CHECK(calc32_native(u"\U0001F600") == calc32_native(u"\xD83D\xDE00"));
+    CHECK(calc32_native(L"\U0001F600") == calc32_native(u"\xD83D\xDE00"));
+    CHECK("\xF0\x9F\x98\x80"_murmur == 0x473b082c);
+
+    // Anything invalid is one U+FFFD per byte and doesn't swallow what follows.
+    CHECK(calc32_native("\xC3" "A"sv) == 0xbe43e710);
+    CHECK(calc32_native("\xC3" "A"sv) == reference_engine(u"\xFFFD" "A"));
+    CHECK(calc32_native("\x80"sv) == reference_engine(u"\xFFFD"));
+    CHECK(calc32_native("\xFF" "ab"sv) == reference_engine(u"\xFFFD" "ab"));
+    CHECK(calc32_native("\xC0\xAF"sv) == reference_engine(u"\xFFFD\xFFFD")); // overlong '/'
+    CHECK(calc32_native("\xE0\x80\xAF"sv) == reference_engine(u"\xFFFD\xFFFD\xFFFD")); // overlong '/'
+    CHECK(calc32_native("\xED\xA0\x80"sv) == reference_engine(u"\xFFFD\xFFFD\xFFFD")); // surrogate U+D800
+    CHECK(calc32_native("\xF4\x90\x80\x80"sv) == reference_engine(u"\xFFFD\xFFFD\xFFFD\xFFFD")); // past U+10FFFF
+    CHECK(calc32_native("\xE6\x97"sv) == reference_engine(u"\xFFFD\xFFFD")); // truncated
+    CHECK(calc32_native("a\xE6\x97" "b"sv) == reference_engine(u"a\xFFFD\xFFFD" "b"));
+}
+
+// The SSE2 batch against one at a time, with counts that leave a remainder and lanes of different lengths.
+void test_batch() {
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<size_t> length{0, 24};
+    std::uniform_int_distribution<uint32_t> unit{0, 0xFFFF};
+
+    std::vector<std::u16string> storage{};
+
+    for (const auto& [name, hash] : JOINT_NAMES) {
+        storage.emplace_back(name);
+    }
+
+    for (size_t i = 0; i < 101; ++i) {
+        auto& str = storage.emplace_back(length(rng), u'\0');
+
+        for (auto& c : str) {
+            c = (char16_t)unit(rng);
+        }
+    }
+
+    std::vector<std::u16string_view> strs(storage.begin(), storage.end());
+
+    for (const auto count : {strs.size(), (size_t)0, (size_t)3, (size_t)4, (size_t)9}) {
+        const std::span<const std::u16string_view> batch{strs.data(), count};
+        std::vector<uint32_t> out(count + 1, 0xDEADBEEF);
+
+        calc32_native(batch, std::span<uint32_t>{out.data(), count});
+
+        for (size_t i = 0; i < count; ++i) {
+            CHECK(out[i] == calc32_native(strs[i]));
+            CHECK(out[i] == reference_engine(strs[i]));
+        }
+
+        CHECK(out[count] == 0xDEADBEEF);
+    }
+
+    // out shorter than strs only fills what fits.
+    std::vector<uint32_t> out(5, 0);
+    calc32_native(strs, out);
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        CHECK(out[i] == JOINT_NAMES[i].hash);
+    }
+}
+}
+
+int main() {
+    test_reference_vectors();
+    test_names();
+    test_lengths();
+    test_utf8();
+    test_batch();
+
+    return test::result();
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <sdk/SpatialGrid.hpp>
+
+using utility::math::SpatialGrid;
+
+namespace {
+// A synthetic scene laid out like a typical level: mostly flat, objects spread over 1km,
+// three tag groups and everything drifting a little every frame.
+constexpr size_t NUM_OBJECTS = 20000;
+constexpr size_t NUM_FRAMES = 100;
+constexpr size_t NUM_QUERIES = 1000;
+constexpr size_t NUM_CHECKED = 50; // queries also checked against brute force
+
+struct Scene {
+    std::vector<Vector3f> positions{};
+    std::vector<uint64_t> tags{};
+};
+
+Scene make_scene(std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist{-500.0f, 500.0f};
+    Scene scene{};
+
+    for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+        scene.positions.emplace_back(dist(rng), dist(rng) * 0.1f, dist(rng));
+        scene.tags.push_back(1ull << (i % 3));
+    }
+
+    return scene;
+}
+
+float distance2(const Vector3f& a, const Vector3f& b) {
+    const auto d = a - b;
+    return glm::dot(d, d);
+}
+
+bool in_frustum(const Matrix4x4f& view_proj, const Vector3f& p) {
+    const auto clip = view_proj * Vector4f{p, 1.0f};
+    return std::abs(clip.x) <= clip.w && std::abs(clip.y) <= clip.w && clip.z >= 0.0f && clip.z <= clip.w;
+}
+}
+
+int main() {
+    std::mt19937 rng{3};
+    std::uniform_real_distribution<float> dist{-500.0f, 500.0f};
+    std::uniform_real_distribution<float> drift{-0.5f, 0.5f};
+
+    auto scene = make_scene(rng);
+
+    SpatialGrid grid{8.0f};
+    std::vector<uint32_t> ids{};
+
+    const auto insert_ms = test::time_ms(1, [&]() {
+        for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+            ids.push_back(grid.insert(scene.positions[i], scene.tags[i]));
+        }
+    });
+
+    // Some churn so freed ids get reused.
+    for (size_t i = 0; i < NUM_OBJECTS; i += 7) {
+        grid.remove(ids[i]);
+        ids[i] = grid.insert(scene.positions[i], scene.tags[i]);
+    }
+
+    const auto update_ms = test::time_ms(NUM_FRAMES, [&]() {
+        for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+            scene.positions[i] = scene.positions[i] + Vector3f{drift(rng), 0.0f, drift(rng)};
+            grid.update(ids[i], scene.positions[i]);
+        }
+    });
+
+    size_t mismatches{0};
+    size_t total_hits{0};
+    size_t query_index{0};
+    std::vector<uint32_t> out{};
+
+    const auto radius_ms = test::time_ms(NUM_QUERIES, [&]() {
+        const Vector3f center{dist(rng), 0.0f, dist(rng)};
+        constexpr float radius = 30.0f;
+
+        out.clear();
+        grid.query_radius(center, radius, 0, out);
+        total_hits += out.size();
+
+        if (query_index++ < NUM_CHECKED) {
+            const auto expected = std::count_if(scene.positions.begin(), scene.positions.end(), [&](const auto& p) {
+                return distance2(p, center) <= radius * radius;
+            });
+
+            mismatches += (size_t)expected != out.size();
+        }
+    });
+
+    query_index = 0;
+
+    const auto nearest_ms = test::time_ms(NUM_QUERIES, [&]() {
+        const Vector3f center{dist(rng), 0.0f, dist(rng)};
+        constexpr size_t k = 8;
+        constexpr uint64_t tag = 1ull << 1;
+
+        out.clear();
+        grid.query_nearest(center, k, 1000.0f, tag, out);
+
+        if (query_index++ < NUM_CHECKED) {
+            std::vector<float> expected{};
+
+            for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+                if ((scene.tags[i] & tag) != 0) {
+                    expected.push_back(distance2(scene.positions[i], center));
+                }
+            }
+
+            std::partial_sort(expected.begin(), expected.begin() + k, expected.end());
+
+            if (out.size() != k) {
+                ++mismatches;
+                return;
+            }
+
+            for (size_t j = 0; j < k; ++j) {
+                mismatches += std::abs(distance2(grid.get_position(out[j]), center) - expected[j]) > 1e-3f;
+            }
+        }
+    });
+
+    // D3D style perspective from the origin looking down +z, 200 units deep.
+    Matrix4x4f view_proj{0.0f};
+    const auto near_z = 0.1f;
+    const auto far_z = 200.0f;
+    view_proj[0][0] = 1.0f;
+    view_proj[1][1] = 1.0f;
+    view_proj[2][2] = far_z / (far_z - near_z);
+    view_proj[2][3] = 1.0f;
+    view_proj[3][2] = -near_z * far_z / (far_z - near_z);
+
+    const auto frustum_ms = test::time_ms(NUM_FRAMES, [&]() {
+        out.clear();
+        grid.query_frustum(view_proj, 0, out);
+    });
+
+    const auto brute_frustum_ms = test::time_ms(NUM_FRAMES, [&]() {
+        size_t expected{0};
+
+        for (const auto& p : scene.positions) {
+            expected += in_frustum(view_proj, p);
+        }
+
+        mismatches += expected != out.size();
+    });
+
+    std::printf("%zu objects, %zu cells\n", grid.size(), grid.num_cells());
+    std::printf("insert all:       %8.3f ms\n", insert_ms);
+    std::printf("update all:       %8.3f ms/frame\n", update_ms);
+    std::printf("radius(30):       %8.4f ms/query, %.1f hits avg\n", radius_ms, (double)total_hits / NUM_QUERIES);
+    std::printf("nearest(8):       %8.4f ms/query\n", nearest_ms);
+    std::printf("frustum:          %8.4f ms/query, %zu hits\n", frustum_ms, out.size());
+    std::printf("frustum (linear): %8.4f ms/query\n", brute_frustum_ms);
+    std::printf("%zu mismatches against brute force\n", mismatches);
+
+    return mismatches == 0 ? 0 : 1;
+}
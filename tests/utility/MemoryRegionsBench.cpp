@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <utility/MemoryRegions.hpp>
+
+namespace memory_regions = utility::memory_regions;
+
+namespace {
+constexpr size_t NUM_PROBES = 2000;
+constexpr size_t NUM_HEAP_BLOCKS = 64;
+
+// Lives in the executable's file mapping, which stands in for a module image on Linux.
+const char g_image_data[64]{"image backed"};
+
+// The old IsBadMemPtr: one OS query per region the range touches, nothing cached.
+bool baseline_is_bad_mem_ptr(bool write, const void* ptr, size_t size) {
+    if (size == 0) {
+        return false;
+    }
+
+    if (ptr == nullptr) {
+        return true;
+    }
+
+    const auto wanted = write ? (memory_regions::READ | memory_regions::WRITE) : memory_regions::READ;
+    const auto end = (uintptr_t)ptr + size;
+
+    for (auto p = (uintptr_t)ptr; p < end;) {
+        const auto region = memory_regions::os::query(p);
+
+        if (!region || (region->access & wanted) != wanted) {
+            return true;
+        }
+
+        p = region->end;
+    }
+
+    return false;
+}
+
+template <typename F>
+double us_per_probe(const std::vector<const void*>& ptrs, F&& probe) {
+    size_t num_bad{0};
+
+    const auto ms = test::time_ms(NUM_PROBES / ptrs.size(), [&]() {
+        for (auto ptr : ptrs) {
+            num_bad += probe(ptr);
+        }
+    });
+
+    if (num_bad > 0) {
+        std::printf("unexpected bad pointers: %zu\n", num_bad);
+    }
+
+    return ms * 1000.0 / (double)ptrs.size();
+}
+}
+
+// Probes the way IsBadMemPtr gets called: vtables and globals in the module image,
+// objects on the heap.
+int main() {
+    const std::vector<const void*> image_ptrs{g_image_data, (const void*)&baseline_is_bad_mem_ptr, (const void*)&main};
+
+    std::vector<std::unique_ptr<char[]>> blocks{};
+    std::vector<const void*> heap_ptrs{};
+
+    for (size_t i = 0; i < NUM_HEAP_BLOCKS; ++i) {
+        heap_ptrs.push_back(blocks.emplace_back(std::make_unique<char[]>(0x100)).get());
+    }
+
+    const auto is_bad = [](const void* ptr) { return !memory_regions::is_readable(ptr, sizeof(void*)); };
+    const auto baseline = [](const void* ptr) { return baseline_is_bad_mem_ptr(false, ptr, sizeof(void*)); };
+
+    memory_regions::refresh();
+
+    const auto queries_before = memory_regions::num_os_queries();
+    const auto image_ms = us_per_probe(image_ptrs, is_bad);
+    const auto image_queries = memory_regions::num_os_queries() - queries_before;
+    const auto image_baseline_ms = us_per_probe(image_ptrs, baseline);
+
+    const auto heap_ms = us_per_probe(heap_ptrs, is_bad);
+    const auto heap_baseline_ms = us_per_probe(heap_ptrs, baseline);
+
+    std::printf("%zu probes of %zu bytes, us/probe\n", NUM_PROBES, sizeof(void*));
+    std::printf("image: %8.3f (IsBadMemPtr %8.3f), %llu OS queries\n", image_ms, image_baseline_ms, (unsigned long long)image_queries);
+    std::printf("heap:  %8.3f (IsBadMemPtr %8.3f)\n", heap_ms, heap_baseline_ms);
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <Test.hpp>
+
+#include <utility/MemoryRegions.hpp>
+
+namespace memory_regions = utility::memory_regions;
+
+namespace {
+// Lives in the executable's file mapping, which stands in for a module image on Linux.
+const char g_image_data[64]{"image backed"};
+
+uint64_t queries_for(const void* ptr, size_t size = 1) {
+    const auto before = memory_regions::num_os_queries();
+    memory_regions::is_readable(ptr, size);
+    return memory_regions::num_os_queries() - before;
+}
+
+void test_image_cache_hit() {
+    memory_regions::invalidate();
+
+    CHECK(memory_regions::is_readable(g_image_data, sizeof(g_image_data)));
+    CHECK(!memory_regions::is_writable(g_image_data, sizeof(g_image_data)));
+
+    // Second lookup is answered from the cache.
+    CHECK(queries_for(g_image_data) == 0);
+    CHECK(memory_regions::num_cached_regions() > 0);
+}
+
+void test_expiry() {
+    CHECK(queries_for(g_image_data) == 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+
+    CHECK(queries_for(g_image_data) == 1);
+    CHECK(queries_for(g_image_data) == 0);
+}
+
+void test_invalidation() {
+    CHECK(queries_for(g_image_data) == 0);
+
+    const auto generation = memory_regions::generation();
+    memory_regions::invalidate();
+
+    CHECK(memory_regions::generation() != generation);
+    CHECK(queries_for(g_image_data) == 1);
+    CHECK(queries_for(g_image_data) == 0);
+}
+
+void test_refresh() {
+    CHECK(memory_regions::refresh() > 0);
+    CHECK(queries_for(g_image_data) == 0);
+    CHECK(queries_for((const void*)&test_refresh) == 0);
+}
+
+// Anonymous memory can be freed at any time, it must never be answered from the cache.
+void test_heap_not_cached() {
+    const auto page_size = (size_t)sysconf(_SC_PAGESIZE);
+    auto page = mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    CHECK(page != MAP_FAILED);
+
+    CHECK(memory_regions::is_writable(page, page_size));
+    CHECK(queries_for(page) == 1);
+    CHECK(queries_for(page) == 1);
+
+    mprotect(page, page_size, PROT_READ);
+
+    CHECK(memory_regions::is_readable(page, page_size));
+    CHECK(!memory_regions::is_writable(page, page_size));
+
+    munmap(page, page_size);
+
+    CHECK(!memory_regions::is_readable(page, 1));
+}
+
+// Heap probes skip the unique lock, except when the heap region took the place of a cached image region.
+void test_heap_replaces_image() {
+    const auto page_size = (size_t)sysconf(_SC_PAGESIZE);
+    auto file = std::tmpfile();
+
+    CHECK(file != nullptr && ftruncate(fileno(file), page_size) == 0);
+
+    auto page = mmap(nullptr, page_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+
+    CHECK(page != MAP_FAILED);
+    CHECK(memory_regions::is_readable(page, page_size));
+    CHECK(queries_for(page) == 0);
+
+    const auto num_cached = memory_regions::num_cached_regions();
+
+    CHECK(mmap(page, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == page);
+
+    // The cached image region doesn't allow writes, so this asks the OS and evicts it.
+    CHECK(memory_regions::is_writable(page, page_size));
+    CHECK(memory_regions::num_cached_regions() == num_cached - 1);
+    CHECK(queries_for(page) == 1);
+
+    munmap(page, page_size);
+    std::fclose(file);
+}
+
+void test_edge_cases() {
+    CHECK(memory_regions::is_readable(nullptr, 0));
+    CHECK(!memory_regions::is_readable(nullptr, 1));
+    CHECK(!memory_regions::is_readable((const void*)~(uintptr_t)0, 16));
+    CHECK(memory_regions::accessible_end(nullptr) == 0);
+    CHECK(memory_regions::accessible_end(g_image_data) > (uintptr_t)g_image_data);
+}
+}
+
+int main() {
+    test_image_cache_hit();
+    test_expiry();
+    test_invalidation();
+    test_refresh();
+    test_heap_not_cached();
+    test_heap_replaces_image();
+    test_edge_cases();
+
+    return test::result();
+}
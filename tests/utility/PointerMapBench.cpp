@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+#include <Test.hpp>
+
+#include <utility/PointerMap.hpp>
+
+namespace {
+// Roughly what a script walking every game object pushes in one frame.
+constexpr size_t NUM_OBJECTS = 100000;
+constexpr size_t NUM_FRAMES = 20;
+
+// Same layout as ScriptState::ManagedObjectRefs.
+struct ManagedObjectRefs {
+    int32_t ref_count{};
+    int32_t ephemeral_count{};
+};
+
+struct FakeObject {
+    uint8_t data[0x40]{};
+};
+
+// What sol_lua_push and release did before: three global Lua tables keyed by address, through sol proxies.
+void push_lua_tables(sol::state& lua, void* obj) {
+    sol::lua_table objects = lua["_sol_lua_push_objects"];
+    sol::lua_table ref_counts = lua["_sol_lua_push_ref_counts"];
+
+    if (sol::object cached = objects[(uintptr_t)obj]; !cached.valid()) {
+        objects[(uintptr_t)obj] = sol::make_object(lua, sol::lightuserdata_value{obj});
+    }
+
+    if (std::optional<int> current_ref_count = ref_counts[(uintptr_t)obj]; current_ref_count && *current_ref_count > 0) {
+        ref_counts[(uintptr_t)obj] = *current_ref_count + 1;
+    } else {
+        ref_counts[(uintptr_t)obj] = 1;
+    }
+}
+
+void release_lua_tables(sol::state& lua, void* obj) {
+    sol::lua_table objects = lua["_sol_lua_push_objects"];
+    sol::lua_table ref_counts = lua["_sol_lua_push_ref_counts"];
+    sol::lua_table ephemeral_counts = lua["_sol_lua_push_ephemeral_counts"];
+
+    if (std::optional<int> ref_count = ref_counts[(uintptr_t)obj]; ref_count && *ref_count > 0) {
+        const int new_ref_count = *ref_count - 1;
+
+        if (new_ref_count == 0) {
+            if (sol::object object = ephemeral_counts[(uintptr_t)obj]; !object.valid()) {
+                objects[(uintptr_t)obj] = sol::make_object(lua, sol::nil);
+            }
+
+            ref_counts[(uintptr_t)obj] = sol::make_object(lua, sol::nil);
+        } else {
+            ref_counts[(uintptr_t)obj] = new_ref_count;
+        }
+    }
+}
+
+// What they do now: the userdata cache is a registry table indexed with lua_rawgetp/lua_rawsetp
+// and the counts live in a native map.
+template <typename Map>
+void push_native(lua_State* l, int cache, Map& refs_table, void* obj) {
+    lua_rawgeti(l, LUA_REGISTRYINDEX, cache);
+
+    if (lua_rawgetp(l, -1, obj) == LUA_TNIL) {
+        lua_pop(l, 1);
+        lua_pushlightuserdata(l, obj);
+        lua_rawsetp(l, -2, obj);
+    } else {
+        lua_pop(l, 1);
+    }
+
+    lua_pop(l, 1);
+
+    auto& refs = refs_table[obj];
+    refs.ref_count = refs.ref_count > 0 ? refs.ref_count + 1 : 1;
+}
+
+ManagedObjectRefs* find(utility::PointerMap<ManagedObjectRefs>& refs_table, void* obj) {
+    return refs_table.find(obj);
+}
+
+ManagedObjectRefs* find(std::unordered_map<const void*, ManagedObjectRefs>& refs_table, void* obj) {
+    const auto it = refs_table.find(obj);
+    return it != refs_table.end() ? &it->second : nullptr;
+}
+
+template <typename Map>
+void release_native(lua_State* l, int cache, Map& refs_table, void* obj) {
+    auto refs = find(refs_table, obj);
+
+    if (refs == nullptr || refs->ref_count <= 0 || --refs->ref_count > 0) {
+        return;
+    }
+
+    refs_table.erase(obj);
+
+    lua_rawgeti(l, LUA_REGISTRYINDEX, cache);
+    lua_pushnil(l);
+    lua_rawsetp(l, -2, obj);
+    lua_pop(l, 1);
+}
+
+// Every object pushed twice (a field read and a method call on it), then both references released.
+template <typename Push, typename Release>
+double run_frames(const std::vector<FakeObject*>& objects, Push&& push, Release&& release) {
+    return test::time_ms(NUM_FRAMES, [&]() {
+        for (auto obj : objects) {
+            push(obj);
+            push(obj);
+        }
+
+        for (auto obj : objects) {
+            release(obj);
+            release(obj);
+        }
+    });
+}
+
+int make_cache(lua_State* l) {
+    lua_newtable(l);
+    lua_newtable(l);
+    lua_pushstring(l, "v");
+    lua_setfield(l, -2, "__mode");
+    lua_setmetatable(l, -2);
+    return luaL_ref(l, LUA_REGISTRYINDEX);
+}
+}
+
+int main() {
+    std::vector<FakeObject> storage(NUM_OBJECTS);
+    std::vector<FakeObject*> objects{};
+
+    for (auto& obj : storage) {
+        objects.push_back(&obj);
+    }
+
+    // Scripts don't visit objects in address order, which would flatter std::hash's identity hash.
+    std::shuffle(objects.begin(), objects.end(), std::mt19937{3});
+
+    sol::state lua{};
+    lua.open_libraries(sol::lib::base);
+    lua["_sol_lua_push_objects"] = lua.create_table();
+    lua["_sol_lua_push_ref_counts"] = lua.create_table();
+    lua["_sol_lua_push_ephemeral_counts"] = lua.create_table();
+
+    const auto lua_tables_ms = run_frames(objects,
+        [&](FakeObject* obj) { push_lua_tables(lua, obj); },
+        [&](FakeObject* obj) { release_lua_tables(lua, obj); });
+
+    const auto l = lua.lua_state();
+    const auto cache = make_cache(l);
+
+    utility::PointerMap<ManagedObjectRefs> pointer_map{4096};
+
+    const auto pointer_map_ms = run_frames(objects,
+        [&](FakeObject* obj) { push_native(l, cache, pointer_map, obj); },
+        [&](FakeObject* obj) { release_native(l, cache, pointer_map, obj); });
+
+    std::unordered_map<const void*, ManagedObjectRefs> unordered_map{};
+
+    const auto unordered_map_ms = run_frames(objects,
+        [&](FakeObject* obj) { push_native(l, cache, unordered_map, obj); },
+        [&](FakeObject* obj) { release_native(l, cache, unordered_map, obj); });
+
+    // Only the count bookkeeping, without the userdata cache.
+    const auto pointer_map_only_ms = run_frames(objects,
+        [&](FakeObject* obj) { ++pointer_map[obj].ref_count; },
+        [&](FakeObject* obj) {
+            if (auto refs = pointer_map.find(obj); refs != nullptr && --refs->ref_count <= 0) {
+                pointer_map.erase(obj);
+            }
+        });
+
+    const auto unordered_map_only_ms = run_frames(objects,
+        [&](FakeObject* obj) { ++unordered_map[obj].ref_count; },
+        [&](FakeObject* obj) {
+            if (auto it = unordered_map.find(obj); it != unordered_map.end() && --it->second.ref_count <= 0) {
+                unordered_map.erase(it);
+            }
+        });
+
+    std::printf("%zu objects pushed twice and released per frame\n", NUM_OBJECTS);
+    std::printf("lua tables (before):      %8.3f ms/frame\n", lua_tables_ms);
+    std::printf("cache + PointerMap:       %8.3f ms/frame\n", pointer_map_ms);
+    std::printf("cache + unordered_map:    %8.3f ms/frame\n", unordered_map_ms);
+    std::printf("PointerMap only:          %8.3f ms/frame\n", pointer_map_only_ms);
+    std::printf("unordered_map only:       %8.3f ms/frame\n", unordered_map_only_ms);
+    std::printf("%zu refs left over\n", pointer_map.size() + unordered_map.size());
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <utility/PointerMap.hpp>
+
+namespace {
+const void* ptr(uintptr_t value) {
+    return (const void*)value;
+}
+
+void test_null_key() {
+    utility::PointerMap<int> map{8};
+
+    CHECK(map.find(nullptr) == nullptr);
+    CHECK(!map.erase(nullptr));
+
+    map[nullptr] = 1;
+    map[ptr(0x1000)] = 2;
+
+    CHECK(map.size() == 2);
+    CHECK(map.find(nullptr) != nullptr && *map.find(nullptr) == 1);
+
+    // Must not have claimed an empty slot, otherwise probing for other keys breaks.
+    for (uintptr_t i = 1; i < 64; ++i) {
+        map[ptr(i * 0x10)] = (int)i;
+    }
+
+    CHECK(map.size() == 65);
+    CHECK(*map.find(nullptr) == 1);
+
+    for (uintptr_t i = 1; i < 64; ++i) {
+        CHECK(map.find(ptr(i * 0x10)) != nullptr && *map.find(ptr(i * 0x10)) == (int)i);
+    }
+
+    CHECK(map.erase(nullptr));
+    CHECK(map.find(nullptr) == nullptr);
+    CHECK(map.size() == 64);
+
+    map[nullptr] = 5;
+    map.clear();
+
+    CHECK(map.empty());
+    CHECK(map.find(nullptr) == nullptr);
+}
+
+// Random inserts and erases checked against std::unordered_map.
+void test_churn() {
+    utility::PointerMap<uint32_t> map{8};
+    std::unordered_map<const void*, uint32_t> reference{};
+    std::mt19937 rng{1};
+
+    for (uint32_t i = 0; i < 200000; ++i) {
+        const auto key = ptr((rng() % 4096) * 16);
+
+        if (rng() % 3 == 0) {
+            CHECK(map.erase(key) == (reference.erase(key) != 0));
+        } else {
+            map[key] = i;
+            reference[key] = i;
+        }
+    }
+
+    CHECK(map.size() == reference.size());
+
+    for (const auto& [key, value] : reference) {
+        CHECK(map.find(key) != nullptr && *map.find(key) == value);
+    }
+}
+}
+
+int main() {
+    test_null_key();
+    test_churn();
+
+    return test::result();
+}
@@ -0,0 +1,290 @@
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <Test.hpp>
+
+#include <utility/MemoryRegions.hpp>
+#include <utility/Relocate.hpp>
+
+namespace memory_regions = utility::memory_regions;
+
+namespace {
+const auto PAGE_SIZE = (size_t)sysconf(_SC_PAGESIZE);
+
+// Zeroed, so nothing in the scanned memory looks like a pointer unless a test puts it there.
+uint8_t* map_pages(size_t count) {
+    const auto p = mmap(nullptr, PAGE_SIZE * count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CHECK(p != MAP_FAILED);
+    return (uint8_t*)p;
+}
+
+void put(uint8_t* node, size_t offset, const void* value) {
+    const auto v = (uintptr_t)value;
+    std::memcpy(node + offset, &v, sizeof(v));
+}
+
+uintptr_t get(const uint8_t* node, size_t offset) {
+    uintptr_t v{};
+    std::memcpy(&v, node + offset, sizeof(v));
+    return v;
+}
+
+// The block being moved. Relocation also scans the old addresses it finds, so it's kept
+// a few pages long and zeroed, only the first OLD_SIZE bytes are the range being moved.
+struct Blocks {
+    static constexpr size_t OLD_SIZE = 0x100;
+
+    uint8_t* old_block{map_pages(3)};
+    uint8_t* new_block{map_pages(1)};
+
+    uintptr_t old_start() const { return (uintptr_t)old_block; }
+    uintptr_t old_end() const { return (uintptr_t)old_block + OLD_SIZE; }
+    uintptr_t new_start() const { return (uintptr_t)new_block; }
+
+    const void* old_at(size_t offset) const { return old_block + offset; }
+    uintptr_t new_at(size_t offset) const { return (uintptr_t)new_block + offset; }
+};
+
+// Two nodes pointing at each other and one pointing at itself, scanned deeper than the cycle is long.
+void test_cycle() {
+    Blocks blocks{};
+    const auto graph = map_pages(4);
+    const auto a = graph;
+    const auto b = graph + 0x2000;
+
+    put(a, 0x0, b);
+    put(a, 0x8, blocks.old_at(0x10));
+    put(b, 0x0, a);
+    put(b, 0x8, blocks.old_at(0x20));
+    put(b, 0x10, b);
+
+    const utility::RelocationRoot root{a, 4, 0x1000};
+    const auto stats = utility::relocate_pointers(std::span{&root, 1}, blocks.old_start(), blocks.old_end(), blocks.new_start());
+
+    CHECK(get(a, 0x8) == blocks.new_at(0x10));
+    CHECK(get(b, 0x8) == blocks.new_at(0x20));
+    CHECK(get(a, 0x0) == (uintptr_t)b);
+    CHECK(get(b, 0x0) == (uintptr_t)a);
+    CHECK(get(b, 0x10) == (uintptr_t)b);
+    CHECK(stats.pointers_relocated == 2);
+
+    munmap(graph, PAGE_SIZE * 4);
+}
+
+// A child reachable through several slots is only scanned once. The new range overlaps the old one
+// here, so scanning it twice would move its pointer twice.
+void test_shared_child() {
+    Blocks blocks{};
+    const auto graph = map_pages(4);
+    const auto parent = graph;
+    const auto child = graph + 0x2000;
+
+    put(parent, 0x0, child);
+    put(parent, 0x8, child);
+    put(parent, 0x18, child);
+    put(child, 0x0, blocks.old_at(0x10));
+
+    // The child is also a root of its own.
+    const std::vector<utility::RelocationRoot> roots{{parent, 2, 0x1000}, {child, 1, 0x1000}};
+    const auto new_start = blocks.old_start() + 0x40;
+    const auto stats = utility::relocate_pointers(roots, blocks.old_start(), blocks.old_end(), new_start);
+
+    CHECK(get(child, 0x0) == new_start + 0x10);
+    CHECK(stats.pointers_relocated == 1);
+
+    munmap(graph, PAGE_SIZE * 4);
+}
+
+void test_skip_length() {
+    Blocks blocks{};
+    const auto leaf = map_pages(1);
+
+    // Unaligned pointers are only seen with a 4 byte stride. 15 slots leave a tail after the groups of 4, the last one at 0x38.
+    put(leaf, 0x4, blocks.old_at(0x8));
+    put(leaf, 0xC, blocks.old_at(0x10));
+    put(leaf, 0x38, blocks.old_at(0x18));
+
+    utility::relocate_pointers(leaf, blocks.old_start(), blocks.old_end(), blocks.new_start(), 0, 4, 0x3C);
+    CHECK(get(leaf, 0x4) == blocks.new_at(0x8));
+    CHECK(get(leaf, 0xC) == blocks.new_at(0x10));
+    CHECK(get(leaf, 0x38) == blocks.new_at(0x18));
+
+    put(leaf, 0x4, blocks.old_at(0x8));
+    utility::relocate_pointers(leaf, blocks.old_start(), blocks.old_end(), blocks.new_start(), 0, 8, 0x3C);
+    CHECK(get(leaf, 0x4) == (uintptr_t)blocks.old_at(0x8));
+
+    // A 16 byte stride skips the slots in between.
+    std::memset(leaf, 0, 0x40);
+    put(leaf, 0x0, blocks.old_at(0x8));
+    put(leaf, 0x8, blocks.old_at(0x10));
+    put(leaf, 0x10, blocks.old_at(0x18));
+
+    utility::relocate_pointers(leaf, blocks.old_start(), blocks.old_end(), blocks.new_start(), 0, 16, 0x40);
+    CHECK(get(leaf, 0x0) == blocks.new_at(0x8));
+    CHECK(get(leaf, 0x8) == (uintptr_t)blocks.old_at(0x10));
+    CHECK(get(leaf, 0x10) == blocks.new_at(0x18));
+
+    // The same stride applies below the root, with a child only reachable through an unaligned slot.
+    const auto graph = map_pages(4);
+    const auto child = graph + 0x2000;
+
+    put(graph, 0x4, child);
+    put(child, 0xC, blocks.old_at(0x20));
+
+    utility::relocate_pointers(graph, blocks.old_start(), blocks.old_end(), blocks.new_start(), 1, 4, 0x10);
+    CHECK(get(child, 0xC) == blocks.new_at(0x20));
+
+    bool threw{false};
+
+    try {
+        utility::relocate_pointers(leaf, blocks.old_start(), blocks.old_end(), blocks.new_start(), 0, 0, 0x40);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+
+    CHECK(threw);
+
+    munmap(leaf, PAGE_SIZE);
+    munmap(graph, PAGE_SIZE * 4);
+}
+
+// Scans that run off the end of mapped memory stop there, the rest of the graph still gets relocated.
+void test_unmapped_page() {
+    Blocks blocks{};
+    const auto pages = map_pages(2);
+    munmap(pages + PAGE_SIZE, PAGE_SIZE);
+
+    const auto edge = pages + PAGE_SIZE - 0x10;
+    const auto graph = map_pages(4);
+    const auto child = graph + 0x2000;
+
+    put(edge, 0x8, blocks.old_at(0x8));
+    put(graph, 0x0, edge);
+    put(graph, 0x8, child);
+    put(child, 0x0, blocks.old_at(0x10));
+
+    utility::relocate_pointers(graph, blocks.old_start(), blocks.old_end(), blocks.new_start(), 2);
+
+    CHECK(get(edge, 0x8) == blocks.new_at(0x8));
+    CHECK(get(child, 0x0) == blocks.new_at(0x10));
+
+    munmap(pages, PAGE_SIZE);
+    munmap(graph, PAGE_SIZE * 4);
+}
+
+// Stands in for /EHa in the main build, where an access violation reaches the catch in Relocator::run.
+void throw_on_fault(int) {
+    throw std::runtime_error("access violation");
+}
+
+// The region cache still trusts a page that went away, the scan faults in the middle of it.
+// Only that frame is dropped, its parent and siblings are still scanned.
+void test_fault_recovery() {
+    Blocks blocks{};
+
+    // File backed, so the region cache treats it like a module image and keeps it around.
+    const auto file = std::tmpfile();
+    CHECK(file != nullptr && ftruncate(fileno(file), PAGE_SIZE) == 0);
+
+    const auto faulting = (uint8_t*)mmap(nullptr, PAGE_SIZE, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    CHECK(faulting != MAP_FAILED);
+    CHECK(memory_regions::is_readable(faulting, PAGE_SIZE));
+
+    mprotect(faulting, PAGE_SIZE, PROT_NONE);
+
+    const auto graph = map_pages(4);
+    const auto child = graph + 0x2000;
+
+    put(graph, 0x0, faulting);
+    put(graph, 0x8, child);
+    put(graph, 0x10, blocks.old_at(0x30));
+    put(child, 0x0, blocks.old_at(0x10));
+
+    struct sigaction action{};
+    struct sigaction old_action{};
+    action.sa_handler = throw_on_fault;
+    action.sa_flags = SA_NODEFER;
+    sigaction(SIGSEGV, &action, &old_action);
+
+    const utility::RelocationRoot root{graph, 1, 0x1000};
+    const auto generation = memory_regions::generation();
+    const auto stats = utility::relocate_pointers(std::span{&root, 1}, blocks.old_start(), blocks.old_end(), blocks.new_start());
+
+    sigaction(SIGSEGV, &old_action, nullptr);
+
+    CHECK(get(child, 0x0) == blocks.new_at(0x10));
+    CHECK(get(graph, 0x10) == blocks.new_at(0x30));
+    CHECK(stats.pointers_relocated == 2);
+
+    // The cache was told it was wrong about the page.
+    CHECK(memory_regions::generation() != generation);
+    CHECK(!memory_regions::is_readable(faulting, 1));
+
+    munmap(faulting, PAGE_SIZE);
+    munmap(graph, PAGE_SIZE * 4);
+    std::fclose(file);
+}
+
+// Many disjoint graphs relocated serially and across threads end up the same.
+void test_parallel() {
+    constexpr size_t NUM_ROOTS = 64;
+    constexpr size_t CHUNK = 0x4000;
+
+    Blocks blocks{};
+    const auto num_pages = NUM_ROOTS * CHUNK / PAGE_SIZE;
+    const auto arena = map_pages(num_pages);
+
+    std::vector<utility::RelocationRoot> roots{};
+
+    for (size_t i = 0; i < NUM_ROOTS; ++i) {
+        // Each node is past the 0x1000 bytes scanned from the one before it.
+        const auto root = arena + i * CHUNK;
+        const auto child = root + 0x1800;
+        const auto grandchild = root + 0x2C00;
+
+        put(root, 0x0, child);
+        put(root, 0x8, blocks.old_at((i * 8) % Blocks::OLD_SIZE));
+        put(child, 0x0, grandchild);
+        put(child, 0x10, root);
+        put(child, 0x18, blocks.old_at((i * 16 + 8) % Blocks::OLD_SIZE));
+        put(grandchild, 0x0, blocks.old_at((i * 24) % Blocks::OLD_SIZE));
+        put(grandchild, 0x8, child);
+
+        roots.push_back(utility::RelocationRoot{root, 3, 0x1000});
+    }
+
+    const std::vector<uint8_t> original(arena, arena + num_pages * PAGE_SIZE);
+
+    const auto serial = utility::relocate_pointers(roots, blocks.old_start(), blocks.old_end(), blocks.new_start(), sizeof(void*), false);
+    const std::vector<uint8_t> serial_result(arena, arena + num_pages * PAGE_SIZE);
+
+    std::memcpy(arena, original.data(), original.size());
+
+    const auto parallel = utility::relocate_pointers(roots, blocks.old_start(), blocks.old_end(), blocks.new_start(), sizeof(void*), true);
+
+    CHECK(serial.pointers_relocated == NUM_ROOTS * 3);
+    CHECK(parallel.pointers_relocated == serial.pointers_relocated);
+    CHECK(std::memcmp(arena, serial_result.data(), serial_result.size()) == 0);
+    CHECK(get(arena + 0x2C00, 0x0) == blocks.new_at(0));
+
+    munmap(arena, num_pages * PAGE_SIZE);
+}
+}
+
+int main() {
+    test_cycle();
+    test_shared_child();
+    test_skip_length();
+    test_unmapped_page();
+    test_fault_recovery();
+    test_parallel();
+
+    return test::result();
+}
@@ -0,0 +1,109 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <utility/SnapshotBuffer.hpp>
+
+namespace {
+// Big enough that copying it takes a while, every field holds the same value.
+struct Snapshot {
+    std::array<uint64_t, 128> values{};
+};
+
+void test_single_thread() {
+    utility::SnapshotBuffer<Snapshot, 2> buffer{};
+
+    CHECK(buffer.num_published() == 0);
+    CHECK(buffer.get().values[0] == 0);
+
+    for (uint64_t i = 1; i <= 10; ++i) {
+        Snapshot snapshot{};
+        snapshot.values.fill(i);
+        buffer.publish(snapshot);
+
+        CHECK(buffer.get().values[127] == i);
+        CHECK(buffer.read([](const Snapshot& s) { return s.values[0]; }) == i);
+    }
+
+    CHECK(buffer.num_published() == 10);
+}
+
+// One writer hammering a 2 slot ring so readers constantly race it. A torn read
+// would show up as a snapshot mixing values from two publishes.
+void test_torn_reads() {
+    utility::SnapshotBuffer<Snapshot, 2> buffer{};
+
+    constexpr size_t NUM_READERS = 4;
+    const auto duration = std::chrono::milliseconds{500};
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> torn{0};
+    std::atomic<size_t> went_backwards{0};
+    std::atomic<size_t> reads{0};
+
+    std::vector<std::thread> readers{};
+
+    for (size_t r = 0; r < NUM_READERS; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t last{0};
+            size_t local_reads{0};
+
+            while (!done.load(std::memory_order_relaxed)) {
+                const auto snapshot = buffer.get();
+                const auto first = snapshot.values[0];
+
+                for (const auto value : snapshot.values) {
+                    if (value != first) {
+                        ++torn;
+                        break;
+                    }
+                }
+
+                if (first < last) {
+                    ++went_backwards;
+                }
+
+                last = first;
+                ++local_reads;
+            }
+
+            reads += local_reads;
+        });
+    }
+
+    uint64_t published{0};
+    const auto end = std::chrono::steady_clock::now() + duration;
+
+    while (std::chrono::steady_clock::now() < end) {
+        Snapshot snapshot{};
+        snapshot.values.fill(++published);
+        buffer.publish(snapshot);
+    }
+
+    done = true;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::printf("%llu publishes, %zu reads\n", (unsigned long long)published, reads.load());
+
+    CHECK(torn == 0);
+    CHECK(went_backwards == 0);
+    CHECK(reads > 0);
+    CHECK(buffer.num_published() == published);
+    CHECK(buffer.get().values[0] == published);
+}
+}
+
+int main() {
+    test_single_thread();
+    test_torn_reads();
+
+    return test::result();
+}
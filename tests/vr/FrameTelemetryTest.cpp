@@ -0,0 +1,217 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <Test.hpp>
+
+#include <FrameTelemetry.hpp>
+
+namespace {
+using vrmod::FrameTelemetry;
+using Stage = FrameTelemetry::Stage;
+
+constexpr float EPSILON = 1e-3f;
+
+FrameTelemetry::Clock::time_point at(double ms) {
+    return FrameTelemetry::Clock::time_point{} + std::chrono::duration_cast<FrameTelemetry::Clock::duration>(
+        std::chrono::duration<double, std::milli>{1000.0 + ms});
+}
+
+// One frame the way the runtimes drive it: wait 2ms, poses 1ms, render until 9ms, submit 1ms.
+void run_frame(FrameTelemetry& telemetry, double start) {
+    telemetry.begin(Stage::WAIT, at(start));
+    telemetry.end(Stage::WAIT, at(start + 2.0));
+    telemetry.begin(Stage::POSES, at(start + 2.0));
+    telemetry.end(Stage::POSES, at(start + 3.0));
+    telemetry.begin(Stage::SUBMIT, at(start + 9.0));
+    telemetry.end(Stage::SUBMIT, at(start + 10.0));
+    telemetry.end_frame(at(start + 10.0));
+}
+
+void test_stages() {
+    FrameTelemetry telemetry{};
+
+    // Nothing before the first wait is recorded.
+    telemetry.begin(Stage::POSES, at(-5.0));
+    telemetry.end(Stage::POSES, at(-4.0));
+    telemetry.end_frame(at(-4.0));
+    CHECK(telemetry.get_frames().empty());
+
+    run_frame(telemetry, 0.0);
+    run_frame(telemetry, 11.0);
+
+    const auto frames = telemetry.get_frames();
+    CHECK(frames.size() == 2);
+
+    if (frames.size() != 2) {
+        return;
+    }
+
+    const auto& frame = frames[1];
+    CHECK(frame.index == 1);
+    CHECK(frame.submitted && !frame.missed);
+    CHECK_NEAR(frame.interval_ms, 11.0f, EPSILON);
+    CHECK_NEAR(frame.stage_ms[(size_t)Stage::WAIT], 2.0f, EPSILON);
+    CHECK_NEAR(frame.stage_ms[(size_t)Stage::SYNC], 0.0f, EPSILON);
+    CHECK_NEAR(frame.stage_ms[(size_t)Stage::POSES], 1.0f, EPSILON);
+    CHECK_NEAR(frame.stage_ms[(size_t)Stage::RENDER], 6.0f, EPSILON);
+    CHECK_NEAR(frame.stage_ms[(size_t)Stage::SUBMIT], 1.0f, EPSILON);
+    CHECK_NEAR(frame.pose_to_submit_ms, 7.0f, EPSILON);
+
+    // The first frame has nothing to measure its interval against.
+    CHECK(frames[0].interval_ms == 0.0f);
+}
+
+// One submit per eye, the submit stage adds up and render stops at the first one.
+void test_repeated_stage() {
+    FrameTelemetry telemetry{};
+
+    telemetry.begin(Stage::WAIT, at(0.0));
+    telemetry.end(Stage::WAIT, at(1.0));
+    telemetry.begin(Stage::POSES, at(1.0));
+    telemetry.end(Stage::POSES, at(2.0));
+    telemetry.begin(Stage::SUBMIT, at(5.0));
+    telemetry.end(Stage::SUBMIT, at(6.0));
+    telemetry.begin(Stage::SUBMIT, at(7.0));
+    telemetry.end(Stage::SUBMIT, at(8.5));
+    telemetry.end_frame(at(8.5));
+
+    const auto frames = telemetry.get_frames();
+    CHECK(frames.size() == 1);
+    CHECK_NEAR(frames[0].stage_ms[(size_t)Stage::SUBMIT], 2.5f, EPSILON);
+    CHECK_NEAR(frames[0].stage_ms[(size_t)Stage::RENDER], 3.0f, EPSILON);
+    CHECK_NEAR(frames[0].pose_to_submit_ms, 6.5f, EPSILON);
+}
+
+void test_missed_frames() {
+    FrameTelemetry telemetry{};
+
+    for (size_t i = 0; i < 20; ++i) {
+        run_frame(telemetry, i * 11.0);
+    }
+
+    // Waiting again without a submit drops the frame.
+    telemetry.begin(Stage::WAIT, at(220.0));
+    telemetry.end(Stage::WAIT, at(222.0));
+    run_frame(telemetry, 231.0);
+
+    // Over 1.5x the median interval.
+    run_frame(telemetry, 260.0);
+
+    // Back on time.
+    run_frame(telemetry, 271.0);
+
+    const auto frames = telemetry.get_frames();
+    CHECK(frames.size() == 24);
+
+    if (frames.size() != 24) {
+        return;
+    }
+
+    for (size_t i = 0; i < 20; ++i) {
+        CHECK(!frames[i].missed);
+    }
+
+    CHECK(!frames[20].submitted && frames[20].missed);
+    CHECK(frames[21].submitted);
+    CHECK(frames[22].submitted && frames[22].missed);
+    CHECK(!frames[23].missed);
+
+    const auto summary = telemetry.get_summary();
+    CHECK(summary.frames == 24);
+    CHECK(summary.missed == 2);
+}
+
+void test_disabled() {
+    FrameTelemetry telemetry{};
+    telemetry.enabled = false;
+
+    run_frame(telemetry, 0.0);
+    CHECK(telemetry.get_frames().empty());
+
+    telemetry.enabled = true;
+    run_frame(telemetry, 11.0);
+    CHECK(telemetry.get_frames().size() == 1);
+
+    telemetry.clear();
+    CHECK(telemetry.get_frames().empty());
+}
+
+void test_ring_buffer() {
+    FrameTelemetry telemetry{};
+    constexpr size_t EXTRA = 10;
+
+    for (size_t i = 0; i < FrameTelemetry::CAPACITY + EXTRA; ++i) {
+        run_frame(telemetry, i * 11.0);
+    }
+
+    const auto frames = telemetry.get_frames();
+    CHECK(frames.size() == FrameTelemetry::CAPACITY);
+
+    // Oldest first, the first EXTRA frames were overwritten.
+    for (size_t i = 0; i < frames.size(); ++i) {
+        CHECK(frames[i].index == i + EXTRA);
+    }
+}
+
+void test_percentiles() {
+    FrameTelemetry telemetry{};
+    double t = 0.0;
+
+    // Intervals of 1, 2, ... 100ms.
+    run_frame(telemetry, t);
+
+    for (size_t i = 1; i <= 100; ++i) {
+        t += (double)i + 10.0;
+        run_frame(telemetry, t);
+    }
+
+    const auto summary = telemetry.get_summary();
+    CHECK_NEAR(summary.interval.p50, 60.0f, EPSILON);
+    CHECK_NEAR(summary.interval.p90, 100.0f, EPSILON);
+    CHECK_NEAR(summary.interval.p99, 109.0f, EPSILON);
+    CHECK_NEAR(summary.interval.max, 110.0f, EPSILON);
+    CHECK_NEAR(summary.stages[(size_t)Stage::WAIT].p99, 2.0f, EPSILON);
+    CHECK_NEAR(summary.pose_to_submit.max, 7.0f, EPSILON);
+}
+
+void test_export_csv() {
+    FrameTelemetry telemetry{};
+
+    for (size_t i = 0; i < 5; ++i) {
+        run_frame(telemetry, i * 11.0);
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "frame_telemetry_test.csv";
+    CHECK(telemetry.export_csv(path));
+
+    std::ifstream f{path};
+    std::string line{};
+    size_t num_lines{0};
+
+    std::getline(f, line);
+    CHECK(line == "frame,start_ms,interval_ms,Wait_ms,Sync_ms,Poses_ms,Render_ms,Submit_ms,pose_to_submit_ms,submitted,missed");
+
+    while (std::getline(f, line)) {
+        ++num_lines;
+    }
+
+    CHECK(num_lines == 5);
+
+    f.close();
+    std::filesystem::remove(path);
+}
+}
+
+int main() {
+    test_stages();
+    test_repeated_stage();
+    test_missed_frames();
+    test_disabled();
+    test_ring_buffer();
+    test_percentiles();
+    test_export_csv();
+
+    return test::result();
+}
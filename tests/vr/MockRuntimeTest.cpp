@@ -0,0 +1,258 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <Test.hpp>
+
+#include <runtimes/MockRuntime.hpp>
+
+namespace {
+using runtimes::MockRuntime;
+using vrmod::SessionRecording;
+
+constexpr size_t NUM_FRAMES = 10;
+constexpr uint64_t FRAME_NS = 11'111'111; // 90hz
+constexpr size_t DROPPED_FRAME = 4;
+constexpr size_t LATE_FRAME = 7;
+
+// Every pose and matrix holds the frame index in its translation so the replay order can be read back.
+// Trigger is held on the left hand from frame 3 to 5.
+SessionRecording make_recording() {
+    SessionRecording recording{};
+    recording.width = 2016;
+    recording.height = 2240;
+    recording.controllers = {3, 4};
+    recording.actions = {"/actions/default/in/Grip", "/actions/default/in/Trigger"};
+
+    for (size_t i = 0; i < NUM_FRAMES; ++i) {
+        auto& frame = recording.frames.emplace_back();
+        frame.time_ns = i * FRAME_NS;
+
+        for (const uint32_t index : {0u, 3u, 4u}) {
+            SessionRecording::Device device{};
+            device.index = index;
+            device.pose.transform = Matrix4x4f{1.0f};
+            device.pose.transform[3] = Vector4f{(float)i, (float)index, 0.0f, 1.0f};
+            device.pose.valid = true;
+            frame.devices.push_back(device);
+        }
+
+        frame.eyes[0][3] = Vector4f{(float)i, 0.0f, 0.0f, 1.0f};
+        frame.sticks[VRRuntime::Hand::RIGHT] = Vector2f{0.0f, (float)i / NUM_FRAMES};
+
+        if (i >= 3 && i <= 5) {
+            frame.actions[VRRuntime::Hand::LEFT] |= 1ull << 1;
+        }
+    }
+
+    recording.frames[DROPPED_FRAME].flags |= SessionRecording::DROPPED;
+    recording.frames[LATE_FRAME].flags |= SessionRecording::LATE_POSES;
+
+    return recording;
+}
+
+struct PlayedFrame {
+    float hmd_x{};
+    float left_x{};
+    float eye_x{};
+    float right_stick_y{};
+    bool trigger{};
+    bool trigger_pressed{};
+    bool trigger_released{};
+};
+
+// Drives the mock the way VR does every frame, without a game or a graphics API.
+std::vector<PlayedFrame> replay(MockRuntime& mock, size_t max_frames) {
+    std::vector<PlayedFrame> played{};
+    const auto trigger = mock.recording.find_action("/actions/default/in/Trigger");
+
+    while (played.size() < max_frames && mock.synchronize_frame() == VRRuntime::Error::SUCCESS) {
+        mock.update_poses();
+        mock.update_matrices(0.1f, 3000.0f);
+
+        const auto snapshot = mock.get_pose_snapshot();
+        const auto left = mock.recording.controllers[VRRuntime::Hand::LEFT];
+
+        played.push_back(PlayedFrame{
+            snapshot.devices[0].transform[3].x,
+            snapshot.devices[left].transform[3].x,
+            snapshot.eyes[0][3].x,
+            mock.get_stick_axis(VRRuntime::Hand::RIGHT).y,
+            mock.is_action_active(trigger, VRRuntime::Hand::LEFT),
+            mock.is_action_pressed(trigger, VRRuntime::Hand::LEFT),
+            mock.is_action_released(trigger, VRRuntime::Hand::LEFT),
+        });
+
+        CHECK(snapshot.num_devices == 5);
+        CHECK(snapshot.devices[0].valid && !snapshot.devices[1].valid && snapshot.devices[3].valid);
+        CHECK(mock.submit() == VRRuntime::Error::SUCCESS);
+    }
+
+    return played;
+}
+
+// A recording saved to disk and replayed once from start to end.
+void test_replay_file() {
+    const auto path = std::filesystem::temp_directory_path() / "mock_runtime_test.rfvr";
+    CHECK(!make_recording().save(path).has_value());
+
+    MockRuntime mock{};
+    mock.simulation.loop = false;
+
+    CHECK(!mock.load(path).has_value());
+    CHECK(mock.loaded && !mock.error.has_value());
+    CHECK(mock.get_width() == 2016 && mock.get_height() == 2240);
+    CHECK(mock.recording.controllers[VRRuntime::Hand::LEFT] == 3 && mock.recording.controllers[VRRuntime::Hand::RIGHT] == 4);
+    CHECK(mock.is_mock());
+
+    std::filesystem::remove(path);
+
+    const auto played = replay(mock, NUM_FRAMES * 2);
+
+    // The dropped frame is skipped, the late one gets the poses of the frame before it.
+    const std::vector<float> expected_x{0, 1, 2, 3, 5, 6, 6, 8, 9};
+    CHECK(played.size() == expected_x.size());
+    CHECK(mock.finished());
+    CHECK(mock.synchronize_frame() != VRRuntime::Error::SUCCESS);
+    CHECK(mock.frames_played == expected_x.size());
+    CHECK(mock.frames_dropped == 1);
+    CHECK(mock.late_poses == 1);
+
+    if (played.size() != expected_x.size()) {
+        return;
+    }
+
+    for (size_t i = 0; i < played.size(); ++i) {
+        CHECK(played[i].hmd_x == expected_x[i]);
+        CHECK(played[i].left_x == expected_x[i]);
+        CHECK(played[i].eye_x == expected_x[i]);
+    }
+
+    // Input always comes from the frame being played, even when its poses are late.
+    CHECK_NEAR(played[6].right_stick_y, 0.7f, 1e-6f);
+
+    // Trigger held on frames 3 and 5 with 4 dropped in between.
+    for (size_t i = 0; i < played.size(); ++i) {
+        CHECK(played[i].trigger == (i == 3 || i == 4));
+        CHECK(played[i].trigger_pressed == (i == 3));
+        CHECK(played[i].trigger_released == (i == 5));
+    }
+
+    // Unrecorded actions and bad hands are never active.
+    CHECK(!mock.is_action_active(-1, VRRuntime::Hand::LEFT));
+    CHECK(!mock.is_action_active(63, VRRuntime::Hand::LEFT));
+    CHECK(!mock.is_action_active(1, (VRRuntime::Hand)2));
+
+    // The replay feeds the telemetry like a real runtime, the dropped frame shows up as never submitted.
+    const auto frames = mock.telemetry.get_frames();
+    size_t submitted{0};
+
+    for (const auto& frame : frames) {
+        submitted += frame.submitted;
+    }
+
+    CHECK(frames.size() == NUM_FRAMES);
+    CHECK(submitted == expected_x.size());
+    CHECK(mock.telemetry.get_summary().missed >= 1);
+}
+
+void test_loop_and_simulated_drops() {
+    MockRuntime::Simulation simulation{};
+    simulation.loop = true;
+    simulation.drop_every = 3;
+
+    MockRuntime mock{make_recording(), simulation};
+
+    const auto played = replay(mock, 25);
+
+    CHECK(played.size() == 25);
+    CHECK(!mock.finished());
+    CHECK(mock.frames_dropped > 0);
+
+    // Every third frame and the recorded drop are skipped, on every pass through the recording.
+    for (const auto& frame : played) {
+        const auto index = (size_t)frame.eye_x;
+        CHECK((index + 1) % 3 != 0);
+        CHECK(index != DROPPED_FRAME);
+    }
+}
+
+void test_everything_dropped() {
+    auto recording = make_recording();
+
+    for (auto& frame : recording.frames) {
+        frame.flags |= SessionRecording::DROPPED;
+    }
+
+    MockRuntime mock{std::move(recording), MockRuntime::Simulation{}};
+
+    // Looping over nothing but dropped frames has to give up instead of spinning forever.
+    mock.synchronize_frame();
+    CHECK(mock.frames_dropped == NUM_FRAMES);
+}
+
+void test_bad_files() {
+    const auto path = std::filesystem::temp_directory_path() / "mock_runtime_test_bad.rfvr";
+
+    {
+        std::ofstream f{path, std::ios::binary};
+        f << "not a recording";
+    }
+
+    MockRuntime mock{};
+    CHECK(mock.load(path).has_value());
+    CHECK(!mock.loaded && mock.error.has_value());
+    CHECK(mock.synchronize_frame() != VRRuntime::Error::SUCCESS);
+
+    // Truncated in the middle of a frame.
+    CHECK(!make_recording().save(path).has_value());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 100);
+    CHECK(mock.load(path).has_value());
+
+    std::filesystem::remove(path);
+
+    CHECK(mock.load(path).has_value());
+    CHECK(!mock.is_action_active(0, VRRuntime::Hand::LEFT));
+}
+
+// Flags are set on the last captured frame once its fate is known.
+void test_recorder_flags() {
+    vrmod::SessionRecorder recorder{};
+    VRRuntime::PoseSnapshot snapshot{};
+    snapshot.num_devices = 1;
+    snapshot.devices[0].valid = true;
+
+    recorder.flag_last_frame(SessionRecording::DROPPED); // nothing captured yet
+    recorder.start(100, 100, {5, 6}, {"/actions/default/in/Trigger"});
+    recorder.flag_last_frame(SessionRecording::DROPPED);
+
+    for (size_t i = 0; i < 3; ++i) {
+        recorder.capture(snapshot, {}, {});
+    }
+
+    recorder.flag_last_frame(SessionRecording::LATE_POSES);
+    recorder.capture(snapshot, {}, {});
+
+    const auto recording = recorder.stop();
+    CHECK(recording.frames.size() == 4);
+    CHECK(recording.controllers[VRRuntime::Hand::LEFT] == 5 && recording.controllers[VRRuntime::Hand::RIGHT] == 6);
+
+    if (recording.frames.size() == 4) {
+        CHECK(recording.frames[0].flags == 0);
+        CHECK(recording.frames[2].flags == SessionRecording::LATE_POSES);
+        CHECK(recording.frames[3].flags == 0);
+        CHECK(recording.frames[0].devices.size() == 1);
+    }
+}
+}
+
+int main() {
+    test_replay_file();
+    test_loop_and_simulated_drops();
+    test_everything_dropped();
+    test_bad_files();
+    test_recorder_flags();
+
+    return test::result();
+}